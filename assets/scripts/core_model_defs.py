@@ -25,6 +25,7 @@ class UnitType(IntEnum):
 class LineOfSightShape(str, Enum):
     CIRCLE = "circle"
     ROUNDED_SQUARE = "rounded_square"
+    OCCLUDED_CIRCLE = "occluded_circle"
     
 
 class Selectable:
@@ -2,6 +2,7 @@
 
 #include "EntityFactory.h"
 #include "EntityTypeRegistry.h"
+#include "PlayerFactory.h"
 #include "ServiceRegistry.h"
 #include "StateManager.h"
 #include "commands/CmdBuild.h"
@@ -17,6 +18,9 @@
 #include "components/CompUnitFactory.h"
 #include "utils/ObjectPool.h"
 
+#include <algorithm>
+#include <cmath>
+
 using namespace core;
 
 BuildingManager::BuildingManager()
@@ -28,27 +32,37 @@ BuildingManager::BuildingManager()
     registerCallback(Event::Type::ENTITY_DELETE, this, &BuildingManager::onEntityDeletion);
 }
 
+void BuildingManager::onInit(EventLoop& eventLoop)
+{
+    m_productionChannel =
+        m_timers->registerChannel([this](std::span<const uint32_t> buildings, int tick)
+                                  { onProductionTimers(buildings, tick); });
+    m_damageChannel =
+        m_timers->registerChannel([this](std::span<const uint32_t> buildings, int tick)
+                                  { onDamageTimers(buildings, tick); });
+}
+
 bool BuildingManager::onTick(const Event& e)
 {
+    // Production and burning buildings are driven by TimerService
     handleBuildingUpdates(e.getData<TickData>());
-    handleBuildingDamages(e.getData<TickData>());
-    updateInProgressUnitCreations(e.getData<TickData>());
     return false;
 }
 
 void BuildingManager::onCompleteBuilding(uint32_t entity,
                                          const CompBuilding& building,
-                                         const CompVision& vision,
+                                         CompVision& vision,
                                          const CompTransform& transform,
                                          const CompPlayer& player,
                                          const CompEntityInfo& info)
 {
-    player.player->getFogOfWar()->markAsExplored(building.landArea, vision.lineOfSight);
+    player.player->getVision()->addSight(building.landArea, vision.lineOfSight);
+    vision.hasVision = true;
     player.player->ownEntity(entity);
 
     BuildingConstructedData constructedData;
     constructedData.entity = entity;
-    constructedData.player = player.player;
+    constructedData.playerId = player.player->getId();
     constructedData.entityType = info.entityType;
     constructedData.pos = transform.position;
     publishEvent(Event::Type::BUILDING_CONSTRUCTED, constructedData);
@@ -93,7 +107,7 @@ std::tuple<CompEntityInfo&, CompBuilding&> BuildingManager::createBuilding(
 
     // Don't trust the arbitrary feet position, snap it.
     transform.position = building.getSnappedBuildingCenter(request.pos); // Snap
-    playerComp.player = request.player;
+    playerComp.player = m_playerFactory->getPlayer(request.playerId);
 
     building.orientation = request.orientation;
     building.updateLandArea(transform.position);
@@ -109,12 +123,12 @@ bool BuildingManager::onQueueUnit(const Event& e)
     auto& data = e.getData<UnitQueueData>();
     spdlog::debug("On queuing unit {} for building {}", data.entityType, data.building);
 
-    auto [building, factory] =
-        m_stateMan->getComponents<CompBuilding, CompUnitFactory>(data.building);
+    auto& factory = m_stateMan->getComponent<CompUnitFactory>(data.building);
     factory.productionQueue.push_back(data.entityType);
 
-    ActiveFactoryInfo info{.factory = factory, .building = data.building, .player = data.player};
-    m_activeFactories.emplace(data.building, info);
+    // Otherwise the factory is already working on (or waiting for) the front of the queue
+    if (factory.productionQueue.size() == 1)
+        advanceProduction(data.building, factory, m_timers->getCurrentTick());
     return false;
 }
 
@@ -157,79 +171,95 @@ Feet BuildingManager::findVacantPositionAroundBuilding(uint32_t building)
     return pos.centerInFeet();
 }
 
-void BuildingManager::updateInProgressUnitCreations(const TickData& tick)
+void BuildingManager::onProductionTimers(std::span<const uint32_t> buildings, int currentTick)
 {
-    for (auto it = m_activeFactories.begin(); it != m_activeFactories.end();)
+    for (auto building : buildings)
     {
-        /*
-         *   Approach: Checking for sufficient housing capacity is done at
-         *   the very beginning before start creating the unit and just after creating
-         *   the unit but before placing it on the map.
-         *   Factory will no longer be tracked if the queue is completed/empty.
-         */
-        auto& activeFactoryInfo = it->second;
-        CompUnitFactory& factory = activeFactoryInfo.factory.get();
-        factory.pausedDueToInsufficientHousing = false;
-        factory.pausedDueToPopulationLimit = false;
-        auto unitType = factory.productionQueue.at(0);
-
-        if (factory.currentUnitProgress == 0)
+        if (not m_stateMan->getRegistry().valid(building))
+            continue;
+
+        if (auto factory = m_stateMan->tryGetComponent<CompUnitFactory>(building))
         {
-            auto newPopulation = activeFactoryInfo.player->getPopulation() +
-                                 m_typeRegistry->getUnitTypeHousingNeed(unitType);
-            if (newPopulation > m_settings->getMaxPopulation())
-            {
-                factory.pausedDueToPopulationLimit = true;
-                ++it;
-                continue;
-            }
-            if (activeFactoryInfo.player->getVacantHousingCapacity() <
-                m_typeRegistry->getUnitTypeHousingNeed(unitType))
-            {
-                factory.pausedDueToInsufficientHousing = true;
-                ++it;
-                continue;
-            }
+            factory->productionTimer = TimerId();
+            advanceProduction(building, *factory, currentTick);
         }
+    }
+}
 
-        factory.currentUnitProgress +=
-            float(factory.unitCreationSpeed) * tick.deltaTimeMs / 1000.0f;
+/*
+ *   Starts the unit at the front of the queue, or finishes it if it is due. Housing
+ *   capacity is checked before starting the unit and again before placing it on the
+ *   map. A paused factory retries periodically. The factory isn't visited otherwise
+ *   until the unit is due.
+ */
+void BuildingManager::advanceProduction(uint32_t building,
+                                        CompUnitFactory& factory,
+                                        int currentTick)
+{
+    factory.pausedDueToInsufficientHousing = false;
+    factory.pausedDueToPopulationLimit = false;
 
-        if (factory.currentUnitProgress > 100)
-        {
-            factory.currentUnitProgress = 100; //  Cap at 100 to avoid unnecessary behaviors
-
-            auto newPopulation = activeFactoryInfo.player->getPopulation() +
-                                 m_typeRegistry->getUnitTypeHousingNeed(unitType);
-            if (newPopulation > m_settings->getMaxPopulation())
-            {
-                factory.pausedDueToPopulationLimit = true;
-                ++it;
-                continue;
-            }
-
-            if (activeFactoryInfo.player->getVacantHousingCapacity() <
-                m_typeRegistry->getUnitTypeHousingNeed(unitType))
-            {
-                factory.pausedDueToInsufficientHousing = true;
-                ++it;
-                continue;
-            }
-            UnitCreationData data;
-            data.entityType = unitType;
-            data.player = activeFactoryInfo.player;
-            data.position = findVacantPositionAroundBuilding(activeFactoryInfo.building);
-            publishEvent(Event::Type::UNIT_CREATION_FINISHED, data);
-
-            factory.currentUnitProgress = 0;
-            factory.productionQueue.erase(factory.productionQueue.begin());
-        }
+    if (factory.productionQueue.empty())
+        return;
+
+    const auto& player = m_stateMan->getComponent<CompPlayer>(building).player;
+    const auto unitType = factory.productionQueue.front();
+
+    if (not hasRoomForUnit(*player, unitType, factory))
+    {
+        factory.productionTimer = m_timers->scheduleAfter(m_productionChannel, building,
+                                                          toTicks(RECHECK_INTERVAL_MS));
+        return;
+    }
+
+    if (factory.productionEndTick == 0)
+    {
+        // Creation speed is in percentage per second
+        const auto speed = std::max(factory.unitCreationSpeed.value(), 1u);
+        const auto ticks = int(std::ceil(100.0 * m_settings->getTicksPerSecond() / speed));
+
+        factory.productionStartTick = currentTick;
+        factory.productionEndTick = currentTick + std::max(ticks, 1);
+        factory.productionTimer =
+            m_timers->schedule(m_productionChannel, building, factory.productionEndTick);
+        return;
+    }
+
+    UnitCreationData data;
+    data.entityType = unitType;
+    data.playerId = player->getId();
+    data.position = findVacantPositionAroundBuilding(building);
+    publishEvent(Event::Type::UNIT_CREATION_FINISHED, data);
+
+    factory.productionStartTick = 0;
+    factory.productionEndTick = 0;
+    factory.productionQueue.erase(factory.productionQueue.begin());
+
+    advanceProduction(building, factory, currentTick); // The next one in the queue
+}
+
+bool BuildingManager::hasRoomForUnit(const Player& player,
+                                     uint32_t unitType,
+                                     CompUnitFactory& factory) const
+{
+    const auto housingNeed = m_typeRegistry->getUnitTypeHousingNeed(unitType);
 
-        if (factory.productionQueue.empty())
-            it = m_activeFactories.erase(it);
-        else
-            ++it;
+    if (player.getPopulation() + housingNeed > m_settings->getMaxPopulation())
+    {
+        factory.pausedDueToPopulationLimit = true;
+        return false;
+    }
+    if (player.getVacantHousingCapacity() < housingNeed)
+    {
+        factory.pausedDueToInsufficientHousing = true;
+        return false;
     }
+    return true;
+}
+
+int BuildingManager::toTicks(int durationMs) const
+{
+    return std::max(1, durationMs * m_settings->getTicksPerSecond() / 1000);
 }
 
 bool BuildingManager::onUngarrison(const Event& e)
@@ -335,9 +365,9 @@ void BuildingManager::handleConstructionProgress(const TickData& tick,
     }
 }
 
-// We track damaged buildings in a separate set to avoid doing heavy health checks for all buildings
-// every tick. This is because we want to animate fire for damaged buildings even without the
-// building is marked as dirty.
+// We track damaged buildings separately to avoid doing heavy health checks for all buildings
+// every tick. A damaged building is revisited on a timer to update its fire even without the
+// building being marked as dirty.
 //
 void BuildingManager::detectDamagedBuildings(const TickData& tick,
                                              CompBuilding& building,
@@ -348,29 +378,43 @@ void BuildingManager::detectDamagedBuildings(const TickData& tick,
             ->getComponents<CompTransform, CompEntityInfo, CompPlayer, CompVision, CompHealth>(
                 entity);
 
-    if (health.health < health.maxHealth.value())
+    if (health.health < health.maxHealth.value() and not m_damagedBuildings.contains(entity))
     {
-        m_damagedBuildings.insert(entity);
+        m_damagedBuildings.emplace(entity, m_timers->scheduleAfter(m_damageChannel, entity, 1));
     }
 }
 
-void BuildingManager::handleBuildingDamages(const TickData& tick)
+void BuildingManager::onDamageTimers(std::span<const uint32_t> buildings, int currentTick)
 {
-    for (auto entity : m_damagedBuildings)
+    for (auto entity : buildings)
     {
+        if (not m_damagedBuildings.contains(entity))
+            continue;
+
+        int nextCheck = 0;
         if (auto building = m_stateMan->tryGetComponent<CompBuilding>(entity))
         {
-            handleBuildingDamage(tick, *building, entity);
+            nextCheck = handleBuildingDamage(*building, entity, currentTick);
+        }
+
+        // Looked up again, the handling might have deleted the building
+        auto it = m_damagedBuildings.find(entity);
+        if (it != m_damagedBuildings.end())
+        {
+            it->second = nextCheck > 0
+                             ? m_timers->scheduleAfter(m_damageChannel, entity, nextCheck)
+                             : TimerId();
         }
     }
 }
 
-void BuildingManager::handleBuildingDamage(const TickData& tick,
-                                           CompBuilding& building,
-                                           uint32_t entity)
+// Returns the ticks until the building should be handled again, 0 if not anymore
+int BuildingManager::handleBuildingDamage(CompBuilding& building,
+                                          uint32_t entity,
+                                          int currentTick)
 {
     if (building.isConstructing())
-        return;
+        return toTicks(RECHECK_INTERVAL_MS);
 
     auto [healthComp, info, transform] =
         m_stateMan->getComponents<CompHealth, CompEntityInfo, CompTransform>(entity);
@@ -387,8 +431,8 @@ void BuildingManager::handleBuildingDamage(const TickData& tick,
             healthComp.isDead = true;
             Event event(Event::Type::ENTITY_DELETE, EntityDeleteData{entity});
             publishEvent(event);
-            return;
         }
+        return 0;
     }
     else if (healthPerc < 25)
     {
@@ -404,7 +448,7 @@ void BuildingManager::handleBuildingDamage(const TickData& tick,
     }
     else
     {
-        return; // No fire if health is above 75%
+        return toTicks(RECHECK_INTERVAL_MS); // No fire if health is above 75%
     }
 
     // TODO: So far we only have fire as child entities, hence this works.
@@ -432,32 +476,48 @@ void BuildingManager::handleBuildingDamage(const TickData& tick,
     {
         auto [fireAnimComp, fireInfo] =
             m_stateMan->getComponents<CompAnimation, CompEntityInfo>(fireEntity);
-        fireInfo.state = flameLevel;
         const auto& fireAnim = fireAnimComp.animations[0];
+        fireAnimComp.layer = fireAnim.layer;
 
-        auto ticksPerFrame = m_settings->getTicksPerSecond() / fireAnim.speed;
-        if (tick.currentTick % (int) ticksPerFrame == 0)
-        {
-            fireAnimComp.frame++;
-            fireAnimComp.frame %= fireAnim.frames;
-            fireAnimComp.layer = fireAnim.layer;
+        // Renderer loops the fire, only the flame level changes are sent
+        auto ticksPerFrame = int(m_settings->getTicksPerSecond() / fireAnim.speed);
+        bool changed = fireAnimComp.loop(0, currentTick, ticksPerFrame);
+        changed = changed or fireInfo.state != flameLevel;
+        fireInfo.state = flameLevel;
 
+        if (changed)
             StateManager::markDirty(fireEntity);
-        }
     }
+    return toTicks(RECHECK_INTERVAL_MS);
 }
 
 void BuildingManager::deleteBuilding(uint32_t entity)
 {
-    auto [info, transform, building, playerComp] =
-        m_stateMan->getComponents<CompEntityInfo, CompTransform, CompBuilding, CompPlayer>(entity);
+    auto [info, transform, building, playerComp, vision] =
+        m_stateMan
+            ->getComponents<CompEntityInfo, CompTransform, CompBuilding, CompPlayer, CompVision>(
+                entity);
     info.isDestroyed = true;
     StateManager::markDirty(entity);
 
     m_stateMan->gameMap().removeEntity(building.getMapLayerType(), building.landArea, entity);
     playerComp.player->removeOwnership(entity);
 
-    m_damagedBuildings.erase(entity);
+    if (vision.hasVision)
+    {
+        playerComp.player->getVision()->removeSight(building.landArea, vision.lineOfSight);
+        vision.hasVision = false;
+    }
+
+    if (auto it = m_damagedBuildings.find(entity); it != m_damagedBuildings.end())
+    {
+        m_timers->cancel(it->second);
+        m_damagedBuildings.erase(it);
+    }
+    if (auto factory = m_stateMan->tryGetComponent<CompUnitFactory>(entity))
+    {
+        m_timers->cancel(factory->productionTimer);
+    }
 
     for (auto child : info.getChildEntities())
     {
@@ -2,13 +2,14 @@
 #define BUILDINGMANAGER_H
 
 #include "EventHandler.h"
+#include "TimerService.h"
 #include "components/CompUnitFactory.h"
 #include "components/CompVision.h"
 #include "utils/LazyServiceRef.h"
 
-#include <functional>
-#include <map>
+#include <span>
 #include <tuple>
+#include <unordered_map>
 
 namespace core
 {
@@ -16,44 +17,48 @@ class CompBuilding;
 class CompTransform;
 class CompPlayer;
 class EntityTypeRegistry;
+class PlayerFactory;
 class BuildingManager : public EventHandler
 {
   public:
     BuildingManager();
 
   private:
-    struct ActiveFactoryInfo
-    {
-        std::reference_wrapper<CompUnitFactory> factory;
-        uint32_t building;
-        Ref<Player> player;
-    };
+    // Paused productions and damaged buildings without fire are revisited at this rate
+    static constexpr int RECHECK_INTERVAL_MS = 250;
 
     LazyServiceRef<StateManager> m_stateMan;
     LazyServiceRef<Settings> m_settings;
     LazyServiceRef<EntityTypeRegistry> m_typeRegistry;
-    std::map<uint32_t /*building id*/, ActiveFactoryInfo> m_activeFactories;
-    std::set<uint32_t> m_damagedBuildings;
+    LazyServiceRef<PlayerFactory> m_playerFactory;
+    LazyServiceRef<TimerService> m_timers;
+    TimerService::ChannelId m_productionChannel = 0;
+    TimerService::ChannelId m_damageChannel = 0;
+    std::unordered_map<uint32_t /*building id*/, TimerId> m_damagedBuildings;
 
   private:
+    void onInit(EventLoop& eventLoop) override;
     bool onBuildingRequest(const Event& e);
     bool onTick(const Event& e);
     bool onEntityDeletion(const Event& e);
 
     void deleteBuilding(uint32_t entity);
     void handleBuildingUpdates(const TickData& tick);
-    void handleBuildingDamages(const TickData& tick);
     void handleConstructionProgress(const TickData& tick, CompBuilding& building, uint32_t entity);
     void detectDamagedBuildings(const TickData& tick, CompBuilding& building, uint32_t entity);
-    void handleBuildingDamage(const TickData& tick, CompBuilding& building, uint32_t entity);
-    void updateInProgressUnitCreations(const TickData& tick);
+    void onDamageTimers(std::span<const uint32_t> buildings, int currentTick);
+    int handleBuildingDamage(CompBuilding& building, uint32_t entity, int currentTick);
+    void onProductionTimers(std::span<const uint32_t> buildings, int currentTick);
+    void advanceProduction(uint32_t building, CompUnitFactory& factory, int currentTick);
+    bool hasRoomForUnit(const Player& player, uint32_t unitType, CompUnitFactory& factory) const;
+    int toTicks(int durationMs) const;
     bool onQueueUnit(const Event& e);
     bool onUngarrison(const Event& e);
     std::tuple<CompEntityInfo&, CompBuilding&> createBuilding(const BuildingPlacementData& request);
     void makeBuildingPermanent(uint32_t entity);
     void onCompleteBuilding(uint32_t entity,
                             const CompBuilding& building,
-                            const CompVision& vision,
+                            CompVision& vision,
                             const CompTransform& transform,
                             const CompPlayer& player,
                             const CompEntityInfo& info);
@@ -1,6 +1,8 @@
 #include "CommandCenter.h"
 
 #include "StateManager.h"
+#include "commands/CmdIdle.h"
+#include "commands/CmdMove.h"
 #include "commands/Command.h"
 #include "components/CompUnit.h"
 #include "logging/Logger.h"
@@ -12,6 +14,9 @@ CommandCenter::CommandCenter()
 {
     registerCallback(Event::Type::TICK, this, &CommandCenter::onTick);
     registerCallback(Event::Type::COMMAND_REQUEST, this, &CommandCenter::onCommandRequest);
+
+    registerBatchKernel<CmdIdle>(&CmdIdle::executeBatch);
+    registerBatchKernel<CmdMove>(&CmdMove::executeBatch);
 }
 
 bool CommandCenter::onCommandRequest(const Event& e)
@@ -26,85 +31,172 @@ bool CommandCenter::onCommandRequest(const Event& e)
         ServiceRegistry::getInstance().getService<StateManager>()->getComponent<CompUnit>(
             data.entity);
 
-    // Remove all the components except the default one (i.e. idle)
-    while (unit.commandQueue.size() > 1)
-    {
-        debug_assert(unit.commandQueue.top()->getPriority() >= 0,
-                     "Command {} for entity {} has invalid priority set",
-                     unit.commandQueue.top()->toString(), unit.commandQueue.top()->getEntityID());
+    unit.sleepingUntilTick = 0; // The stale wake-up in the wheel is ignored
 
-        if (unit.commandQueue.top()->getPriority() > Command::DEFAULT_PRIORITY)
+    // Remove all the commands except the default one (i.e. idle)
+    unit.commandQueue.removeIf(
+        [](Command* cmd)
         {
-            unit.commandQueue.pop();
-        }
-    }
-    unit.commandQueue.push(data.command);
-    data.command->onQueue();
+            debug_assert(cmd->getPriority() >= 0,
+                         "Command {} for entity {} has invalid priority set", cmd->toString(),
+                         cmd->getEntityID());
+
+            if (cmd->getPriority() <= Command::DEFAULT_PRIORITY)
+                return false;
+
+            cmd->destroy();
+            return true;
+        });
+    queueCommand(unit, data.command);
     return false;
 }
 
 bool CommandCenter::onTick(const Event& e)
 {
-    std::list<Command*> newCommands;
+    auto tickData = e.getData<TickData>();
+
+    wakeUpUnits(tickData.currentTick);
+
+    for (auto& batch : m_batches)
+    {
+        batch.commands.clear();
+        batch.entities.clear();
+        batch.units.clear();
+    }
+
+    // Bucket the current command of every unit by the command type. Units are neither
+    // created nor destroyed while commands execute, so the pointers stay valid.
     ServiceRegistry::getInstance().getService<StateManager>()->getEntities<CompUnit>().each(
-        [this, &newCommands, &e](uint32_t entity, CompUnit& unit)
+        [this](uint32_t entity, CompUnit& unit)
         {
-            if (!unit.commandQueue.empty())
-            {
-                auto cmd = unit.commandQueue.top();
-                if (cmd->isExecutedAtLeastOnce() == false)
-                {
-                    cmd->onStart();
-                    cmd->setExecutedAtLeastOnce(true);
-                }
-
-                auto tickData = e.getData<TickData>();
-                auto completed =
-                    cmd->onExecute(tickData.deltaTimeMs, tickData.currentTick, newCommands);
-
-                for (auto subCmd : newCommands)
-                {
-                    subCmd->setEntityID(entity);
-                    subCmd->init();
-                    unit.commandQueue.push(subCmd);
-                    subCmd->onQueue();
-                }
-                newCommands.clear();
-
-                if (completed)
-                {
-                    spdlog::debug("Entity {}'s command {} completed.", entity, cmd->toString());
-
-                    /*
-                     *   Time to remove the current command from unit's queue. However,
-                     *   since ordering is not guaranteed for same priority value in
-                     *   std::priority_queue, we need to ensure we remove the correct
-                     *   command. This can be done only by checking each and putting back
-                     *   any commands we popped mistakenly.
-                     *   There can be a better way to do this. But this isn't a common
-                     *   occurrence.
-                     */
-                    std::list<Command*> commandsToPutBack;
-                    while (not unit.commandQueue.empty())
-                    {
-                        auto top = unit.commandQueue.top();
-                        unit.commandQueue.pop();
-
-                        if (top == cmd)
-                        {
-                            cmd->destroy();
-                            break;
-                        }
-                        // We removed the wrong command, take a note to put it back later.
-                        commandsToPutBack.push_back(top);
-                    }
-
-                    for (auto remainingCmd : commandsToPutBack)
-                    {
-                        unit.commandQueue.push(remainingCmd);
-                    }
-                }
-            }
+            if (unit.commandQueue.empty() or unit.sleepingUntilTick != 0)
+                return;
+
+            auto cmd = unit.commandQueue.top();
+            auto& batch = getBatch(*cmd);
+            batch.commands.push_back(cmd);
+            batch.entities.push_back(entity);
+            batch.units.push_back(&unit);
         });
+
+    for (auto& batch : m_batches)
+    {
+        if (not batch.commands.empty())
+            executeBatch(batch, tickData.deltaTimeMs, tickData.currentTick);
+    }
     return false;
-}
\ No newline at end of file
+}
+
+CommandCenter::CommandBatch& CommandCenter::getBatch(const Command& command)
+{
+    std::type_index type(typeid(command));
+
+    auto [it, inserted] = m_batchIndices.try_emplace(type, m_batches.size());
+    if (inserted)
+    {
+        auto& batch = m_batches.emplace_back();
+        batch.type = type;
+
+        auto kernel = m_batchKernels.find(type);
+        if (kernel != m_batchKernels.end())
+            batch.kernel = kernel->second;
+    }
+    return m_batches[it->second];
+}
+
+void CommandCenter::executeBatch(CommandBatch& batch, int deltaTimeMs, int currentTick)
+{
+    if (batch.kernel != nullptr)
+    {
+        // Kernel executes the whole batch in one go, hence started together right before
+        for (auto cmd : batch.commands)
+        {
+            startIfNew(*cmd);
+        }
+
+        m_completed.assign(batch.commands.size(), 0);
+        batch.kernel(batch.commands, deltaTimeMs, currentTick, m_completed);
+
+        for (size_t i = 0; i < batch.commands.size(); ++i)
+        {
+            onCommandExecuted(batch.entities[i], *batch.units[i], batch.commands[i],
+                              m_completed[i], currentTick);
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < batch.commands.size(); ++i)
+    {
+        auto cmd = batch.commands[i];
+        startIfNew(*cmd);
+        auto completed = cmd->onExecute(deltaTimeMs, currentTick, m_newCommands);
+        onCommandExecuted(batch.entities[i], *batch.units[i], cmd, completed, currentTick);
+    }
+}
+
+void CommandCenter::startIfNew(Command& cmd)
+{
+    if (cmd.isExecutedAtLeastOnce() == false)
+    {
+        cmd.onStart();
+        cmd.setExecutedAtLeastOnce(true);
+    }
+}
+
+void CommandCenter::onCommandExecuted(
+    uint32_t entity, CompUnit& unit, Command* cmd, bool completed, int currentTick)
+{
+    auto sleepUntilTick = cmd->takeSleepRequest();
+    if (not completed and m_newCommands.empty() and sleepUntilTick > currentTick)
+    {
+        unit.sleepingUntilTick = sleepUntilTick;
+        m_sleepingUnits.schedule(entity, sleepUntilTick);
+        return;
+    }
+
+    if (completed)
+    {
+        spdlog::debug("Entity {}'s command {} completed.", entity, cmd->toString());
+
+        // Before queuing the follow-ups, to free up the space in the queue
+        if (unit.commandQueue.remove(cmd))
+            cmd->destroy();
+    }
+
+    for (auto subCmd : m_newCommands)
+    {
+        subCmd->setEntityID(entity);
+        subCmd->init();
+        queueCommand(unit, subCmd);
+    }
+    m_newCommands.clear();
+}
+
+void CommandCenter::queueCommand(CompUnit& unit, Command* cmd)
+{
+    if (not unit.commandQueue.push(cmd)) [[unlikely]]
+    {
+        spdlog::error("Command queue of entity {} is full, dropping command {}",
+                      cmd->getEntityID(), cmd->toString());
+        cmd->destroy();
+        return;
+    }
+    cmd->onQueue();
+}
+
+void CommandCenter::wakeUpUnits(int currentTick)
+{
+    auto stateMan = ServiceRegistry::getInstance().getService<StateManager>();
+
+    m_sleepingUnits.advance(currentTick,
+                            [&stateMan](uint32_t entity, int tick)
+                            {
+                                if (not stateMan->getRegistry().valid(entity))
+                                    return;
+
+                                // Might have been woken up and put to sleep again since
+                                auto unit = stateMan->tryGetComponent<CompUnit>(entity);
+                                if (unit != nullptr and unit->sleepingUntilTick == tick)
+                                    unit->sleepingUntilTick = 0;
+                            });
+}
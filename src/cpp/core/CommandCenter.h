@@ -2,9 +2,40 @@
 #define COMMANDCENTER_H
 
 #include "EventHandler.h"
+#include "TimingWheel.h"
+
+#include <list>
+#include <span>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
 
 namespace core
 {
+class Command;
+class CompUnit;
+
+/*
+ *   Executes the current commands of a single concrete command type in one go.
+ *   Sets completed[i] for commands[i]. Kernels can't create sub-commands, commands
+ *   which might do so should stay on the per command path.
+ */
+using CommandBatchKernel = void (*)(std::span<Command* const> commands,
+                                    int deltaTimeMs,
+                                    int currentTick,
+                                    std::span<uint8_t> completed);
+
+/*
+ *   Executes the commands of the units every tick.
+ *
+ *   Units whose command requested to sleep (see Command::sleepUntil) are skipped until
+ *   the requested tick, tracked by a timing wheel, or until they receive a new command.
+ *   Hence the tick cost follows the active units rather than the whole population.
+ *
+ *   Current commands are executed in batches per command type. A new command is
+ *   started (i.e. onStart) right before its first execution, or right before its
+ *   batch's kernel for the batched types, not while the batches are built.
+ */
 class CommandCenter : public EventHandler
 {
   public:
@@ -12,7 +43,43 @@ class CommandCenter : public EventHandler
 
     bool onTick(const Event& e);
     bool onCommandRequest(const Event& e);
+
+    // Kernel is used only for the exact type T, not for its subclasses
+    template <typename T> void registerBatchKernel(CommandBatchKernel kernel)
+    {
+        m_batchKernels[std::type_index(typeid(T))] = kernel;
+    }
+
+  private:
+    /*
+     *   Current commands of all the units sharing the same concrete type. Batches
+     *   are cleared but kept between ticks to reuse their storage.
+     */
+    struct CommandBatch
+    {
+        std::type_index type = typeid(void);
+        CommandBatchKernel kernel = nullptr;
+        std::vector<Command*> commands;
+        std::vector<uint32_t> entities;
+        std::vector<CompUnit*> units;
+    };
+
+    CommandBatch& getBatch(const Command& command);
+    void executeBatch(CommandBatch& batch, int deltaTimeMs, int currentTick);
+    void startIfNew(Command& cmd);
+    void onCommandExecuted(
+        uint32_t entity, CompUnit& unit, Command* cmd, bool completed, int currentTick);
+    void queueCommand(CompUnit& unit, Command* cmd);
+    void wakeUpUnits(int currentTick);
+
+  private:
+    std::unordered_map<std::type_index, CommandBatchKernel> m_batchKernels;
+    std::unordered_map<std::type_index, size_t> m_batchIndices;
+    std::vector<CommandBatch> m_batches;
+    std::vector<uint8_t> m_completed;
+    std::list<Command*> m_newCommands;
+    TimingWheel<uint32_t> m_sleepingUnits;
 };
 } // namespace core
 
-#endif
\ No newline at end of file
+#endif
@@ -5,6 +5,7 @@
 #include "components/CompEntityInfo.h"
 #include "components/CompGraphics.h"
 #include "components/CompPlayer.h"
+#include "components/CompSelectible.h"
 #include "components/CompTransform.h"
 
 using namespace core;
@@ -20,6 +21,12 @@ CursorManager::CursorManager()
                      &CursorManager::onBuildingPlacementEnded);
     registerCallback(Event::Type::ENTITY_SELECTION, this, &CursorManager::onEntitySelection);
     registerCallback(Event::Type::GARRISON_REQUEST, this, &CursorManager::onGarrisonRequest);
+
+    declareAccess(SystemAccess()
+                      .reads<TileMap, Coordinates, HumanController, CompSelectible,
+                             CompTransform, CompPlayer, CompBuilder>()
+                      .writes<CompCursor>()
+                      .appends<DirtyEntities>());
 }
 
 bool CursorManager::onMouseMove(const Event& e)
@@ -134,7 +134,8 @@ void DebugWindow::showDebugWindow()
 
         if (auto unit = m_stateManager->tryGetComponent<CompUnit>(selectedEntityTemp))
         {
-            tableKVFmt("Command", "%s", unit->commandQueue.top()->toString().c_str());
+            if (not unit->commandQueue.empty())
+                tableKVFmt("Command", "%s", unit->commandQueue.top()->toString().c_str());
             tableKVFmt("In Formation", "%s", unit->formationSlot.isValid() ? "true" : "false");
         }
 
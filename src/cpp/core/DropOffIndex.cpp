@@ -0,0 +1,133 @@
+#include "DropOffIndex.h"
+
+#include "Player.h"
+#include "StateManager.h"
+#include "components/CompBuilding.h"
+#include "components/CompEntityInfo.h"
+#include "components/CompPlayer.h"
+#include "components/CompTransform.h"
+#include "debug.h"
+#include "logging/Logger.h"
+
+using namespace core;
+
+DropOffIndex::DropOffIndex()
+{
+    registerCallback(Event::Type::BUILDING_CONSTRUCTED, this,
+                     &DropOffIndex::onBuildingConstructed);
+    registerCallback(Event::Type::ENTITY_DELETE, this, &DropOffIndex::onEntityDeletion);
+
+    // Updated on building events only, read by the commands
+    declareAccess(SystemAccess()
+                      .reads<CompBuilding, CompPlayer, CompTransform, CompEntityInfo>()
+                      .writes<DropOffIndex>());
+}
+
+void DropOffIndex::init(int width, int height)
+{
+    m_width = width;
+    m_height = height;
+
+    for (auto& grids : m_grids)
+    {
+        for (auto& grid : grids)
+        {
+            grid = SpatialGrid();
+        }
+    }
+    m_dropOffs.clear();
+}
+
+void DropOffIndex::onInit(EventLoop& eventLoop)
+{
+    auto& tileMap = m_stateMan->gameMap();
+    init(tileMap.width, tileMap.height);
+
+    // Buildings constructed before this got registered
+    m_stateMan->getEntities<CompBuilding, CompPlayer, CompTransform, CompEntityInfo>().each(
+        [this](uint32_t entity, CompBuilding& building, CompPlayer& player,
+               CompTransform& transform, CompEntityInfo& info)
+        {
+            if (building.isConstructed() and not info.isDestroyed and player.player)
+                addDropOff(entity, player.player->getId(), building, transform.position.toTile());
+        });
+}
+
+bool DropOffIndex::onBuildingConstructed(const Event& e)
+{
+    const auto& data = e.getData<BuildingConstructedData>();
+    auto [building, info] = m_stateMan->getComponents<CompBuilding, CompEntityInfo>(data.entity);
+
+    if (not info.isDestroyed)
+        addDropOff(data.entity, data.playerId, building, data.pos.toTile());
+    return false;
+}
+
+bool DropOffIndex::onEntityDeletion(const Event& e)
+{
+    removeDropOff(e.getData<EntityDeleteData>().entity);
+    return false;
+}
+
+void DropOffIndex::addDropOff(uint32_t entity,
+                              uint8_t playerId,
+                              const CompBuilding& building,
+                              const Tile& tile)
+{
+    debug_assert(playerId < Constants::MAX_PLAYERS, "Invalid player id {}", playerId);
+
+    DropOff dropOff{.playerId = playerId, .tile = tile};
+    for (uint8_t type = 0; type < Constants::MAX_RESOURCE_TYPES; ++type)
+    {
+        if (type != Constants::RESOURCE_TYPE_NONE and building.acceptResource(type))
+            dropOff.resourceTypes |= 1 << type;
+    }
+
+    if (dropOff.resourceTypes == 0 or m_dropOffs.contains(entity))
+        return;
+
+    for (uint8_t type = 0; type < Constants::MAX_RESOURCE_TYPES; ++type)
+    {
+        if (dropOff.resourceTypes & (1 << type))
+            getGrid(playerId, type).insert(entity, tile);
+    }
+    m_dropOffs.emplace(entity, dropOff);
+    ++m_versions[playerId];
+
+    spdlog::debug("Drop-off point {} of player {} added at {}", entity, playerId,
+                  tile.toString());
+}
+
+void DropOffIndex::removeDropOff(uint32_t entity)
+{
+    auto it = m_dropOffs.find(entity);
+    if (it == m_dropOffs.end())
+        return;
+
+    const auto& dropOff = it->second;
+    for (uint8_t type = 0; type < Constants::MAX_RESOURCE_TYPES; ++type)
+    {
+        if (dropOff.resourceTypes & (1 << type))
+            getGrid(dropOff.playerId, type).remove(entity, dropOff.tile);
+    }
+    ++m_versions[dropOff.playerId];
+    m_dropOffs.erase(it);
+}
+
+uint32_t DropOffIndex::findNearest(uint8_t playerId, uint8_t resourceType, const Tile& from) const
+{
+    debug_assert(playerId < Constants::MAX_PLAYERS, "Invalid player id {}", playerId);
+    debug_assert(resourceType < Constants::MAX_RESOURCE_TYPES, "Invalid resource type {}",
+                 resourceType);
+
+    auto nearest = m_grids[playerId][resourceType].findNearest(from);
+    return nearest ? nearest->entity : entt::null;
+}
+
+SpatialGrid& DropOffIndex::getGrid(uint8_t playerId, uint8_t resourceType)
+{
+    auto& grid = m_grids[playerId][resourceType];
+    if (not grid.isInitialized())
+        grid.init(m_width, m_height, BUCKET_SIZE);
+    return grid;
+}
@@ -0,0 +1,76 @@
+#ifndef CORE_DROPOFFINDEX_H
+#define CORE_DROPOFFINDEX_H
+
+#include "EventHandler.h"
+#include "SpatialGrid.h"
+#include "utils/Constants.h"
+#include "utils/LazyServiceRef.h"
+
+#include <array>
+#include <entt/entity/registry.hpp>
+#include <unordered_map>
+
+namespace core
+{
+class StateManager;
+class CompBuilding;
+
+/*
+ *   Drop-off points (i.e. constructed buildings accepting resources) per player and
+ *   resource type, each in a SpatialGrid. Updated on BUILDING_CONSTRUCTED and
+ *   ENTITY_DELETE.
+ *
+ *   Every change bumps the version of the owning player, hence gatherers can cache
+ *   their lookups (see CompResourceGatherer) and query again only after the player's
+ *   drop-off points changed.
+ */
+class DropOffIndex : public EventHandler
+{
+  public:
+    static constexpr int BUCKET_SIZE = 16; // Drop-off points are sparse
+
+    DropOffIndex();
+
+    void init(int width, int height);
+
+    void addDropOff(uint32_t entity,
+                    uint8_t playerId,
+                    const CompBuilding& building,
+                    const Tile& tile);
+    void removeDropOff(uint32_t entity);
+
+    // Nearest drop-off point of the player accepting the resource, entt::null if none
+    uint32_t findNearest(uint8_t playerId, uint8_t resourceType, const Tile& from) const;
+
+    uint32_t getVersion(uint8_t playerId) const
+    {
+        return m_versions[playerId];
+    }
+
+  protected:
+    void onInit(EventLoop& eventLoop) override;
+    bool onBuildingConstructed(const Event& e);
+    bool onEntityDeletion(const Event& e);
+
+  private:
+    struct DropOff
+    {
+        uint8_t playerId = 0;
+        uint8_t resourceTypes = 0; // A bit per accepted resource type
+        Tile tile;
+    };
+
+    SpatialGrid& getGrid(uint8_t playerId, uint8_t resourceType);
+
+    LazyServiceRef<StateManager> m_stateMan;
+    int m_width = 0;
+    int m_height = 0;
+    // Initialized on the first drop-off point, most players never accept most types
+    std::array<std::array<SpatialGrid, Constants::MAX_RESOURCE_TYPES>, Constants::MAX_PLAYERS>
+        m_grids;
+    std::array<uint32_t, Constants::MAX_PLAYERS> m_versions{};
+    std::unordered_map<uint32_t, DropOff> m_dropOffs; // by building entity
+};
+} // namespace core
+
+#endif // CORE_DROPOFFINDEX_H
@@ -0,0 +1,247 @@
+#include "EnemyQueryService.h"
+
+#include "Player.h"
+#include "StateManager.h"
+#include "components/CompArmor.h"
+#include "components/CompBuilding.h"
+#include "components/CompEntityInfo.h"
+#include "components/CompHealth.h"
+#include "components/CompPlayer.h"
+#include "components/CompTransform.h"
+#include "debug.h"
+#include "logging/Logger.h"
+
+#include <bit>
+#include <limits>
+
+using namespace core;
+
+namespace
+{
+uint64_t getArmorClasses(const CompArmor& armor)
+{
+    uint64_t classes = 0;
+    for (const auto& [armorClass, _] : armor.armorPerClassMap.value())
+    {
+        if (armorClass >= 0 and armorClass < 64)
+            classes |= uint64_t(1) << armorClass;
+    }
+    return classes;
+}
+
+template <typename Fn> void forEachPlayer(uint32_t playerMask, Fn&& fn)
+{
+    while (playerMask != 0)
+    {
+        fn(uint8_t(std::countr_zero(playerMask)));
+        playerMask &= playerMask - 1;
+    }
+}
+} // namespace
+
+EnemyQueryService::EnemyQueryService()
+{
+    // No callbacks of its own, the grids are updated from TileMap listener callbacks (i.e.
+    // by whichever system modifies the units or static layers, which then writes this too)
+    // and read by the commands.
+    declareAccess(SystemAccess()
+                      .reads<TileMap, CompPlayer, CompArmor, CompBuilding, CompTransform>()
+                      .writes<EnemyQueryService>());
+}
+
+void EnemyQueryService::init(int width, int height)
+{
+    m_width = width;
+    m_height = height;
+
+    for (auto& grid : m_grids)
+    {
+        grid = SpatialGrid();
+    }
+    m_targets.clear();
+}
+
+void EnemyQueryService::onInit(EventLoop& eventLoop)
+{
+    auto& tileMap = m_stateMan->gameMap();
+    init(tileMap.width, tileMap.height);
+    tileMap.registerListner(shared_from_this());
+
+    // Entities placed on the map before this got registered
+    for (uint32_t x = 0; x < tileMap.width; ++x)
+    {
+        for (uint32_t y = 0; y < tileMap.height; ++y)
+        {
+            for (auto layer : {MapLayerType::UNITS, MapLayerType::STATIC})
+            {
+                for (auto entity : tileMap.getEntities(layer, Tile(x, y)))
+                {
+                    onEntityEnter(entity, Tile(x, y), layer);
+                }
+            }
+        }
+    }
+}
+
+void EnemyQueryService::onEntityEnter(uint32_t entity, const Tile& tile, MapLayerType layer)
+{
+    if (layer != MapLayerType::UNITS and layer != MapLayerType::STATIC)
+        return;
+
+    auto info = getTargetInfo(entity);
+    if (info and info->entity == entity)
+    {
+        // Another tile of a building
+        if (info->isIndexed and info->isBuilding)
+            return;
+
+        // Attributes don't change during the entity's lifetime, no need to look them up
+        // again as the entity moves across tiles
+        const Tile targetTile = info->isBuilding ? info->tile : tile;
+        addTarget(entity, info->playerId, targetTile, info->armorClasses, info->isBuilding);
+        return;
+    }
+
+    auto player = m_stateMan->tryGetComponent<CompPlayer>(entity);
+    if (player == nullptr or player->player == nullptr)
+        return; // E.g. resources
+
+    auto armor = m_stateMan->tryGetComponent<CompArmor>(entity);
+    const uint64_t armorClasses = armor ? getArmorClasses(*armor) : 0;
+    const bool isBuilding = m_stateMan->hasComponent<CompBuilding>(entity);
+
+    // A building is indexed at its center, regardless of the tile it entered first
+    const Tile targetTile =
+        isBuilding ? m_stateMan->getComponent<CompTransform>(entity).position.toTile() : tile;
+
+    addTarget(entity, player->player->getId(), targetTile, armorClasses, isBuilding);
+}
+
+void EnemyQueryService::onEntityExit(uint32_t entity, const Tile& tile, MapLayerType layer)
+{
+    if (layer == MapLayerType::UNITS or layer == MapLayerType::STATIC)
+        removeTarget(entity);
+}
+
+void EnemyQueryService::addTarget(uint32_t entity,
+                                  uint8_t playerId,
+                                  const Tile& tile,
+                                  uint64_t armorClasses,
+                                  bool isBuilding)
+{
+    debug_assert(playerId < Constants::MAX_PLAYERS, "Invalid player id {}", playerId);
+
+    const auto index = entt::to_entity(entity);
+    if (index >= m_targets.size())
+        m_targets.resize(index + 1);
+
+    auto& info = m_targets[index];
+    if (info.isIndexed)
+        removeTarget(info.entity);
+
+    info = TargetInfo{.entity = entity,
+                      .armorClasses = armorClasses,
+                      .tile = tile,
+                      .playerId = playerId,
+                      .isBuilding = isBuilding,
+                      .isIndexed = true};
+    getGrid(playerId).insert(entity, tile);
+}
+
+void EnemyQueryService::removeTarget(uint32_t entity)
+{
+    auto info = getTargetInfo(entity);
+    if (info == nullptr or not info->isIndexed or info->entity != entity)
+        return;
+
+    bool removed = m_grids[info->playerId].remove(entity, info->tile);
+    debug_assert(removed, "Target {} is missing in the grid of player {}", entity,
+                 info->playerId);
+    info->isIndexed = false;
+}
+
+uint32_t EnemyQueryService::findNearestEnemy(const Player& player,
+                                             const Tile& from,
+                                             int range,
+                                             const TargetFilter& filter) const
+{
+    uint32_t nearest = entt::null;
+    int nearestDistance = std::numeric_limits<int>::max();
+    auto accept = [&](const SpatialGrid::Item& item) { return isAccepted(item.entity, filter); };
+
+    forEachPlayer(player.getAllegianceMask(Allegiance::ENEMY),
+                  [&](uint8_t enemyId)
+                  {
+                      auto candidate = m_grids[enemyId].findNearest(from, range, accept);
+                      if (not candidate)
+                          return;
+
+                      auto distance = SpatialGrid::getDistanceSquared(from, candidate->tile);
+                      if (distance < nearestDistance)
+                      {
+                          nearestDistance = distance;
+                          nearest = candidate->entity;
+                      }
+                  });
+    return nearest;
+}
+
+size_t EnemyQueryService::findEnemiesInRadius(const Player& player,
+                                              const Tile& from,
+                                              int radius,
+                                              std::span<uint32_t> out,
+                                              const TargetFilter& filter) const
+{
+    size_t count = 0;
+    auto accept = [&](const SpatialGrid::Item& item) { return isAccepted(item.entity, filter); };
+
+    forEachPlayer(player.getAllegianceMask(Allegiance::ENEMY),
+                  [&](uint8_t enemyId)
+                  {
+                      count += m_grids[enemyId].findInRadius(from, radius, out.subspan(count),
+                                                             accept);
+                  });
+    return count;
+}
+
+EnemyQueryService::TargetInfo* EnemyQueryService::getTargetInfo(uint32_t entity)
+{
+    const auto index = entt::to_entity(entity);
+    return index < m_targets.size() ? &m_targets[index] : nullptr;
+}
+
+const EnemyQueryService::TargetInfo* EnemyQueryService::getTargetInfo(uint32_t entity) const
+{
+    const auto index = entt::to_entity(entity);
+    return index < m_targets.size() ? &m_targets[index] : nullptr;
+}
+
+bool EnemyQueryService::isAccepted(uint32_t entity, const TargetFilter& filter) const
+{
+    const auto& info = m_targets[entt::to_entity(entity)];
+
+    if (not(info.isBuilding ? filter.buildings : filter.units))
+        return false;
+
+    if (filter.armorClasses != TargetFilter::ANY_ARMOR_CLASS and
+        (info.armorClasses & filter.armorClasses) == 0)
+        return false;
+
+    // Killed targets stay indexed until they are removed from the map, e.g. the one just
+    // killed by the querying unit
+    if (auto health = m_stateMan->tryGetComponent<CompHealth>(entity))
+    {
+        if (health->health <= 0 or health->isDead)
+            return false;
+    }
+    auto entityInfo = m_stateMan->tryGetComponent<CompEntityInfo>(entity);
+    return entityInfo == nullptr or not entityInfo->isDestroyed;
+}
+
+SpatialGrid& EnemyQueryService::getGrid(uint8_t playerId)
+{
+    auto& grid = m_grids[playerId];
+    if (not grid.isInitialized())
+        grid.init(m_width, m_height);
+    return grid;
+}
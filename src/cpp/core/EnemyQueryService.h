@@ -0,0 +1,99 @@
+#ifndef CORE_ENEMYQUERYSERVICE_H
+#define CORE_ENEMYQUERYSERVICE_H
+
+#include "EventHandler.h"
+#include "SpatialGrid.h"
+#include "TileMapListner.h"
+#include "utils/Constants.h"
+#include "utils/LazyServiceRef.h"
+
+#include <array>
+#include <entt/entity/registry.hpp>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace core
+{
+class Player;
+class StateManager;
+
+/*
+ *   Answers target acquisition queries, i.e. "nearest enemy within R tiles" and "enemies
+ *   within R tiles", for the attack commands and the like.
+ *
+ *   Keeps the attackable entities (i.e. units on the map and buildings) of every player
+ *   in a SpatialGrid per player, updated through the TileMap listener as units move
+ *   across tiles. A query visits only the grids of the players hostile to the querying
+ *   player (see Player::getAllegianceMask) and doesn't allocate.
+ */
+class EnemyQueryService : public EventHandler,
+                          public TileMapListner,
+                          public std::enable_shared_from_this<EnemyQueryService>
+{
+  public:
+    struct TargetFilter
+    {
+        static constexpr uint64_t ANY_ARMOR_CLASS = ~uint64_t(0);
+
+        uint64_t armorClasses = ANY_ARMOR_CLASS; // Targets having any of these armor classes
+        bool units = true;
+        bool buildings = true;
+    };
+
+    EnemyQueryService();
+
+    void init(int width, int height);
+
+    void addTarget(uint32_t entity,
+                   uint8_t playerId,
+                   const Tile& tile,
+                   uint64_t armorClasses,
+                   bool isBuilding);
+    void removeTarget(uint32_t entity);
+
+    // Nearest enemy of the player within range tiles, entt::null if none
+    uint32_t findNearestEnemy(const Player& player,
+                              const Tile& from,
+                              int range,
+                              const TargetFilter& filter = {}) const;
+    // Enemies of the player within radius tiles, in no particular order. Returns the
+    // number of enemies written to out.
+    size_t findEnemiesInRadius(const Player& player,
+                               const Tile& from,
+                               int radius,
+                               std::span<uint32_t> out,
+                               const TargetFilter& filter = {}) const;
+
+  protected:
+    void onInit(EventLoop& eventLoop) override;
+    void onEntityEnter(uint32_t entity, const Tile& tile, MapLayerType layer) override;
+    void onEntityExit(uint32_t entity, const Tile& tile, MapLayerType layer) override;
+
+  private:
+    struct TargetInfo
+    {
+        uint32_t entity = entt::null;
+        uint64_t armorClasses = 0;
+        Tile tile;
+        uint8_t playerId = 0;
+        bool isBuilding = false;
+        bool isIndexed = false;
+    };
+
+    // By entity index, i.e. without the version
+    TargetInfo* getTargetInfo(uint32_t entity);
+    const TargetInfo* getTargetInfo(uint32_t entity) const;
+    bool isAccepted(uint32_t entity, const TargetFilter& filter) const;
+    SpatialGrid& getGrid(uint8_t playerId);
+
+    LazyServiceRef<StateManager> m_stateMan;
+    int m_width = 0;
+    int m_height = 0;
+    // Initialized on the first target of the player
+    std::array<SpatialGrid, Constants::MAX_PLAYERS> m_grids;
+    std::vector<TargetInfo> m_targets;
+};
+} // namespace core
+
+#endif // CORE_ENEMYQUERYSERVICE_H
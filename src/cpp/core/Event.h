@@ -7,6 +7,7 @@
 #include "Player.h"
 #include "Tile.h"
 #include "commands/Command.h"
+#include "utils/Types.h"
 
 #include <entt/entity/registry.hpp>
 #include <variant>
@@ -68,7 +69,7 @@ struct UnitTileMovementData
 
 struct BuildingPlacementData
 {
-    Ref<Player> player;
+    uint8_t playerId = Player::INVALID_ID;
     uint32_t entityType = 0;
     Feet pos = Feet::null;
     uint32_t entity = entt::null;
@@ -98,7 +99,7 @@ struct BuildingPlacementData
 
 struct BuildingConstructedData
 {
-    Ref<Player> player;
+    uint8_t playerId = Player::INVALID_ID;
     uint32_t entityType = 0;
     Feet pos = Feet::null;
     uint32_t entity = entt::null;
@@ -111,27 +112,27 @@ struct EntityDeleteData
 
 struct UnitCreationData
 {
-    Ref<Player> player;
+    uint8_t playerId = Player::INVALID_ID;
     Feet position;
     uint32_t entityType = 0;
 };
 
 struct UnitQueueData
 {
-    Ref<Player> player;
+    uint8_t playerId = Player::INVALID_ID;
     uint32_t entityType = 0; // Unit type
     uint32_t building = entt::null;
 };
 
 struct UngarrisonData
 {
-    Ref<Player> player;
+    uint8_t playerId = Player::INVALID_ID;
     uint32_t building = entt::null;
 };
 
 struct GarrisonData
 {
-    Ref<Player> player;
+    uint8_t playerId = Player::INVALID_ID;
     bool inprogress = true; // false means ended
 };
 
@@ -160,12 +161,14 @@ struct UnitFormationData
 
 struct ProjectileData
 {
-    uint32_t projectileEntity = entt::null;
+    uint32_t projectileEntityType = 0; // ProjectileManager creates (or recycles) the entity
     Feet originPos = Feet::null;
     Feet targetPos = Feet::null;
-    ProjectileProperties properties;
     int speed = 0;
     int releaseHeight = 0;
+    // Shared with the shooter's model rather than copied, outlives the shooter if it is gone
+    // by the time handled
+    Ref<const ProjectileProperties> properties;
 };
 
 struct Event
@@ -3,11 +3,15 @@
 
 #include "Event.h"
 #include "EventLoop.h"
+#include "SystemAccess.h"
 
 #include <array>
 #include <cassert>
 #include <cstddef>
 #include <functional>
+#include <optional>
+#include <span>
+#include <vector>
 
 namespace core
 {
@@ -40,6 +44,30 @@ class EventHandler
         return consumed;
     }
 
+    // Will be called from EventLoop with all the queued events of the same type.
+    // consumed[i] marks events[i] as consumed by a previous listener.
+    void dispatchEvents(Event::Type type,
+                        std::span<const Event> events,
+                        std::vector<uint8_t>& consumed)
+    {
+        auto index = static_cast<size_t>(type);
+        assert(index < m_batchCallbacksTable.size());
+        if (auto& handler = m_batchCallbacksTable[index])
+        {
+            // Batch handlers skip and mark the consumed events themselves
+            handler(events, std::span<uint8_t>(consumed));
+            return;
+        }
+
+        for (size_t i = 0; i < events.size(); ++i)
+        {
+            if (not consumed[i])
+            {
+                consumed[i] = dispatchEvent(events[i]);
+            }
+        }
+    }
+
     template <typename T>
     void registerCallback(Event::Type type, T* instance, bool (T::*method)(const Event&))
     {
@@ -49,10 +77,42 @@ class EventHandler
         m_callbacksTable[index] = std::bind(method, instance, std::placeholders::_1);
     }
 
+    // Register a handler receiving consecutive queued events of a type at once. Takes
+    // precedence over the per event handler for game events (i.e. not for TICK and input
+    // events, which are always dispatched one by one). The handler must skip the events
+    // with consumed[i] set, and may set it to consume events[i].
+    template <typename T>
+    void registerBatchCallback(Event::Type type,
+                               T* instance,
+                               void (T::*method)(std::span<const Event>, std::span<uint8_t>))
+    {
+        static_assert(std::is_base_of_v<EventHandler, T>, "Handler must inherit from EventHandler");
+        auto index = static_cast<size_t>(type);
+        assert(index < m_batchCallbacksTable.size());
+        m_batchCallbacksTable[index] =
+            std::bind(method, instance, std::placeholders::_1, std::placeholders::_2);
+    }
+
+    // Access declared by the system for TICK processing. Systems without a declaration
+    // are never run concurrently with others.
+    const std::optional<SystemAccess>& getAccess() const
+    {
+        return m_access;
+    }
+
+  protected:
+    void declareAccess(const SystemAccess& access)
+    {
+        m_access = access;
+    }
+
   private:
     using CallbackFn = std::function<bool(const Event&)>;
+    using BatchCallbackFn = std::function<void(std::span<const Event>, std::span<uint8_t>)>;
     static constexpr size_t MAX_EVENT_TYPES = static_cast<size_t>(Event::Type::MAX_EVENT_TYPES);
     std::array<CallbackFn, MAX_EVENT_TYPES> m_callbacksTable;
+    std::array<BatchCallbackFn, MAX_EVENT_TYPES> m_batchCallbacksTable;
+    std::optional<SystemAccess> m_access;
 };
 } // namespace core
 
@@ -0,0 +1,210 @@
+#ifndef CORE_EVENTINBOX_H
+#define CORE_EVENTINBOX_H
+
+#include "Event.h"
+
+#include <array>
+#include <atomic>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <readerwriterqueue.h>
+#include <stdexcept>
+#include <vector>
+
+namespace core
+{
+/*
+ *   Multi producer single consumer inbound queue for events published from threads
+ *   other than the event loop (e.g. workers, scripting API).
+ *
+ *   Approach:
+ *   Every producer thread acquires a slot once and gets its own lock-free single
+ *   producer queue, so publishing never takes a mutex (only acquiring and recycling
+ *   a slot does). Storage is reserved upfront and the queue grows in blocks only if
+ *   a producer outruns the consumer. A released slot is recycled by the consumer once
+ *   its remaining events are drained.
+ *
+ *   The consumer drains all the producers at a defined point of a tick and merges
+ *   them ordered by (tick, producer key, sequence), where tick is the simulation tick
+ *   at the time of publishing, key is given by the producer (e.g. the index of a
+ *   worker) and sequence is per producer. Hence the order depends neither on which
+ *   producer got to the queue first within a tick nor on the slot it got.
+ */
+class EventInbox
+{
+  public:
+    static constexpr size_t MAX_PRODUCERS = 64;
+    static constexpr size_t INITIAL_CAPACITY = 128;
+
+    class Producer
+    {
+      public:
+        // Must only be called from the thread owning this producer
+        void publish(const Event& event, int tick)
+        {
+            m_queue.enqueue(Entry{tick, m_nextSequence++, event});
+        }
+
+        uint32_t getKey() const
+        {
+            return m_key;
+        }
+
+      private:
+        friend class EventInbox;
+
+        struct Entry
+        {
+            int tick = 0;
+            uint64_t sequence = 0;
+            Event event;
+        };
+
+        Producer() : m_queue(INITIAL_CAPACITY)
+        {
+        }
+
+        // Whether the entries of this go before the ones of the other on the same tick
+        bool precedes(const Producer& other) const
+        {
+            return m_key < other.m_key or (m_key == other.m_key and m_order < other.m_order);
+        }
+
+        uint32_t m_key = 0;
+        uint64_t m_order = 0; // Of acquisition, orders the producers of the same key
+        uint64_t m_nextSequence = 0;
+        std::atomic<bool> m_isReleased = false;
+        moodycamel::ReaderWriterQueue<Entry> m_queue;
+    };
+
+    /*
+     *   Thread-safe. Keys should be unique among the producers at a time and stable
+     *   across runs (i.e. tied to the system or worker, rather than to the thread).
+     *   Throws if all the slots are in use. The producer lives until released.
+     */
+    Producer& acquireProducer(uint32_t key)
+    {
+        std::lock_guard<std::mutex> lock(m_registrationMutex);
+
+        size_t slot = m_slotCount.load(std::memory_order_relaxed);
+        if (not m_freeSlots.empty())
+        {
+            slot = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        }
+        else if (slot == MAX_PRODUCERS)
+        {
+            throw std::runtime_error(
+                std::format("Too many event producers, at most {} at a time", MAX_PRODUCERS));
+        }
+
+        Producer* producer = nullptr;
+        if (m_idleProducers.empty())
+        {
+            m_ownedProducers.push_back(std::unique_ptr<Producer>(new Producer()));
+            producer = m_ownedProducers.back().get();
+        }
+        else
+        {
+            producer = m_idleProducers.back();
+            m_idleProducers.pop_back();
+        }
+        producer->m_key = key;
+        producer->m_order = m_nextOrder++;
+        producer->m_nextSequence = 0;
+        producer->m_isReleased.store(false, std::memory_order_relaxed);
+
+        m_slots[slot].store(producer, std::memory_order_release);
+        if (slot == m_slotCount.load(std::memory_order_relaxed))
+        {
+            m_slotCount.store(slot + 1, std::memory_order_release);
+        }
+        return *producer;
+    }
+
+    // Must be called from the thread owning the producer, after its last publish. The
+    // events published before are still delivered.
+    void releaseProducer(Producer& producer)
+    {
+        producer.m_isReleased.store(true, std::memory_order_release);
+    }
+
+    /*
+     *   Consumer side. Delivers the events available at the time of the call in
+     *   (tick, producer key, sequence) order. The callable is invoked as
+     *   fn(const Event&).
+     */
+    template <typename Fn> void drain(Fn&& fn)
+    {
+        const auto slotCount = m_slotCount.load(std::memory_order_acquire);
+
+        // Bound the drain to what is available now, later events wait for the next one
+        std::array<Producer*, MAX_PRODUCERS> producers;
+        std::array<size_t, MAX_PRODUCERS> available;
+        size_t total = 0;
+        for (size_t i = 0; i < slotCount; ++i)
+        {
+            producers[i] = m_slots[i].load(std::memory_order_acquire);
+            available[i] = producers[i] ? producers[i]->m_queue.size_approx() : 0;
+            total += available[i];
+        }
+
+        for (; total > 0; --total)
+        {
+            size_t next = 0;
+            const Producer::Entry* nextEntry = nullptr;
+
+            for (size_t i = 0; i < slotCount; ++i)
+            {
+                if (available[i] == 0)
+                    continue;
+
+                auto entry = producers[i]->m_queue.peek();
+                if (nextEntry == nullptr or entry->tick < nextEntry->tick or
+                    (entry->tick == nextEntry->tick and producers[i]->precedes(*producers[next])))
+                {
+                    next = i;
+                    nextEntry = entry;
+                }
+            }
+
+            fn(nextEntry->event);
+            producers[next]->m_queue.pop();
+            --available[next];
+        }
+
+        recycleReleasedProducers(slotCount);
+    }
+
+  private:
+    void recycleReleasedProducers(size_t slotCount)
+    {
+        for (size_t i = 0; i < slotCount; ++i)
+        {
+            auto producer = m_slots[i].load(std::memory_order_acquire);
+            // Released first, so that the check for remaining events sees all of them
+            if (producer == nullptr or
+                not producer->m_isReleased.load(std::memory_order_acquire) or
+                producer->m_queue.size_approx() != 0)
+                continue;
+
+            std::lock_guard<std::mutex> lock(m_registrationMutex);
+            m_slots[i].store(nullptr, std::memory_order_relaxed);
+            m_freeSlots.push_back(i);
+            m_idleProducers.push_back(producer);
+        }
+    }
+
+  private:
+    std::array<std::atomic<Producer*>, MAX_PRODUCERS> m_slots{};
+    std::atomic<size_t> m_slotCount = 0; // Slots ever used
+    std::mutex m_registrationMutex;
+    std::vector<size_t> m_freeSlots;
+    std::vector<Producer*> m_idleProducers;
+    std::vector<std::unique_ptr<Producer>> m_ownedProducers;
+    uint64_t m_nextOrder = 0;
+};
+} // namespace core
+
+#endif // CORE_EVENTINBOX_H
@@ -2,28 +2,41 @@
 
 #include "EventHandler.h"
 #include "EventPublisher.h"
+#include "ServiceRegistry.h"
+#include "Settings.h"
 #include "logging/Logger.h"
 
-#include <SDL3/SDL_keyboard.h>
-#include <SDL3/SDL_mouse.h>
-#include <SDL3/SDL_scancode.h>
+#include <SDL3/SDL_timer.h>
 #include <chrono>
+#include <limits>
+#include <optional>
 using namespace core;
 using namespace std::chrono;
 
 bool EventLoop::s_isPaused = false;
 
-EventLoop::EventLoop(std::stop_token* stopToken) : SubSystem(stopToken)
+namespace
+{
+// Inbox producer of the current thread, if it has published to the event loop before
+thread_local EventInbox::Producer* t_producer = nullptr;
+thread_local EventInbox* t_producerInbox = nullptr;
+// Given on attaching. Threads publishing without attaching go after the attached ones.
+thread_local uint32_t t_producerKey = std::numeric_limits<uint32_t>::max();
+} // namespace
+
+EventLoop::EventLoop(std::stop_token* stopToken)
+    : SubSystem(stopToken),
+      m_scheduler(Constants::FIXED_FPS, milliseconds(Constants::MAX_FRAME_DELAY_MS))
 {
-    m_previousKeyboardState = new bool[SDL_SCANCODE_COUNT];
-    for (int i = 0; i < SDL_SCANCODE_COUNT; ++i)
-    {
-        m_previousKeyboardState[i] = false;
-    }
 }
 
 void EventLoop::init()
 {
+    // Input is optional, i.e. not available in headless setups such as tests
+    if (ServiceRegistry::getInstance().hasService<InputEventQueue>())
+    {
+        m_inputQueue = ServiceRegistry::getInstance().getService<InputEventQueue>();
+    }
     m_eventLoopThread = std::thread(&EventLoop::run, this);
 }
 
@@ -31,32 +44,46 @@ void EventLoop::run()
 {
     spdlog::info("Starting event loop...");
 
+    m_threadId.store(std::this_thread::get_id());
     registerPublisher();
 
     for (auto& listener : m_listeners)
     {
         listener->onInit(*this);
     }
+    m_systemScheduler.setSystems(m_listeners);
 
-    auto lastTick = steady_clock::now();
+    updateTickRate();
+    m_scheduler.reset(steady_clock::now());
 
     while (m_stopToken->stop_requested() == false)
     {
         if (!isPaused())
         {
-            handleInputEvents();
-            handleTickEvent(lastTick);
-            handleGameEvents();
+            // Run all the due ticks, multiple if we are behind. Scheduler drops the backlog
+            // if it is beyond the max delay (e.g. after unpausing the simulation).
+            while (m_scheduler.beginTick(steady_clock::now()))
+            {
+                handleInputEvents();
+                handleTickEvent();
+                handleInboundEvents();
+                handleGameEvents();
+                m_scheduler.endTick(steady_clock::now());
+                reportTickStats();
+            }
+            m_isReady = true;
+
+            updateTickRate();
+            std::this_thread::sleep_until(m_scheduler.getNextDeadline());
         }
         else
         {
-            // If the simulation is paused, we can slow down.
+            // If the simulation is paused, we can slow down. Inputs while paused are dropped.
             std::this_thread::sleep_for(milliseconds(100));
+            discardInputEvents();
+            m_scheduler.reset(steady_clock::now());
+            m_isReady = true;
         }
-
-        // Sleep for a short duration to avoid busy-waiting
-        std::this_thread::sleep_for(milliseconds(1));
-        m_isReady = true;
     }
 
     spdlog::info("Shutting down event loop...");
@@ -71,155 +98,177 @@ void EventLoop::shutdown()
     }
 }
 
-void EventLoop::handleTickEvent(std::chrono::steady_clock::time_point& lastTime)
+void EventLoop::handleTickEvent()
 {
-    const auto tickRate = milliseconds(1000 / Constants::FIXED_FPS);
-    // Don't jump more than a fixed number of milliseconds. Useful when unpause the simulation
-    // where the actual time would be moved by a lot.
-    const auto maxDelay = milliseconds(Constants::MAX_FRAME_DELAY_MS);
-    auto now = steady_clock::now();
-    if (now - lastTime >= tickRate)
-    {
-        auto duration = now - lastTime;
-        if (duration > maxDelay)
-            duration = tickRate;
+    auto currentTick = m_currentTick.fetch_add(1, std::memory_order_relaxed) + 1;
+
+    TickData data{.deltaTimeMs = m_scheduler.getDeltaTimeMs(), .currentTick = currentTick};
+    Event tickEvent(Event::Type::TICK, data);
 
-        ++m_currentTick;
-        auto deltaMs = static_cast<int>(duration_cast<milliseconds>(duration).count());
+    // Notify listeners about the event, concurrently where their declared access allows
+    m_systemScheduler.dispatch(tickEvent);
+}
+
+void EventLoop::updateTickRate()
+{
+    // Settings might not be available in a stripped down setup such as tests
+    if (ServiceRegistry::getInstance().hasService<Settings>())
+    {
+        auto settings = ServiceRegistry::getInstance().getService<Settings>();
+        m_scheduler.setTicksPerSecond(settings->getTicksPerSecond());
+    }
+}
 
-        TickData data{.deltaTimeMs = deltaMs, .currentTick = m_currentTick};
-        Event tickEvent(Event::Type::TICK, data);
+void EventLoop::reportTickStats()
+{
+    // Roughly every 10 seconds of simulation
+    const auto reportingInterval = static_cast<size_t>(m_scheduler.getTicksPerSecond()) * 10;
 
-        // Notify listeners about the event
-        for (auto& listener : m_listeners)
+    auto& lateness = m_scheduler.getLatenessStats();
+    auto& duration = m_scheduler.getTickDurationStats();
+    if (lateness.count() == reportingInterval)
+    {
+        spdlog::debug("Tick stats (us): lateness avg {} max {}, duration avg {} max {}, "
+                      "overruns {}, dropped ticks {}",
+                      lateness.average(), lateness.max(), duration.average(), duration.max(),
+                      m_scheduler.getOverrunCount(), m_scheduler.getDroppedTickCount());
+        if (m_inputLatencyUs.count() > 0)
         {
-            bool consumed = listener->dispatchEvent(tickEvent);
-            if (consumed)
-                break;
+            spdlog::debug("Input to simulation latency (us): avg {} max {}",
+                          m_inputLatencyUs.average(), m_inputLatencyUs.max());
         }
-        lastTime = now;
+        lateness.reset();
+        duration.reset();
+        m_inputLatencyUs.reset();
     }
 }
 
 void EventLoop::handleInputEvents()
 {
-    int numEvents = 0;
-    const bool* currentKeyboardState = SDL_GetKeyboardState(&numEvents);
-    for (int i = 0; i < numEvents; ++i)
+    if (not m_inputQueue)
+        return;
+
+    // Mouse motion is coalesced to the latest position in between other inputs
+    std::optional<InputEvent> pendingMove;
+    InputEvent input;
+    while (m_inputQueue->tryPop(input))
     {
-        if (currentKeyboardState[i] && !m_previousKeyboardState[i])
+        m_inputLatencyUs.addSample((SDL_GetTicksNS() - input.timestampNs) / 1000);
+
+        if (input.type == Event::Type::MOUSE_MOVE)
         {
-            KeyboardData data{i};
-            Event keyDownEvent(Event::Type::KEY_DOWN, data);
-            for (auto& listener : m_listeners)
-            {
-                bool consumed = listener->dispatchEvent(keyDownEvent);
-                if (consumed)
-                    break;
-            }
+            pendingMove = input;
+            continue;
         }
-        if (!currentKeyboardState[i] && m_previousKeyboardState[i])
+        if (pendingMove)
         {
-            KeyboardData data{i};
-            Event keyDownEvent(Event::Type::KEY_UP, data);
-            for (auto& listener : m_listeners)
-            {
-                bool consumed = listener->dispatchEvent(keyDownEvent);
-                if (consumed)
-                    break;
-            }
+            dispatchInputEvent(pendingMove.value());
+            pendingMove.reset();
         }
-        m_previousKeyboardState[i] = currentKeyboardState[i];
+        dispatchInputEvent(input);
     }
+    if (pendingMove)
+    {
+        dispatchInputEvent(pendingMove.value());
+    }
+}
 
-    float mouseX = 0;
-    float mouseY = 0;
-    SDL_MouseButtonFlags currentMouseState = SDL_GetMouseState(&mouseX, &mouseY);
-
-    if (m_previouseMouseX != mouseX || m_previouseMouseY != mouseY)
+void EventLoop::dispatchInputEvent(const InputEvent& input)
+{
+    Event::Data data;
+    switch (input.type)
     {
-        MouseMoveData data{Vec2(mouseX, mouseY)};
-        Event mouseMoveEvent(Event::Type::MOUSE_MOVE, data);
-        for (auto& listener : m_listeners)
-        {
-            bool consumed = listener->dispatchEvent(mouseMoveEvent);
-            if (consumed)
-                break;
-        }
-        m_previouseMouseX = mouseX;
-        m_previouseMouseY = mouseY;
+    case Event::Type::KEY_DOWN:
+    case Event::Type::KEY_UP:
+        data = KeyboardData{input.keyCode};
+        break;
+    case Event::Type::MOUSE_MOVE:
+        data = MouseMoveData{input.screenPos};
+        break;
+    case Event::Type::MOUSE_BTN_DOWN:
+    case Event::Type::MOUSE_BTN_UP:
+        data = MouseClickData{input.button, input.screenPos};
+        break;
+    default:
+        spdlog::warn("Unexpected input event type {}", toInt(input.type));
+        return;
     }
 
-    if (currentMouseState != m_previousMouseState)
+    Event event(input.type, std::move(data));
+    for (auto& listener : m_listeners)
     {
-        if ((currentMouseState & SDL_BUTTON_LMASK) && !(m_previousMouseState & SDL_BUTTON_LMASK))
-        {
-            MouseClickData data{MouseClickData::Button::LEFT, Vec2(mouseX, mouseY)};
-            Event mouseClickEvent(Event::Type::MOUSE_BTN_DOWN, data);
-            for (auto& listener : m_listeners)
-            {
-                bool consumed = listener->dispatchEvent(mouseClickEvent);
-                if (consumed)
-                    break;
-            }
-        }
+        bool consumed = listener->dispatchEvent(event);
+        if (consumed)
+            break;
+    }
+}
 
-        if (!(currentMouseState & SDL_BUTTON_LMASK) && (m_previousMouseState & SDL_BUTTON_LMASK))
-        {
-            MouseClickData data{MouseClickData::Button::LEFT, Vec2(mouseX, mouseY)};
-            Event mouseClickEvent(Event::Type::MOUSE_BTN_UP, data);
-            for (auto& listener : m_listeners)
-            {
-                bool consumed = listener->dispatchEvent(mouseClickEvent);
-                if (consumed)
-                    break;
-            }
-        }
+void EventLoop::discardInputEvents()
+{
+    if (not m_inputQueue)
+        return;
 
-        if ((currentMouseState & SDL_BUTTON_RMASK) && !(m_previousMouseState & SDL_BUTTON_RMASK))
-        {
-            MouseClickData data{MouseClickData::Button::RIGHT, Vec2(mouseX, mouseY)};
-            Event mouseClickEvent(Event::Type::MOUSE_BTN_DOWN, data);
-            for (auto& listener : m_listeners)
-            {
-                bool consumed = listener->dispatchEvent(mouseClickEvent);
-                if (consumed)
-                    break;
-            }
-        }
-        if (!(currentMouseState & SDL_BUTTON_RMASK) && (m_previousMouseState & SDL_BUTTON_RMASK))
-        {
-            MouseClickData data{MouseClickData::Button::RIGHT, Vec2(mouseX, mouseY)};
-            Event mouseClickEvent(Event::Type::MOUSE_BTN_UP, data);
-            for (auto& listener : m_listeners)
-            {
-                bool consumed = listener->dispatchEvent(mouseClickEvent);
-                if (consumed)
-                    break;
-            }
-        }
-        m_previousMouseState = currentMouseState;
+    InputEvent input;
+    while (m_inputQueue->tryPop(input))
+    {
     }
 }
 
 void EventLoop::handleGameEvents()
 {
-    while (!m_eventQueue.empty())
+    m_eventQueue.drain([this](Event::Type type, std::span<const Event> events)
+                       { dispatchEvents(type, events); });
+}
+
+void EventLoop::dispatchEvents(Event::Type type, std::span<const Event> events)
+{
+    m_consumedEvents.assign(events.size(), false);
+    for (auto& listener : m_listeners)
     {
-        auto& event = m_eventQueue.front();
-        for (auto& listener : m_listeners)
-        {
-            bool consumed = listener->dispatchEvent(event);
-            if (consumed)
-                break;
-        }
-        m_eventQueue.pop();
+        listener->dispatchEvents(type, events, m_consumedEvents);
     }
 }
 
+void EventLoop::handleInboundEvents()
+{
+    m_inbox.drain([this](const Event& event) { m_eventQueue.push(event); });
+}
+
 void EventLoop::publish(const Event& event)
 {
-    m_eventQueue.push(event);
+    if (std::this_thread::get_id() == m_threadId.load(std::memory_order_relaxed)) [[likely]]
+    {
+        m_eventQueue.push(event);
+        return;
+    }
+
+    if (t_producerInbox != &m_inbox)
+    {
+        t_producer = &m_inbox.acquireProducer(t_producerKey);
+        t_producerInbox = &m_inbox;
+    }
+    t_producer->publish(event, m_currentTick.load(std::memory_order_relaxed));
+}
+
+void EventLoop::attachThread(uint32_t producerKey)
+{
+    registerPublisher();
+    if (t_producerInbox == &m_inbox and t_producer->getKey() != producerKey)
+    {
+        detachThread();
+    }
+    t_producerKey = producerKey;
+}
+
+void EventLoop::detachThread()
+{
+    if (t_producerInbox == &m_inbox)
+    {
+        m_inbox.releaseProducer(*t_producer);
+        t_producer = nullptr;
+        t_producerInbox = nullptr;
+    }
+    t_producerKey = std::numeric_limits<uint32_t>::max();
 }
 
 void EventLoop::registerListener(std::shared_ptr<EventHandler> listener)
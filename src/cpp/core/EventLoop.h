@@ -2,12 +2,18 @@
 #define EVENTLOOP_H
 
 #include "Event.h"
+#include "EventInbox.h"
 #include "EventPublisher.h"
+#include "EventQueue.h"
+#include "FixedStepScheduler.h"
+#include "InputEventQueue.h"
+#include "StatsCounter.h"
 #include "SubSystem.h"
+#include "SystemScheduler.h"
 
+#include <atomic>
 #include <list>
 #include <memory>
-#include <queue>
 #include <thread>
 
 namespace core
@@ -39,6 +45,14 @@ class EventLoop : public SubSystem, public EventPublisher
         s_isPaused = isPaused;
     }
 
+    // Let publishEvent() work on the calling thread (e.g. a worker). Events published
+    // from threads other than the event loop are delivered through the inbox, ordered by
+    // the given key within a tick (see EventInbox). Hence the key should be stable, e.g.
+    // the index of the worker.
+    void attachThread(uint32_t producerKey);
+    // Must be called before an attached thread exits, to free its inbox slot
+    void detachThread();
+
   private:
     // SubSystem methods
     void init() override;
@@ -47,24 +61,33 @@ class EventLoop : public SubSystem, public EventPublisher
     void publish(const Event& event) override;
 
     void run();
-    void handleTickEvent(std::chrono::steady_clock::time_point& lastTime);
+    void handleTickEvent();
+    void updateTickRate();
+    void reportTickStats();
     void handleInputEvents();
+    void dispatchInputEvent(const InputEvent& input);
+    void discardInputEvents();
     void handleGameEvents();
+    void handleInboundEvents();
+    void dispatchEvents(Event::Type type, std::span<const Event> events);
 
   private:
     std::list<std::shared_ptr<EventHandler>> m_listeners;
     std::thread m_eventLoopThread;
-    std::queue<Event> m_eventQueue;
+    FixedStepScheduler m_scheduler;
+    SystemScheduler m_systemScheduler;
+    EventQueue m_eventQueue;
+    EventInbox m_inbox;
+    std::atomic<std::thread::id> m_threadId;
+    std::vector<uint8_t> m_consumedEvents;
 
-    bool* m_previousKeyboardState = nullptr;
-    uint32_t m_previousMouseState = 0;
-    int m_previouseMouseX = 0;
-    int m_previouseMouseY = 0;
+    Ref<InputEventQueue> m_inputQueue;
+    StatsCounter<uint64_t> m_inputLatencyUs;
 
     static bool s_isPaused;
     bool m_isReady = false;
 
-    int m_currentTick = 0;
+    std::atomic<int> m_currentTick = 0;
 };
 
 } // namespace core
@@ -1,5 +1,7 @@
 #include "EventPublisher.h"
 
+#include <utility>
+
 namespace core
 {
 thread_local Ref<EventPublisher> EventPublisher::s_instance;
@@ -18,4 +20,9 @@ void EventPublisher::registerPublisher()
 {
     s_instance = shared_from_this();
 }
+
+Ref<EventPublisher> EventPublisher::exchangePublisher(Ref<EventPublisher> publisher)
+{
+    return std::exchange(s_instance, std::move(publisher));
+}
 } // namespace core
@@ -16,6 +16,8 @@ class EventPublisher : public std::enable_shared_from_this<EventPublisher>
 
   protected:
     void registerPublisher();
+    // Replace the publisher of the current thread, returns the previous one
+    static Ref<EventPublisher> exchangePublisher(Ref<EventPublisher> publisher);
 
   private:
     friend void publishEvent(const Event& event);
@@ -0,0 +1,102 @@
+#ifndef CORE_EVENTQUEUE_H
+#define CORE_EVENTQUEUE_H
+
+#include "Event.h"
+
+#include <array>
+#include <span>
+#include <vector>
+
+namespace core
+{
+/*
+ *   Per-tick game event queue. Events are stored in a pool per event type, so that
+ *   consecutive events of the same type can be handed to the listeners as one
+ *   contiguous span.
+ *
+ *   Approach:
+ *   Each event type owns a vector that is only cleared (never shrunk) after a
+ *   drain. Once the pools have grown to the typical per-tick volume, publishing
+ *   an event is a plain copy into already reserved storage. Publishing order is
+ *   recorded as runs of (type, offset into the pool of that type, count), where a
+ *   run grows as long as the same type is published back to back.
+ *
+ *   Ordering: The queue is FIFO across types, i.e. runs are drained in the order
+ *   they were published. Interleaved types hence split into several batches (e.g.
+ *   MOVE, MOVE, DELETE, MOVE is delivered as [MOVE, MOVE], [DELETE], [MOVE]).
+ *   Events published while draining (i.e. from within a listener) go to the next
+ *   pass, hence follow-up events are always delivered after their cause.
+ */
+class EventQueue
+{
+  public:
+    static constexpr size_t MAX_EVENT_TYPES = static_cast<size_t>(Event::Type::MAX_EVENT_TYPES);
+
+    void push(const Event& event)
+    {
+        auto& pool = m_pending[static_cast<size_t>(event.type)];
+        if (m_pendingRuns.empty() or m_pendingRuns.back().type != event.type)
+        {
+            m_pendingRuns.push_back(Run{event.type, pool.size(), 0});
+        }
+        pool.push_back(event);
+        ++m_pendingRuns.back().count;
+        ++m_pendingCount;
+    }
+
+    bool empty() const
+    {
+        return m_pendingCount == 0;
+    }
+
+    size_t size() const
+    {
+        return m_pendingCount;
+    }
+
+    /*
+     *   Deliver all pending events, including the ones published during the
+     *   drain, in order as batches of consecutive events of the same type. The
+     *   callable is invoked as
+     *   fn(Event::Type, std::span<const Event>).
+     */
+    template <typename Fn> void drain(Fn&& fn)
+    {
+        while (m_pendingCount != 0)
+        {
+            m_dispatching.swap(m_pending);
+            m_dispatchingRuns.swap(m_pendingRuns);
+            m_pendingCount = 0;
+
+            for (const auto& run : m_dispatchingRuns)
+            {
+                auto& pool = m_dispatching[static_cast<size_t>(run.type)];
+                fn(run.type, std::span<const Event>(pool.data() + run.offset, run.count));
+            }
+            for (const auto& run : m_dispatchingRuns)
+            {
+                m_dispatching[static_cast<size_t>(run.type)].clear();
+            }
+            m_dispatchingRuns.clear();
+        }
+    }
+
+  private:
+    using EventPool = std::vector<Event>;
+
+    struct Run
+    {
+        Event::Type type = Event::Type::NONE;
+        size_t offset = 0;
+        size_t count = 0;
+    };
+
+    std::array<EventPool, MAX_EVENT_TYPES> m_pending;
+    std::array<EventPool, MAX_EVENT_TYPES> m_dispatching;
+    std::vector<Run> m_pendingRuns;
+    std::vector<Run> m_dispatchingRuns;
+    size_t m_pendingCount = 0;
+};
+} // namespace core
+
+#endif // CORE_EVENTQUEUE_H
@@ -0,0 +1,163 @@
+#ifndef CORE_FIXEDSTEPSCHEDULER_H
+#define CORE_FIXEDSTEPSCHEDULER_H
+
+#include "StatsCounter.h"
+
+#include <chrono>
+#include <cstdint>
+
+namespace core
+{
+/*
+ *   Fixed time step scheduler for the simulation thread.
+ *
+ *   Approach:
+ *   Tick deadlines are derived from an anchor time point and the tick index since
+ *   the anchor (i.e. anchor + n * 1s / tps) rather than accumulating a rounded
+ *   step. Hence there is no drift even if a step is not a whole number of
+ *   milliseconds (e.g. 16.67ms at 60 tps). Each tick's deltaTimeMs is the
+ *   difference of consecutive rounded deadlines, alternating between 16 and 17
+ *   at 60 tps so that the simulated time sums up exactly.
+ *
+ *   When the caller falls behind, due ticks are run back to back (catch-up). If
+ *   the backlog exceeds the maximum delay (e.g. after a pause or a long stall),
+ *   the backlog is dropped and the schedule is re-anchored to the current time.
+ *
+ *   Time is always passed in by the caller to keep this deterministic and testable.
+ */
+class FixedStepScheduler
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    FixedStepScheduler(int ticksPerSecond, std::chrono::milliseconds maxDelay)
+        : m_ticksPerSecond(ticksPerSecond), m_maxDelay(maxDelay)
+    {
+    }
+
+    // Restart the schedule such that the first tick is due right away.
+    void reset(Clock::time_point now)
+    {
+        m_anchor = now;
+        m_ticksSinceAnchor = 0;
+        m_tickStart = now;
+    }
+
+    // Change the rate without a jump. Schedule continues from the next deadline.
+    void setTicksPerSecond(int ticksPerSecond)
+    {
+        if (ticksPerSecond <= 0 or ticksPerSecond == m_ticksPerSecond)
+            return;
+
+        m_anchor = getNextDeadline();
+        m_ticksSinceAnchor = 0;
+        m_ticksPerSecond = ticksPerSecond;
+    }
+
+    int getTicksPerSecond() const
+    {
+        return m_ticksPerSecond;
+    }
+
+    Clock::time_point getNextDeadline() const
+    {
+        return m_anchor + offsetOf(m_ticksSinceAnchor);
+    }
+
+    /*
+     *   Returns true if a tick is due at 'now' and starts it. Must be followed by
+     *   endTick() once the tick is processed. Call repeatedly to catch up.
+     */
+    bool beginTick(Clock::time_point now)
+    {
+        auto deadline = getNextDeadline();
+        if (now < deadline)
+            return false;
+
+        if (now - deadline > m_maxDelay)
+        {
+            // Too far behind, running all the missed ticks would only make it worse.
+            auto step = offsetOf(1);
+            m_droppedTicks += static_cast<uint64_t>((now - deadline) / step);
+            m_anchor = now;
+            m_ticksSinceAnchor = 0;
+            deadline = now;
+        }
+
+        m_lateness.addSample(
+            std::chrono::duration_cast<std::chrono::microseconds>(now - deadline).count());
+        m_deltaTimeMs = static_cast<int>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(offsetOf(m_ticksSinceAnchor + 1))
+                .count() -
+            std::chrono::duration_cast<std::chrono::milliseconds>(offsetOf(m_ticksSinceAnchor))
+                .count());
+        ++m_ticksSinceAnchor;
+        m_tickStart = now;
+        return true;
+    }
+
+    void endTick(Clock::time_point now)
+    {
+        auto duration = now - m_tickStart;
+        m_tickDuration.addSample(
+            std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+        if (duration > offsetOf(1))
+        {
+            ++m_overruns;
+        }
+    }
+
+    // Simulated time of the last begun tick
+    int getDeltaTimeMs() const
+    {
+        return m_deltaTimeMs;
+    }
+
+    // Microseconds between a tick's deadline and its actual start
+    StatsCounter<int64_t>& getLatenessStats()
+    {
+        return m_lateness;
+    }
+
+    // Microseconds spent processing a tick
+    StatsCounter<int64_t>& getTickDurationStats()
+    {
+        return m_tickDuration;
+    }
+
+    // Number of ticks took longer than a step to process
+    uint64_t getOverrunCount() const
+    {
+        return m_overruns;
+    }
+
+    // Number of ticks skipped since the maximum delay was exceeded
+    uint64_t getDroppedTickCount() const
+    {
+        return m_droppedTicks;
+    }
+
+  private:
+    Clock::duration offsetOf(int64_t ticks) const
+    {
+        using namespace std::chrono;
+        return duration_cast<Clock::duration>(nanoseconds(ticks * 1'000'000'000LL) /
+                                              m_ticksPerSecond);
+    }
+
+  private:
+    int m_ticksPerSecond = 0;
+    std::chrono::milliseconds m_maxDelay;
+    Clock::time_point m_anchor;
+    Clock::time_point m_tickStart;
+    int64_t m_ticksSinceAnchor = 0;
+    int m_deltaTimeMs = 0;
+
+    StatsCounter<int64_t> m_lateness;
+    StatsCounter<int64_t> m_tickDuration;
+    uint64_t m_overruns = 0;
+    uint64_t m_droppedTicks = 0;
+};
+} // namespace core
+
+#endif // CORE_FIXEDSTEPSCHEDULER_H
@@ -2,22 +2,32 @@
 
 #include "Feet.h"
 #include "StateManager.h"
+#include "TeamVision.h"
 #include "Tile.h"
 #include "components/CompEntityInfo.h"
+#include "debug.h"
 #include "utils/Size.h"
 
+#include <array>
+#include <bit>
+
 using namespace core;
 
 void FogOfWar::init(uint32_t width, uint32_t height, RevealStatus initialFill)
 {
-    m_map = Flat2DArray<RevealStatus>(width, height, initialFill);
+    m_width = width;
+    m_height = height;
+    m_wordsPerRow = (m_width + TILES_PER_WORD - 1) / TILES_PER_WORD;
+    m_words.assign(size_t(m_wordsPerRow) * m_height, toBits(initialFill));
+    m_changedRows.assign((m_height + 63) / 64, ~uint64_t(0));
+    m_syncedTeamId = 0;
 }
 
 void FogOfWar::markAsExplored(const Tile& tilePos)
 {
-    if (tilePos.x >= 0 && tilePos.x < m_map.width() && tilePos.y >= 0 && tilePos.y < m_map.height())
+    if (isValidPos(tilePos))
     {
-        m_map.at(tilePos.x, tilePos.y) = RevealStatus::EXPLORED;
+        fillRow(tilePos.y, tilePos.x, tilePos.x, EXPLORED_BITS);
     }
 }
 
@@ -28,17 +38,19 @@ void FogOfWar::markAsExplored(const Feet& feetPos)
 
 void FogOfWar::markAsExplored(const Feet& feetPos, uint32_t lineOfSight)
 {
-    markRadius(feetPos.toTile(), lineOfSight / Constants::FEET_PER_TILE, RevealStatus::EXPLORED);
+    stamp(feetPos.toTile(), lineOfSight / Constants::FEET_PER_TILE, EXPLORED_BITS);
 }
 
 void FogOfWar::markAsExplored(const LandArea& landArea, uint32_t lineOfSight)
 {
-    markRadius(landArea, lineOfSight / Constants::FEET_PER_TILE, RevealStatus::EXPLORED);
+    forEachSpanInRadius(landArea, lineOfSight / Constants::FEET_PER_TILE, Size(m_width, m_height),
+                        [this](int32_t y, int32_t minX, int32_t maxX)
+                        { fillRow(y, minX, maxX, EXPLORED_BITS); });
 }
 
 void FogOfWar::markAsVisible(const Tile& tilePos, uint32_t lineOfSight)
 {
-    markRadius(tilePos, lineOfSight / Constants::FEET_PER_TILE, RevealStatus::VISIBLE);
+    stamp(tilePos, lineOfSight / Constants::FEET_PER_TILE, VISIBLE_BITS);
 }
 
 void FogOfWar::markAsVisible(const Feet& feetPos, uint32_t lineOfSight)
@@ -47,29 +59,201 @@ void FogOfWar::markAsVisible(const Feet& feetPos, uint32_t lineOfSight)
     markAsVisible(tilePos, lineOfSight);
 }
 
-void FogOfWar::markRadius(const Tile& tile, uint8_t lineOfSight, RevealStatus type)
+void FogOfWar::syncVisibility(const TeamVision& team)
+{
+    debug_assert(team.getWidth() == m_width and team.getHeight() == m_height,
+                 "Team vision is sized differently from the fog of war");
+
+    const bool full = team.getId() != m_syncedTeamId;
+    for (int32_t y = 0; y < m_height; ++y)
+    {
+        if (not full and team.getRowVersion(y) <= m_syncedVersion)
+            continue;
+
+        const auto teamRow = team.getRow(y);
+        Word* row = m_words.data() + size_t(y) * m_wordsPerRow;
+        bool changed = false;
+        for (int32_t i = 0; i < m_wordsPerRow; ++i)
+        {
+            const Word word = (row[i] & EXPLORED_BITS) | teamRow[i];
+            changed |= word != row[i];
+            row[i] = word;
+        }
+        if (changed)
+            markRowChanged(y);
+    }
+    m_syncedTeamId = team.getId();
+    m_syncedVersion = team.getVersion();
+}
+
+void FogOfWar::takeDelta(Delta& delta, bool full)
 {
-    markRadius(tile, lineOfSight, m_map.dimensions(),
-               [&](const Tile& t) { setRevealStatus(t, type); });
+    delta.clear();
+    delta.width = m_width;
+    delta.height = m_height;
+
+    for (size_t i = 0; i < m_changedRows.size(); ++i)
+    {
+        auto changed = full ? ~uint64_t(0) : m_changedRows[i];
+        m_changedRows[i] = 0;
+
+        while (changed)
+        {
+            const auto y = int32_t(i * 64 + std::countr_zero(changed));
+            changed &= changed - 1;
+            if (y >= m_height)
+                break;
+
+            const auto row = m_words.begin() + size_t(y) * m_wordsPerRow;
+            delta.rows.push_back(y);
+            delta.words.insert(delta.words.end(), row, row + m_wordsPerRow);
+        }
+    }
 }
 
-void FogOfWar::markRadius(const LandArea& landArea, uint8_t lineOfSight, RevealStatus type)
+void FogOfWar::applyDelta(const Delta& delta)
 {
-    markRadius(landArea, lineOfSight, m_map.dimensions(),
-               [&](const Tile& t) { setRevealStatus(t, type); });
+    if (delta.width != m_width or delta.height != m_height)
+    {
+        // Only the reveal status is kept for a copy, without sight counts
+        m_width = delta.width;
+        m_height = delta.height;
+        m_wordsPerRow = (m_width + TILES_PER_WORD - 1) / TILES_PER_WORD;
+        m_words.assign(size_t(m_wordsPerRow) * m_height, 0);
+    }
+
+    for (size_t i = 0; i < delta.rows.size(); ++i)
+    {
+        std::copy_n(delta.words.begin() + i * m_wordsPerRow, m_wordsPerRow,
+                    m_words.begin() + size_t(delta.rows[i]) * m_wordsPerRow);
+    }
 }
 
 RevealStatus FogOfWar::getRevealStatus(const Tile& tilePos) const
 {
-    return m_map.at(tilePos.x, tilePos.y);
+    debug_assert(isValidPos(tilePos), "Tile ({}, {}) is outside the map", tilePos.x, tilePos.y);
+    const auto word = m_words[tilePos.y * m_wordsPerRow + tilePos.x / TILES_PER_WORD];
+    const auto bits = (word >> (tilePos.x % TILES_PER_WORD * 2)) & 0b11;
+
+    if (bits & 0b10)
+        return RevealStatus::VISIBLE;
+    return bits ? RevealStatus::EXPLORED : RevealStatus::UNEXPLORED;
 }
 
 void FogOfWar::setRevealStatus(const Tile& tilePos, RevealStatus type)
 {
-    m_map.at(tilePos.x, tilePos.y) = type;
+    debug_assert(isValidPos(tilePos), "Tile ({}, {}) is outside the map", tilePos.x, tilePos.y);
+    auto& word = m_words[tilePos.y * m_wordsPerRow + tilePos.x / TILES_PER_WORD];
+    const auto shift = tilePos.x % TILES_PER_WORD * 2;
+
+    word &= ~(Word(0b11) << shift);
+    word |= toBits(type) & (Word(0b11) << shift);
+    markRowChanged(tilePos.y);
 }
 
 bool FogOfWar::isExplored(const Tile& tile) const
 {
-    return m_map.at(tile.x, tile.y) == RevealStatus::EXPLORED;
-}
\ No newline at end of file
+    return getRevealStatus(tile) != RevealStatus::UNEXPLORED;
+}
+
+std::span<const uint8_t> FogOfWar::getCircleSpans(uint8_t radiusInTiles)
+{
+    // Built once for all the radii, around 32KB
+    static const auto spansByRadius = []
+    {
+        std::array<std::vector<uint8_t>, 256> spans;
+        for (int radius = 0; radius < int(spans.size()); ++radius)
+        {
+            auto& halfWidths = spans[radius];
+            halfWidths.resize(radius + 1);
+
+            // Tiles within the radius from the center, i.e. dx*dx + dy*dy <= radius*radius
+            int halfWidth = radius;
+            for (int dy = 0; dy <= radius; ++dy)
+            {
+                while (halfWidth * halfWidth + dy * dy > radius * radius)
+                    --halfWidth;
+                halfWidths[dy] = uint8_t(halfWidth);
+            }
+        }
+        return spans;
+    }();
+    return spansByRadius[radiusInTiles];
+}
+
+FogOfWar::Word FogOfWar::toBits(RevealStatus status)
+{
+    switch (status)
+    {
+    case RevealStatus::EXPLORED:
+        return EXPLORED_BITS;
+    case RevealStatus::VISIBLE:
+        return VISIBLE_BITS;
+    default:
+        return 0;
+    }
+}
+
+bool FogOfWar::isValidPos(const Tile& tile) const
+{
+    return tile.x >= 0 and tile.x < m_width and tile.y >= 0 and tile.y < m_height;
+}
+
+void FogOfWar::stamp(const Tile& center, uint8_t radiusInTiles, Word bits)
+{
+    const auto halfWidths = getCircleSpans(radiusInTiles);
+    const int32_t radius = radiusInTiles;
+
+    for (int32_t dy = -radius; dy <= radius; ++dy)
+    {
+        const int32_t y = center.y + dy;
+        if (y < 0 or y >= m_height)
+            continue;
+
+        const int32_t halfWidth = halfWidths[std::abs(dy)];
+        const int32_t minX = std::max(0, center.x - halfWidth);
+        const int32_t maxX = std::min(m_width - 1, center.x + halfWidth);
+        if (minX <= maxX)
+            fillRow(y, minX, maxX, bits);
+    }
+}
+
+// ORs the bits to the tiles from minX to maxX (inclusive) of the row
+void FogOfWar::fillRow(int32_t y, int32_t minX, int32_t maxX, Word bits)
+{
+    Word* row = m_words.data() + size_t(y) * m_wordsPerRow;
+    const int32_t first = minX / TILES_PER_WORD;
+    const int32_t last = maxX / TILES_PER_WORD;
+    const Word firstMask = ~Word(0) << (minX % TILES_PER_WORD * 2);
+    const Word lastMask = ~Word(0) >> ((TILES_PER_WORD - 1 - maxX % TILES_PER_WORD) * 2);
+
+    // Revealing again what is already revealed (e.g. the explored tiles) isn't a change
+    Word added = 0;
+    auto orWord = [&](Word& word, Word mask)
+    {
+        added |= (bits & mask) & ~word;
+        word |= bits & mask;
+    };
+
+    if (first == last)
+    {
+        orWord(row[first], firstMask & lastMask);
+    }
+    else
+    {
+        orWord(row[first], firstMask);
+        for (int32_t i = first + 1; i < last; ++i)
+        {
+            orWord(row[i], ~Word(0));
+        }
+        orWord(row[last], lastMask);
+    }
+
+    if (added)
+        markRowChanged(y);
+}
+
+void FogOfWar::markRowChanged(int32_t y)
+{
+    m_changedRows[y / 64] |= uint64_t(1) << (y % 64);
+}
@@ -1,11 +1,15 @@
 #ifndef FOGOFWAR_H
 #define FOGOFWAR_H
 
-#include "Flat2DArray.h"
 #include "components/CompBuilding.h"
 #include "utils/Types.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <span>
+#include <utility>
 #include <vector>
 
 namespace core
@@ -13,10 +17,58 @@ namespace core
 class Feet;
 class Tile;
 class Size;
-
+class TeamVision;
+
+/*
+ *   Per player reveal status of the tiles, packed to two bits per tile. Low bit of a tile
+ *   is set once explored and the high bit while visible. A visible tile is explored as
+ *   well, hence revealing never downgrades a tile and stamping a line of sight is a plain
+ *   OR. Rows are padded to whole words, so a row of a stamp is a few word wide ORs.
+ *
+ *   Circles are stamped row by row using the precomputed half widths of their rows.
+ *
+ *   Live sight of the entities is counted per team rather than here (see TeamVision). The
+ *   visible tiles are synced from the team of the player once per frame before sending it to
+ *   the renderer (see GraphicsInstructor), and decay back to explored once the team stops
+ *   seeing them. markAsVisible reveals without counting, until the row is synced again after
+ *   a change in the team's sight.
+ *
+ *   Changed rows are recorded, so that a copy (i.e. the renderer's) is kept up to date
+ *   by shipping only those rows.
+ */
 class FogOfWar
 {
   public:
+    using Word = uint64_t;
+    static constexpr int32_t TILES_PER_WORD = sizeof(Word) * 8 / 2;
+    static constexpr Word EXPLORED_BITS = 0x5555555555555555;
+    static constexpr Word VISIBLE_BITS = ~Word(0); // Visible implies explored
+
+    // Rows changed since the last delta, with their whole content
+    struct Delta
+    {
+        int32_t width = 0;
+        int32_t height = 0;
+        std::vector<int32_t> rows;
+        std::vector<uint64_t> words; // Words of the rows above, one row after another
+
+        void clear()
+        {
+            rows.clear();
+            words.clear();
+        }
+
+        // Rows of the older delta go first, so that the newer ones win when applied
+        void mergeOlder(const Delta& older)
+        {
+            if (older.width != width or older.height != height)
+                return; // Of another fog of war, hence this one is full already
+
+            rows.insert(rows.begin(), older.rows.begin(), older.rows.end());
+            words.insert(words.begin(), older.words.begin(), older.words.end());
+        }
+    };
+
     void init(uint32_t width, uint32_t height, RevealStatus initialFill);
     void markAsExplored(const Tile& pos);
     void markAsExplored(const Feet& pos);
@@ -25,127 +77,160 @@ class FogOfWar
     void markAsVisible(const Tile& pos, uint32_t lineOfSight);
     void markAsVisible(const Feet& pos, uint32_t lineOfSight);
 
+    // Takes in the rows of the team's sight changed since the last sync, all of them if
+    // the team is a different one (by id). Explored tiles stay explored.
+    void syncVisibility(const TeamVision& team);
+
+    // Moves the changed rows (or all the rows if full) to the delta, i.e. clears them
+    void takeDelta(Delta& delta, bool full);
+    // Delta of another fog of war, applying the same delta again has no effect
+    void applyDelta(const Delta& delta);
+
+    // NONE is stored as UNEXPLORED
     void setRevealStatus(const Tile& tilePos, RevealStatus type);
     RevealStatus getRevealStatus(const Tile& tilePos) const;
+    // Visible tiles are explored too
     bool isExplored(const Tile& tile) const;
 
+    size_t getMemoryUsage() const
+    {
+        return m_words.size() * sizeof(Word);
+    }
+
+    // Half widths of the rows of a circle of tiles, indexed by the distance to the center row
+    static std::span<const uint8_t> getCircleSpans(uint8_t radiusInTiles);
+
     template <typename Callback>
     static void markRadius(const Tile& tile,
                            uint8_t lineOfSightInTiles,
                            const Size& tileMapSize,
                            Callback cb)
     {
-        const int32_t minX =
-            std::max<int32_t>(0, static_cast<int32_t>(tile.x) - lineOfSightInTiles);
-        const int32_t maxX = std::min<uint32_t>(tileMapSize.width - 1, tile.x + lineOfSightInTiles);
-        const int32_t minY =
-            std::max<int32_t>(0, static_cast<int32_t>(tile.y) - lineOfSightInTiles);
-        const int32_t maxY =
-            std::min<uint32_t>(tileMapSize.height - 1, tile.y + lineOfSightInTiles);
-
-        const uint32_t radiusSq = lineOfSightInTiles * lineOfSightInTiles;
+        const auto halfWidths = getCircleSpans(lineOfSightInTiles);
+        const int32_t radius = lineOfSightInTiles;
 
-        for (int32_t x = minX; x <= maxX; ++x)
+        for (int32_t dy = -radius; dy <= radius; ++dy)
         {
-            for (int32_t y = minY; y <= maxY; ++y)
+            const int32_t y = tile.y + dy;
+            if (y < 0 or y >= tileMapSize.height)
+                continue;
+
+            const int32_t halfWidth = halfWidths[std::abs(dy)];
+            const int32_t minX = std::max(0, tile.x - halfWidth);
+            const int32_t maxX = std::min(tileMapSize.width - 1, tile.x + halfWidth);
+            for (int32_t x = minX; x <= maxX; ++x)
             {
-                uint32_t dx = x - tile.x;
-                uint32_t dy = y - tile.y;
-                if (dx * dx + dy * dy <= radiusSq)
-                {
-                    cb(Tile(x, y));
-                }
+                cb(Tile(x, y));
             }
         }
     }
 
-    // Approach:
-    // 1. If area.tiles is empty, return early.
-    // 2. Compute the bounding box of the LandArea by iterating its tiles to find minX, maxX, minY,
-    // maxY.
-    // 3. Expand that bounding box by lineOfSight, then clamp to map bounds to get iteration ranges.
-    // 4. Precompute radiusSq = lineOfSight * lineOfSight.
-    // 5. For each candidate tile (x,y) in the clamped box:
-    //      - Find the minimum squared distance from (x,y) to any tile coordinate in area.tiles.
-    //        (Distance computed as (x - tile.x)^2 + (y - tile.y)^2).
-    //      - If the minimum squared distance <= radiusSq, call setRevealStatus(Tile(x,y), type).
-    //    Break out of the inner loop early when a distance <= radiusSq is found to avoid extra
-    //    work.
-    // 6. Use safe integer types (int64_t for squared computations) to avoid overflow for larger
-    // maps.
     template <typename Callback>
     static void markRadius(const LandArea& landArea,
                            uint8_t lineOfSightInTiles,
                            const Size& tileMapSize,
                            Callback cb)
+    {
+        forEachSpanInRadius(landArea, lineOfSightInTiles, tileMapSize,
+                            [&cb](int32_t y, int32_t minX, int32_t maxX)
+                            {
+                                for (int32_t x = minX; x <= maxX; ++x)
+                                {
+                                    cb(Tile(x, y));
+                                }
+                            });
+    }
+
+    // Calls cb(y, minX, maxX) for the row spans of the tiles within the radius of any tile of
+    // the land area (i.e. the area grown by a circle), clamped to the map. Spans don't overlap.
+    //
+    // A rectangular area (i.e. a building) grows into a rounded rectangle, where the width of
+    // a row is the one of the circle row at the distance to the closest row of the area. Hence
+    // it is read off the cached circle spans directly. Other shapes (e.g. diagonal walls) merge
+    // the circle spans of their tiles per row.
+    template <typename Callback>
+    static void forEachSpanInRadius(const LandArea& landArea,
+                                    uint8_t lineOfSightInTiles,
+                                    const Size& tileMapSize,
+                                    Callback cb)
     {
         if (landArea.tiles.empty())
-        {
             return;
-        }
 
-        // Compute bounding box of the area
         int32_t areaMinX = std::numeric_limits<int32_t>::max();
         int32_t areaMaxX = std::numeric_limits<int32_t>::min();
         int32_t areaMinY = std::numeric_limits<int32_t>::max();
         int32_t areaMaxY = std::numeric_limits<int32_t>::min();
-
-        for (const auto& t : landArea.tiles)
+        for (const auto& tile : landArea.tiles)
         {
-            areaMinX = std::min(areaMinX, static_cast<int32_t>(t.x));
-            areaMaxX = std::max(areaMaxX, static_cast<int32_t>(t.x));
-            areaMinY = std::min(areaMinY, static_cast<int32_t>(t.y));
-            areaMaxY = std::max(areaMaxY, static_cast<int32_t>(t.y));
+            areaMinX = std::min(areaMinX, tile.x);
+            areaMaxX = std::max(areaMaxX, tile.x);
+            areaMinY = std::min(areaMinY, tile.y);
+            areaMaxY = std::max(areaMaxY, tile.y);
         }
 
-        // Expand by lineOfSightInTiles and clamp to map bounds
-        int32_t minX = std::max<int32_t>(0, areaMinX - static_cast<int32_t>(lineOfSightInTiles));
-        int32_t maxX = std::min<int32_t>(static_cast<int32_t>(tileMapSize.width) - 1,
-                                         areaMaxX + static_cast<int32_t>(lineOfSightInTiles));
-        int32_t minY = std::max<int32_t>(0, areaMinY - static_cast<int32_t>(lineOfSightInTiles));
-        int32_t maxY = std::min<int32_t>(static_cast<int32_t>(tileMapSize.height) - 1,
-                                         areaMaxY + static_cast<int32_t>(lineOfSightInTiles));
+        const auto halfWidths = getCircleSpans(lineOfSightInTiles);
+        const int32_t radius = lineOfSightInTiles;
+        const bool isRectangle =
+            landArea.tiles.size() == size_t(areaMaxX - areaMinX + 1) * (areaMaxY - areaMinY + 1);
 
-        const int64_t radiusSq =
-            static_cast<int64_t>(lineOfSightInTiles) * static_cast<int64_t>(lineOfSightInTiles);
-
-        for (int32_t x = minX; x <= maxX; ++x)
+        auto emit = [&](int32_t y, int32_t minX, int32_t maxX)
+        {
+            minX = std::max(0, minX);
+            maxX = std::min(tileMapSize.width - 1, maxX);
+            if (minX <= maxX)
+                cb(y, minX, maxX);
+        };
+
+        std::vector<std::pair<int32_t, int32_t>> spans;
+        for (int32_t y = std::max(0, areaMinY - radius);
+             y <= std::min(tileMapSize.height - 1, areaMaxY + radius); ++y)
         {
-            for (int32_t y = minY; y <= maxY; ++y)
+            if (isRectangle)
             {
-                int64_t minDistSq = std::numeric_limits<int64_t>::max();
+                const int32_t halfWidth = halfWidths[std::max({0, areaMinY - y, y - areaMaxY})];
+                emit(y, areaMinX - halfWidth, areaMaxX + halfWidth);
+                continue;
+            }
 
-                // Find nearest tile in the area (by squared Euclidean distance)
-                for (const auto& t : landArea.tiles)
-                {
-                    int32_t dx = x - static_cast<int32_t>(t.x);
-                    int32_t dy = y - static_cast<int32_t>(t.y);
-                    int64_t dSq = static_cast<int64_t>(dx) * dx + static_cast<int64_t>(dy) * dy;
-
-                    if (dSq < minDistSq)
-                    {
-                        minDistSq = dSq;
-                        if (minDistSq <= radiusSq)
-                        {
-                            break; // close enough; no need to search further
-                        }
-                    }
-                }
+            spans.clear();
+            for (const auto& tile : landArea.tiles)
+            {
+                const int32_t dy = std::abs(y - tile.y);
+                if (dy <= radius)
+                    spans.emplace_back(tile.x - halfWidths[dy], tile.x + halfWidths[dy]);
+            }
+            std::sort(spans.begin(), spans.end());
 
-                if (minDistSq <= radiusSq)
+            // Overlapping and adjacent spans are merged
+            for (size_t i = 0; i < spans.size();)
+            {
+                auto [minX, maxX] = spans[i];
+                for (++i; i < spans.size() and spans[i].first <= maxX + 1; ++i)
                 {
-                    cb(Tile(x, y));
+                    maxX = std::max(maxX, spans[i].second);
                 }
+                emit(y, minX, maxX);
             }
         }
     }
 
   private:
-    void markRadius(const Tile& tile, uint8_t lineOfSight, RevealStatus type);
-    void markRadius(const LandArea& landArea, uint8_t lineOfSight, RevealStatus type);
+    static Word toBits(RevealStatus status);
+
+    bool isValidPos(const Tile& tile) const;
+    void stamp(const Tile& center, uint8_t radiusInTiles, Word bits);
+    void fillRow(int32_t y, int32_t minX, int32_t maxX, Word bits);
+    void markRowChanged(int32_t y);
 
   private:
-    Flat2DArray<RevealStatus> m_map;
+    int32_t m_width = 0;
+    int32_t m_height = 0;
+    int32_t m_wordsPerRow = 0;
+    std::vector<Word> m_words;
+    std::vector<uint64_t> m_changedRows; // A bit per row
+    uint32_t m_syncedTeamId = 0; // None
+    uint32_t m_syncedVersion = 0;
 };
 } // namespace core
 
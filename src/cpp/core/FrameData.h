@@ -3,9 +3,12 @@
 
 #include "Feet.h"
 #include "FogOfWar.h"
+#include "GraphicsDelta.h"
 #include "GraphicsRegistry.h"
 #include "ImGuiHelper.h"
 
+#include <algorithm>
+#include <chrono>
 #include <vector>
 
 namespace core
@@ -14,14 +17,39 @@ class CompGraphics;
 
 struct FrameData
 {
+    using Feedback = Vec2; // Viewport position in pixels, renderer to simulator
+
     int frameNumber = 0;
-    std::vector<CompGraphics*> graphicUpdates; // Simulator to Renderer
-    // Even in a giant map (i.e. 240x240), fogOfWar information would take around 56KB
-    // Therefore, it is totally acceptable to copy FogOfWar.
-    FogOfWar fogOfWar;             // Simulator to Renderer
+    int tick = 0; // Simulator to Renderer, clock of animations
+    // Simulator to Renderer, when the tick was published and the interval to the next one. The
+    // renderer interpolates the positions over the interval (see getTickProgress)
+    std::chrono::steady_clock::time_point tickTime;
+    std::chrono::microseconds tickInterval{0};
+    GraphicsDeltaBuffer graphicUpdates; // Simulator to Renderer
+    // Only the rows changed since the last frame, the renderer keeps its own copy
+    FogOfWar::Delta fogOfWarDelta; // Simulator to Renderer
     GraphicsID cursor;             // Simulator to Renderer
     ImDrawDataSnapshot imGuiData;  // Simulator to Renderer
-    Vec2 viewportPositionInPixels; // Renderer to simulator
+
+    // Fraction of the tick interval elapsed since the tick, 1 once the next tick is due
+    float getTickProgress(std::chrono::steady_clock::time_point now) const
+    {
+        if (tickInterval.count() <= 0)
+            return 1.0f;
+
+        const float progress = std::chrono::duration<float>(now - tickTime) / tickInterval;
+        return std::clamp(progress, 0.0f, 1.0f);
+    }
+
+    // A frame the renderer didn't take is merged into the next one (see ThreadSynchronizer)
+    void mergeOlder(FrameData& older)
+    {
+        graphicUpdates.prepend(older.graphicUpdates);
+        older.graphicUpdates.clear();
+        fogOfWarDelta.mergeOlder(older.fogOfWarDelta);
+        if (not cursor.isValid())
+            cursor = older.cursor;
+    }
 };
 } // namespace core
 
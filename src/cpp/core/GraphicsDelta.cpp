@@ -0,0 +1,425 @@
+#include "GraphicsDelta.h"
+
+#include "components/CompGraphics.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <variant>
+
+using namespace core;
+
+namespace
+{
+// GraphicAddon without the text, its chars follow the parts
+struct PackedAddon
+{
+    using Data = std::variant<std::monostate,
+                              GraphicAddon::IsoCircle,
+                              GraphicAddon::Square,
+                              GraphicAddon::Rhombus,
+                              Color, // Of the text
+                              GraphicAddon::HealthBar>;
+
+    GraphicAddon::Type type = GraphicAddon::Type::NONE;
+    Alignment alignment = Alignment::CENTER;
+    Margin margin;
+    Data data;
+    uint32_t textSize = 0;
+};
+
+static_assert(std::is_trivially_copyable_v<GraphicsDelta>);
+static_assert(std::is_trivially_copyable_v<PackedAddon>);
+static_assert(std::is_trivially_copyable_v<DebugOverlay>);
+static_assert(std::is_trivially_copyable_v<Tile>);
+
+constexpr size_t RECORD_ALIGNMENT = alignof(GraphicsDelta);
+static_assert(sizeof(GraphicsDelta) % alignof(PackedAddon) == 0);
+static_assert(sizeof(PackedAddon) % alignof(DebugOverlay) == 0);
+static_assert(sizeof(DebugOverlay) % alignof(Tile) == 0);
+
+PackedAddon pack(const GraphicAddon& addon)
+{
+    PackedAddon packed;
+    packed.type = addon.type;
+    packed.alignment = addon.alignment;
+    packed.margin = addon.margin;
+    std::visit(
+        [&packed](const auto& data)
+        {
+            using T = std::decay_t<decltype(data)>;
+            if constexpr (std::is_same_v<T, GraphicAddon::Text>)
+            {
+                packed.data = data.color;
+                packed.textSize = data.text.size();
+            }
+            else
+            {
+                packed.data = data;
+            }
+        },
+        addon.data);
+    return packed;
+}
+
+// Reuses the text's capacity if the addon is a text already
+void unpack(const PackedAddon& packed, const char* text, GraphicAddon& addon)
+{
+    addon.type = packed.type;
+    addon.alignment = packed.alignment;
+    addon.margin = packed.margin;
+    std::visit(
+        [&](const auto& data)
+        {
+            using T = std::decay_t<decltype(data)>;
+            if constexpr (std::is_same_v<T, Color>)
+            {
+                auto textData = std::get_if<GraphicAddon::Text>(&addon.data);
+                if (textData == nullptr)
+                    textData = &addon.data.emplace<GraphicAddon::Text>();
+                textData->text.assign(text, packed.textSize);
+                textData->color = data;
+            }
+            else
+            {
+                addon.data = data;
+            }
+        },
+        packed.data);
+}
+
+bool isSame(const Vec2& a, const Vec2& b)
+{
+    // Bitwise, i.e. exact and nulls (NaN) are the same
+    return std::bit_cast<uint32_t>(a.x) == std::bit_cast<uint32_t>(b.x) and
+           std::bit_cast<uint32_t>(a.y) == std::bit_cast<uint32_t>(b.y);
+}
+
+bool isSame(const Feet& a, const Feet& b)
+{
+    return isSame(Vec2(a.x, a.y), Vec2(b.x, b.y));
+}
+
+// FNV-1a over the fields, to tell whether a part changed without keeping a copy of it
+class Hasher
+{
+  public:
+    template <typename T>
+        requires std::is_arithmetic_v<T> or std::is_enum_v<T>
+    void add(T value)
+    {
+        if constexpr (std::is_enum_v<T>)
+            mix(uint64_t(value));
+        else if constexpr (std::is_floating_point_v<T>)
+            mix(std::bit_cast<uint32_t>(float(value)));
+        else
+            mix(uint64_t(value));
+    }
+
+    template <typename Tag> void add(const Vec2Base<float, Tag>& value)
+    {
+        add(value.x);
+        add(value.y);
+    }
+
+    void add(const Color& color)
+    {
+        mix(uint32_t(color.r) << 24 | uint32_t(color.g) << 16 | uint32_t(color.b) << 8 | color.a);
+    }
+
+    void add(const std::string& text)
+    {
+        add(text.size());
+        for (char c : text)
+            add(c);
+    }
+
+    uint64_t get() const
+    {
+        return m_hash;
+    }
+
+  private:
+    void mix(uint64_t value)
+    {
+        m_hash = (m_hash ^ value) * 0x100000001b3ULL;
+    }
+
+    uint64_t m_hash = 0xcbf29ce484222325ULL;
+};
+
+uint64_t hashOf(const std::vector<GraphicAddon>& addons)
+{
+    Hasher hasher;
+    for (const auto& addon : addons)
+    {
+        hasher.add(addon.type);
+        hasher.add(addon.alignment);
+        hasher.add(addon.margin.vertical);
+        hasher.add(addon.margin.horizontal);
+        hasher.add(addon.data.index());
+        std::visit(
+            [&hasher](const auto& data)
+            {
+                using T = std::decay_t<decltype(data)>;
+                if constexpr (std::is_same_v<T, GraphicAddon::IsoCircle>)
+                {
+                    hasher.add(data.radius);
+                    hasher.add(data.center);
+                }
+                else if constexpr (std::is_same_v<T, GraphicAddon::Square>)
+                {
+                    hasher.add(data.width);
+                    hasher.add(data.height);
+                    hasher.add(data.center);
+                }
+                else if constexpr (std::is_same_v<T, GraphicAddon::Rhombus>)
+                {
+                    hasher.add(data.width);
+                    hasher.add(data.height);
+                }
+                else if constexpr (std::is_same_v<T, GraphicAddon::Text>)
+                {
+                    hasher.add(data.text);
+                    hasher.add(data.color);
+                }
+                else if constexpr (std::is_same_v<T, GraphicAddon::HealthBar>)
+                {
+                    hasher.add(data.percentage);
+                }
+            },
+            addon.data);
+    }
+    return hasher.get();
+}
+
+uint64_t hashOf(const std::vector<DebugOverlay>& overlays)
+{
+    Hasher hasher;
+    for (const auto& overlay : overlays)
+    {
+        hasher.add(overlay.type);
+        hasher.add(overlay.color);
+        hasher.add(overlay.anchor);
+        hasher.add(overlay.customPos1);
+        hasher.add(overlay.customPos2);
+        hasher.add(overlay.arrowEnd);
+        hasher.add(overlay.absolutePosition);
+        for (const auto& corner : overlay.rhombusCorners)
+            hasher.add(corner);
+        hasher.add(overlay.circlePixelRadius);
+        hasher.add(overlay.enabled);
+    }
+    return hasher.get();
+}
+
+uint64_t hashOf(const LandArea& landArea)
+{
+    Hasher hasher;
+    for (const auto& tile : landArea.tiles)
+    {
+        hasher.add(tile.x);
+        hasher.add(tile.y);
+    }
+    return hasher.get();
+}
+} // namespace
+
+void GraphicsDelta::applyTo(CompGraphics& graphics) const
+{
+    graphics.entityID = entityID;
+    graphics.parentEntityId = parentEntityId;
+    graphics.constantHeight = constantHeight;
+    graphics.playback = playback;
+    graphics.shading = shading;
+
+    if (changed & ID)
+        static_cast<GraphicsID&>(graphics) = id;
+
+    if (changed & POSITION)
+    {
+        graphics.positionInFeet = positionInFeet;
+        graphics.previousPositionInFeet = previousPositionInFeet;
+        graphics.positionTick = positionTick;
+        graphics.positionInScreenUnits = positionInScreenUnits;
+        graphics.relativePixelPosition = relativePixelPosition;
+        graphics.selfRelativePixelPosition = selfRelativePixelPosition;
+    }
+
+    if (changed & VISIBILITY)
+    {
+        graphics.layer = layer;
+        graphics.isDestroyed = isDestroyed;
+        graphics.isEnabled = isEnabled;
+    }
+
+    // Assigning within the capacity of the vectors, i.e. no allocations once warmed up
+    auto parts = reinterpret_cast<const std::byte*>(this) + sizeof(GraphicsDelta);
+    auto addons = reinterpret_cast<const PackedAddon*>(parts);
+    parts += addonCount * sizeof(PackedAddon);
+    auto overlays = reinterpret_cast<const DebugOverlay*>(parts);
+    parts += debugOverlayCount * sizeof(DebugOverlay);
+    auto tiles = reinterpret_cast<const Tile*>(parts);
+    parts += tileCount * sizeof(Tile);
+    auto text = reinterpret_cast<const char*>(parts);
+
+    if (changed & ADDONS)
+    {
+        graphics.addons.resize(addonCount);
+        for (uint32_t i = 0; i < addonCount; ++i)
+        {
+            unpack(addons[i], text, graphics.addons[i]);
+            text += addons[i].textSize;
+        }
+    }
+
+    if (changed & DEBUG_OVERLAYS)
+        graphics.debugOverlays.assign(overlays, overlays + debugOverlayCount);
+
+    if (changed & LAND_AREA)
+        graphics.landArea.tiles.assign(tiles, tiles + tileCount);
+}
+
+void GraphicsDeltaBuffer::append(const CompGraphics& graphics, uint16_t changed)
+{
+    GraphicsDelta delta;
+    delta.id = graphics;
+    delta.entityID = graphics.entityID;
+    delta.parentEntityId = graphics.parentEntityId;
+    delta.layer = graphics.layer;
+    delta.constantHeight = graphics.constantHeight;
+    delta.positionInFeet = graphics.positionInFeet;
+    delta.previousPositionInFeet = graphics.previousPositionInFeet;
+    delta.positionTick = graphics.positionTick;
+    delta.positionInScreenUnits = graphics.positionInScreenUnits;
+    delta.relativePixelPosition = graphics.relativePixelPosition;
+    delta.selfRelativePixelPosition = graphics.selfRelativePixelPosition;
+    delta.playback = graphics.playback;
+    delta.shading = graphics.shading;
+    delta.isDestroyed = graphics.isDestroyed;
+    delta.isEnabled = graphics.isEnabled;
+    delta.changed = changed;
+
+    if (changed & GraphicsDelta::ADDONS)
+    {
+        delta.addonCount = graphics.addons.size();
+        for (const auto& addon : graphics.addons)
+        {
+            if (auto text = std::get_if<GraphicAddon::Text>(&addon.data))
+                delta.textSize += text->text.size();
+        }
+    }
+    if (changed & GraphicsDelta::DEBUG_OVERLAYS)
+        delta.debugOverlayCount = graphics.debugOverlays.size();
+    if (changed & GraphicsDelta::LAND_AREA)
+        delta.tileCount = graphics.landArea.tiles.size();
+
+    const size_t size = sizeof(GraphicsDelta) + delta.addonCount * sizeof(PackedAddon) +
+                        delta.debugOverlayCount * sizeof(DebugOverlay) +
+                        delta.tileCount * sizeof(Tile) + delta.textSize;
+    // Keeping the next record aligned
+    delta.size = (size + RECORD_ALIGNMENT - 1) / RECORD_ALIGNMENT * RECORD_ALIGNMENT;
+
+    const size_t offset = m_bytes.size();
+    m_bytes.resize(offset + delta.size);
+    auto out = m_bytes.data() + offset;
+
+    std::memcpy(out, &delta, sizeof(GraphicsDelta));
+    out += sizeof(GraphicsDelta);
+    for (uint32_t i = 0; i < delta.addonCount; ++i)
+    {
+        const auto packed = pack(graphics.addons[i]);
+        std::memcpy(out, &packed, sizeof(PackedAddon));
+        out += sizeof(PackedAddon);
+    }
+    if (delta.debugOverlayCount != 0)
+    {
+        std::memcpy(out, graphics.debugOverlays.data(),
+                    delta.debugOverlayCount * sizeof(DebugOverlay));
+        out += delta.debugOverlayCount * sizeof(DebugOverlay);
+    }
+    if (delta.tileCount != 0)
+    {
+        std::memcpy(out, graphics.landArea.tiles.data(), delta.tileCount * sizeof(Tile));
+        out += delta.tileCount * sizeof(Tile);
+    }
+    for (uint32_t i = 0; i < delta.addonCount; ++i)
+    {
+        if (auto text = std::get_if<GraphicAddon::Text>(&graphics.addons[i].data))
+        {
+            std::memcpy(out, text->text.data(), text->text.size());
+            out += text->text.size();
+        }
+    }
+    ++m_count;
+}
+
+void GraphicsDeltaBuffer::prepend(const GraphicsDeltaBuffer& older)
+{
+    m_bytes.insert(m_bytes.begin(), older.m_bytes.begin(), older.m_bytes.end());
+    m_count += older.m_count;
+}
+
+void GraphicsDeltaEncoder::encode(const CompGraphics& graphics, GraphicsDeltaBuffer& buffer)
+{
+    const Feet positions[] = {graphics.positionInFeet, graphics.previousPositionInFeet};
+    const Vec2 screenPositions[] = {graphics.positionInScreenUnits,
+                                    graphics.relativePixelPosition,
+                                    graphics.selfRelativePixelPosition};
+    const auto addonsHash = hashOf(graphics.addons);
+    const auto debugOverlaysHash = hashOf(graphics.debugOverlays);
+    const auto landAreaHash = hashOf(graphics.landArea);
+
+    auto [it, isNew] = m_sent.try_emplace(graphics.entityID);
+    auto& sent = it->second;
+
+    uint16_t changed = GraphicsDelta::ALL;
+    if (not isNew)
+    {
+        changed = 0;
+        if (sent.id != graphics)
+            changed |= GraphicsDelta::ID;
+        for (int i = 0; i < 2; ++i)
+        {
+            if (not isSame(sent.positions[i], positions[i]))
+                changed |= GraphicsDelta::POSITION;
+        }
+        for (int i = 0; i < 3; ++i)
+        {
+            if (not isSame(sent.screenPositions[i], screenPositions[i]))
+                changed |= GraphicsDelta::POSITION;
+        }
+        if (sent.layer != graphics.layer or sent.isEnabled != graphics.isEnabled or
+            graphics.isDestroyed)
+        {
+            changed |= GraphicsDelta::VISIBILITY;
+        }
+        if (sent.addonsHash != addonsHash)
+            changed |= GraphicsDelta::ADDONS;
+        if (sent.debugOverlaysHash != debugOverlaysHash)
+            changed |= GraphicsDelta::DEBUG_OVERLAYS;
+        if (sent.landAreaHash != landAreaHash)
+            changed |= GraphicsDelta::LAND_AREA;
+    }
+
+    buffer.append(graphics, changed);
+
+    // Nothing to compare with once destroyed, the entity is sent whole if ever again
+    if (graphics.isDestroyed)
+    {
+        m_sent.erase(it);
+        return;
+    }
+
+    sent.id = graphics;
+    std::copy(std::begin(positions), std::end(positions), sent.positions);
+    std::copy(std::begin(screenPositions), std::end(screenPositions), sent.screenPositions);
+    sent.layer = graphics.layer;
+    sent.isEnabled = graphics.isEnabled;
+    sent.addonsHash = addonsHash;
+    sent.debugOverlaysHash = debugOverlaysHash;
+    sent.landAreaHash = landAreaHash;
+}
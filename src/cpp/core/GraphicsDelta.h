@@ -0,0 +1,144 @@
+#ifndef CORE_GRAPHICSDELTA_H
+#define CORE_GRAPHICSDELTA_H
+
+#include "Color.h"
+#include "Feet.h"
+#include "GraphicsID.h"
+#include "Property.h"
+#include "components/CompAnimation.h"
+#include "utils/Types.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace core
+{
+class CompGraphics;
+
+/*
+ *   Compact record of an entity's graphic sent from the simulator to the renderer. The record
+ *   is fixed-size and "changed" tells its fields differing from the previous record of the
+ *   entity (i.e. from the renderer's copy). Variable sized parts (addons, debug overlays,
+ *   land area) are carried only when changed, right after the record in the same buffer (see
+ *   GraphicsDeltaBuffer).
+ */
+struct GraphicsDelta
+{
+    enum Field : uint16_t
+    {
+        ID = 1 << 0,         // GraphicsID
+        POSITION = 1 << 1,   // All the positions
+        VISIBILITY = 1 << 2, // Layer, enabled and destroyed flags
+        ADDONS = 1 << 3,
+        DEBUG_OVERLAYS = 1 << 4,
+        LAND_AREA = 1 << 5,
+        ALL = (1 << 6) - 1,
+    };
+
+    GraphicsID id;
+    uint32_t entityID = 0;
+    uint32_t parentEntityId = 0;
+    Property<GraphicLayer> layer;
+    Property<int> constantHeight;
+    Feet positionInFeet;
+    Feet previousPositionInFeet;
+    int positionTick = 0;
+    Vec2 positionInScreenUnits;
+    Vec2 relativePixelPosition;
+    Vec2 selfRelativePixelPosition;
+    AnimationPlayback playback;
+    Color shading;
+    bool isDestroyed = false;
+    bool isEnabled = true;
+    uint16_t changed = 0;
+    uint32_t addonCount = 0;
+    uint32_t debugOverlayCount = 0;
+    uint32_t tileCount = 0;
+    uint32_t textSize = 0; // Of the text addons, in chars
+    uint32_t size = 0;     // Along with the parts, in bytes
+
+    // Sets the changed fields and parts (and the few unflagged ones). Must be called on the
+    // record in its buffer, since the parts follow it.
+    void applyTo(CompGraphics& graphics) const;
+};
+
+/*
+ *   Graphic records of a frame in a linear buffer, one after the other along with their
+ *   parts. The buffer doesn't refer to memory elsewhere, hence frames merge by concatenating
+ *   the bytes. Clearing keeps the capacity, so appending doesn't allocate once warmed up.
+ */
+class GraphicsDeltaBuffer
+{
+  public:
+    // Carries the parts flagged in "changed" only
+    void append(const CompGraphics& graphics, uint16_t changed);
+
+    // Records of an older frame, to be applied before the ones of this
+    void prepend(const GraphicsDeltaBuffer& older);
+
+    void clear()
+    {
+        m_bytes.clear();
+        m_count = 0;
+    }
+
+    bool empty() const
+    {
+        return m_count == 0;
+    }
+
+    size_t getCount() const
+    {
+        return m_count;
+    }
+
+    size_t getSizeInBytes() const
+    {
+        return m_bytes.size();
+    }
+
+    // In the order appended
+    template <typename Fn> void forEach(Fn&& fn) const
+    {
+        for (size_t offset = 0; offset < m_bytes.size();)
+        {
+            const auto& delta = *reinterpret_cast<const GraphicsDelta*>(m_bytes.data() + offset);
+            fn(delta);
+            offset += delta.size;
+        }
+    }
+
+  private:
+    std::vector<std::byte> m_bytes;
+    size_t m_count = 0;
+};
+
+/*
+ *   Keeps what was sent for each entity, to send only the changes. Every record appended
+ *   must reach the renderer in order (i.e. frames are merged, never dropped).
+ */
+class GraphicsDeltaEncoder
+{
+  public:
+    void encode(const CompGraphics& graphics, GraphicsDeltaBuffer& buffer);
+
+  private:
+    struct Sent
+    {
+        GraphicsID id;
+        Feet positions[2];
+        Vec2 screenPositions[3];
+        GraphicLayer layer = GraphicLayer::NONE;
+        bool isEnabled = true;
+        uint64_t addonsHash = 0;
+        uint64_t debugOverlaysHash = 0;
+        uint64_t landAreaHash = 0;
+    };
+
+    std::unordered_map<uint32_t, Sent> m_sent; // By entity
+};
+} // namespace core
+
+#endif // CORE_GRAPHICSDELTA_H
@@ -20,9 +20,9 @@
 #include "components/CompTransform.h"
 #include "components/CompUIElement.h"
 #include "components/CompUnit.h"
-#include "utils/ObjectPool.h"
 
 #include <algorithm>
+#include <chrono>
 #include <entt/entity/registry.hpp>
 
 using namespace core;
@@ -30,14 +30,13 @@ using namespace core;
 GraphicsInstructor::GraphicsInstructor(ThreadSynchronizer<FrameData>& synchronizer)
     : m_synchronizer(synchronizer)
 {
-    ObjectPool<CompGraphics>::reserve(1000);
-
     registerCallback(Event::Type::TICK, this, &GraphicsInstructor::onTick);
 }
 
 bool GraphicsInstructor::onTick(const Event& e)
 {
     onTickStart();
+    m_synchronizer.getSenderFrameData().tick = e.getData<TickData>().currentTick;
     updateGraphicComponents();
     sendGraphicsInstructions();
     onTickEnd();
@@ -49,9 +48,13 @@ void GraphicsInstructor::onTickStart()
     // Read and send data
     auto player = m_playerController->getPlayer();
     auto& frameData = m_synchronizer.getSenderFrameData();
-    frameData.fogOfWar = *(player->getFogOfWar().get());
+    // Whole fog of war when the player changed (i.e. the first frame too)
+    auto fogOfWar = player->getFogOfWar().get();
+    fogOfWar->syncVisibility(*player->getVision());
+    fogOfWar->takeDelta(frameData.fogOfWarDelta, fogOfWar != m_lastFogOfWar);
+    m_lastFogOfWar = fogOfWar;
     frameData.frameNumber = m_frameCount;
-    m_coordinates->setViewportPositionInPixels(frameData.viewportPositionInPixels);
+    m_coordinates->setViewportPositionInPixels(m_synchronizer.getFeedback());
 
     if (!m_initialized)
     {
@@ -72,23 +75,28 @@ void GraphicsInstructor::onTickStart()
 void GraphicsInstructor::onTickEnd()
 {
     m_frameCount++;
-    m_synchronizer.waitForReceiver([&]() {});
+
+    auto& frameData = m_synchronizer.getSenderFrameData();
+    frameData.tickTime = std::chrono::steady_clock::now();
+    frameData.tickInterval =
+        std::chrono::microseconds(1'000'000 / std::max(1, m_settings->getTicksPerSecond()));
+    m_synchronizer.publish();
     StateManager::clearDirtyEntities();
 }
 
+// Only the changes of the graphics since they were sent the last
 void GraphicsInstructor::sendGraphicsInstructions()
 {
+    auto& updates = m_synchronizer.getSenderFrameData().graphicUpdates;
+
     for (auto entity : StateManager::getDirtyEntities())
     {
         auto& gc = m_stateManager->getComponent<CompGraphics>(entity);
 
         if (gc.bypass == false)
         {
-            auto instruction = ObjectPool<CompGraphics>::acquire();
-            *instruction = gc;
-
             if (gc.entityID != entt::null)
-                sendGraphiInstruction(instruction);
+                m_deltaEncoder.encode(gc, updates);
             else
                 spdlog::error("Invalid entity found during simulation for id: {}", gc.toString());
         }
@@ -97,14 +105,17 @@ void GraphicsInstructor::sendGraphicsInstructions()
 
 void GraphicsInstructor::updateGraphicComponents()
 {
-    m_synchronizer.getSenderFrameData().cursor = GraphicsID();
+    auto& frameData = m_synchronizer.getSenderFrameData();
+    frameData.cursor = GraphicsID();
 
     for (auto entity : StateManager::getDirtyEntities())
     {
         auto [transform, entityInfo, gc] =
             m_stateManager->getComponents<CompTransform, CompEntityInfo, CompGraphics>(entity);
 
+        gc.previousPositionInFeet = gc.positionInFeet;
         gc.positionInFeet = transform.position;
+        gc.positionTick = frameData.tick;
         gc.direction = static_cast<uint64_t>(transform.getIsometricDirection());
         gc.variation = entityInfo.variation;
         gc.entityType = entityInfo.entityType;
@@ -161,6 +172,7 @@ void GraphicsInstructor::updateGraphicComponents()
             auto& animation = m_stateManager->getComponent<CompAnimation>(entity);
             gc.frame = animation.frame;
             gc.layer = animation.layer;
+            gc.playback = animation.playback;
         }
 
         if (m_stateManager->hasComponent<CompAction>(entity))
@@ -226,7 +238,7 @@ void GraphicsInstructor::updateGraphicComponents()
             // Avoid sending cursor as a regular graphics instruction, but set to
             // frame data directly.
             gc.bypass = true;
-            m_synchronizer.getSenderFrameData().cursor = cursorComp->cursor;
+            frameData.cursor = cursorComp->cursor;
         }
 
         if (auto projectile = m_stateManager->tryGetComponent<CompProjectile>(entity))
@@ -261,8 +273,3 @@ void GraphicsInstructor::updateGraphicComponents()
         }
     }
 }
-
-void GraphicsInstructor::sendGraphiInstruction(CompGraphics* instruction)
-{
-    m_synchronizer.getSenderFrameData().graphicUpdates.push_back(instruction);
-}
\ No newline at end of file
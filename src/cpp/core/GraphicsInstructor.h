@@ -4,6 +4,7 @@
 #include "Coordinates.h"
 #include "EventHandler.h"
 #include "FrameData.h"
+#include "GraphicsDelta.h"
 #include "HumanController.h"
 #include "Settings.h"
 #include "ThreadSynchronizer.h"
@@ -28,7 +29,6 @@ class GraphicsInstructor : public EventHandler
     void onTickEnd();
 
     void sendGraphicsInstructions();
-    void sendGraphiInstruction(CompGraphics* instruction);
     void updateGraphicComponents();
 
   private:
@@ -37,8 +37,10 @@ class GraphicsInstructor : public EventHandler
     LazyServiceRef<StateManager> m_stateManager;
     LazyServiceRef<Settings> m_settings;
     ThreadSynchronizer<FrameData>& m_synchronizer;
+    GraphicsDeltaEncoder m_deltaEncoder;
     uint32_t m_frameCount = 0;
     bool m_initialized = false;
+    const FogOfWar* m_lastFogOfWar = nullptr; // Of the player the renderer got the last
 };
 } // namespace core
 
@@ -35,6 +35,9 @@ HumanController::HumanController()
     registerCallback(Event::Type::BUILDING_CREATED, this, &HumanController::onBuildingApproved);
     registerCallback(Event::Type::MOUSE_BTN_DOWN, this, &HumanController::onMouseButtonDown);
     registerCallback(Event::Type::ENTITY_SELECTION, this, &HumanController::onUnitSelection);
+
+    // Doesn't act on TICK
+    declareAccess(SystemAccess());
 }
 
 void HumanController::setPlayer(Ref<Player> player)
@@ -131,7 +134,7 @@ void HumanController::createUnit(uint32_t entityType, const EntitySelection& sel
 
     for (auto building : selectedBuildings.selectedEntities)
     {
-        UnitQueueData data{.player = m_player, .entityType = entityType, .building = building};
+        UnitQueueData data{.playerId = m_player->getId(), .entityType = entityType, .building = building};
         publishEvent(Event::Type::UNIT_QUEUE_REQUEST, data);
     }
 }
@@ -318,7 +321,7 @@ bool HumanController::onBuildingApproved(const Event& e)
     ScopedDiagnosticContext scoped("P", m_player->getId());
 
     auto& data = e.getData<BuildingPlacementData>();
-    if (data.player == m_player)
+    if (data.playerId == m_player->getId())
     {
         for (auto unit : m_currentEntitySelection.selection.selectedEntities)
         {
@@ -432,7 +435,7 @@ BuildingPlacementData HumanController::createBuildingPlacement(
 #endif
 
     BuildingPlacementData data;
-    data.player = m_player;
+    data.playerId = m_player->getId();
     data.entityType = buildingType;
     data.pos = pos;
     data.entity = entity;
@@ -586,7 +589,7 @@ void HumanController::initiateGarrison()
     spdlog::debug("Garrison initiated");
     m_garrisonOperationInProgress = true;
     publishEvent(Event::Type::GARRISON_REQUEST,
-                 GarrisonData{.player = m_player, .inprogress = true});
+                 GarrisonData{.playerId = m_player->getId(), .inprogress = true});
 }
 
 void HumanController::initiateUngarrison()
@@ -596,7 +599,7 @@ void HumanController::initiateUngarrison()
     {
         publishEvent(
             Event::Type::UNGARRISON_REQUEST,
-            UngarrisonData{m_player, m_currentEntitySelection.selection.selectedEntities[0]});
+            UngarrisonData{m_player->getId(), m_currentEntitySelection.selection.selectedEntities[0]});
     }
 }
 
@@ -606,7 +609,7 @@ void HumanController::concludeGarrison()
     {
         m_garrisonOperationInProgress = false;
         publishEvent(Event::Type::GARRISON_REQUEST,
-                     GarrisonData{.player = m_player, .inprogress = false});
+                     GarrisonData{.playerId = m_player->getId(), .inprogress = false});
     }
 }
 
@@ -0,0 +1,53 @@
+#ifndef CORE_INPUTEVENTQUEUE_H
+#define CORE_INPUTEVENTQUEUE_H
+
+#include "Event.h"
+
+#include <readerwriterqueue.h>
+
+namespace core
+{
+/*
+ *   Raw input captured from the window system, timestamped at arrival.
+ *   Kept trivially copyable to pass through the lock-free queue as is.
+ */
+struct InputEvent
+{
+    Event::Type type = Event::Type::NONE; // KEY_UP, KEY_DOWN, MOUSE_MOVE, MOUSE_BTN_UP/DOWN
+    int keyCode = 0;                      // SDL_Scancode for key events
+    MouseClickData::Button button = MouseClickData::Button::LEFT;
+    Vec2 screenPos;
+    uint64_t timestampNs = 0; // SDL_GetTicksNS() based
+};
+
+/*
+ *   Single producer (renderer thread polling SDL) single consumer (event loop
+ *   thread draining at tick boundaries) queue of input events.
+ */
+class InputEventQueue
+{
+  public:
+    static constexpr size_t INITIAL_CAPACITY = 256;
+
+    InputEventQueue() : m_queue(INITIAL_CAPACITY)
+    {
+    }
+
+    // Producer side. Grows if the consumer doesn't keep up (e.g. while paused).
+    void push(const InputEvent& event)
+    {
+        m_queue.enqueue(event);
+    }
+
+    // Consumer side
+    bool tryPop(InputEvent& event)
+    {
+        return m_queue.try_dequeue(event);
+    }
+
+  private:
+    moodycamel::ReaderWriterQueue<InputEvent> m_queue;
+};
+} // namespace core
+
+#endif // CORE_INPUTEVENTQUEUE_H
@@ -9,6 +9,9 @@ using namespace core;
 LogLevelController::LogLevelController()
 {
     registerCallback(Event::Type::KEY_UP, this, &LogLevelController::onKeyUp);
+
+    // Doesn't act on TICK
+    declareAccess(SystemAccess());
 }
 
 bool LogLevelController::onKeyUp(const Event& e)
@@ -6,10 +6,19 @@
 #include "components/CompHousing.h"
 #include "components/CompPlayer.h"
 #include "components/CompUnit.h"
+#include "components/CompVision.h"
 #include "debug.h"
 
+#include <utility>
+
 using namespace core;
 
+Player::~Player()
+{
+    if (m_vision)
+        m_vision->removeMember(this);
+}
+
 void Player::init(uint8_t id)
 {
     m_id = id;
@@ -21,6 +30,9 @@ void Player::init(uint8_t id)
     auto settings = ServiceRegistry::getInstance().getService<Settings>();
     m_fow->init(settings->getWorldSizeInTiles().width, settings->getWorldSizeInTiles().height,
                 settings->getFOWRevealStatus());
+    m_vision = CreateRef<TeamVision>();
+    m_vision->init(settings->getWorldSizeInTiles().width, settings->getWorldSizeInTiles().height);
+    m_vision->addMember(this);
     allegianceToPlayers.fill(Allegiance::NEUTRAL);
 }
 
@@ -126,5 +138,122 @@ void Player::transferOwnership(uint32_t entityId, Ref<Player> newOwner)
     removeOwnership(entityId);
     m_stateMan->getComponent<CompPlayer>(entityId).player = newOwner;
 
+    auto vision = m_stateMan->tryGetComponent<CompVision>(entityId);
+    if (vision and vision->hasVision and m_vision != newOwner->m_vision)
+        moveSight(entityId, *vision, *m_vision, *newOwner->m_vision);
+
     newOwner->ownEntity(entityId);
 }
+
+void Player::setAllegiance(Ref<Player> otherPlayer, Allegiance allegiance)
+{
+    debug_assert(otherPlayer->isValid(), "Invalid player to update allegiance with");
+    debug_assert(otherPlayer->getId() < Constants::MAX_PLAYERS,
+                 "Invalid player ID to update allegiance with");
+
+    allegianceToPlayers[otherPlayer->getId()] = allegiance;
+    if (otherPlayer.get() == this)
+        return;
+
+    const bool sameTeam = m_vision == otherPlayer->m_vision;
+    if (isMutualAlly(*otherPlayer) and not sameTeam)
+        mergeTeams(*otherPlayer);
+    else if (not isMutualAlly(*otherPlayer) and sameTeam)
+        splitTeam(); // Might still be in the same team through a common ally
+}
+
+bool Player::isMutualAlly(const Player& other) const
+{
+    return allegianceToPlayers[other.m_id] == Allegiance::ALLY and
+           other.allegianceToPlayers[m_id] == Allegiance::ALLY;
+}
+
+// The sight counts add up, hence the entities keep their sight as is
+void Player::mergeTeams(Player& other)
+{
+    const auto absorbed = other.m_vision;
+    m_vision->addSights(*absorbed);
+
+    const auto members = absorbed->getMembers();
+    for (auto member : members)
+    {
+        member->m_vision = m_vision;
+        m_vision->addMember(member);
+    }
+}
+
+// Members no longer connected by mutual alliances to the first one move to new teams,
+// along with the sight of their entities. Entities of the players outside the team stay as is.
+void Player::splitTeam()
+{
+    const auto team = m_vision;
+    auto remaining = team->getMembers();
+    bool isFirst = true;
+    uint32_t movedMask = 0; // A bit per player id moved to a new team
+
+    while (not remaining.empty())
+    {
+        std::vector<Player*> group{remaining.back()};
+        remaining.pop_back();
+        for (size_t i = 0; i < group.size(); ++i)
+        {
+            for (auto it = remaining.begin(); it != remaining.end();)
+            {
+                if (group[i]->isMutualAlly(**it))
+                {
+                    group.push_back(*it);
+                    it = remaining.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+
+        if (std::exchange(isFirst, false))
+        {
+            if (remaining.empty())
+                return; // Still a single team
+            continue;   // Stays with the current team
+        }
+
+        auto newTeam = CreateRef<TeamVision>();
+        newTeam->init(team->getWidth(), team->getHeight());
+        for (auto member : group)
+        {
+            member->m_vision = newTeam;
+            newTeam->addMember(member);
+            team->removeMember(member);
+            movedMask |= 1u << member->m_id;
+        }
+    }
+
+    m_stateMan->getEntities<CompVision, CompPlayer>().each(
+        [this, &team, movedMask](uint32_t entity, CompVision& vision, CompPlayer& player)
+        {
+            if (vision.hasVision and player.player and
+                (movedMask & (1u << player.player->m_id)))
+            {
+                moveSight(entity, vision, *team, *player.player->m_vision);
+            }
+        });
+}
+
+void Player::moveSight(uint32_t entity,
+                       const CompVision& vision,
+                       TeamVision& from,
+                       TeamVision& to)
+{
+    // Buildings count their sight over the land area, units around their center
+    if (auto building = m_stateMan->tryGetComponent<CompBuilding>(entity))
+    {
+        from.removeSight(building->landArea, vision.lineOfSight);
+        to.addSight(building->landArea, vision.lineOfSight);
+    }
+    else
+    {
+        from.removeSight(vision.sightCenter, vision.lineOfSight);
+        to.addSight(vision.sightCenter, vision.lineOfSight);
+    }
+}
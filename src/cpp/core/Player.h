@@ -4,6 +4,7 @@
 #include "FogOfWar.h"
 #include "InGameResource.h"
 #include "StateManager.h"
+#include "TeamVision.h"
 #include "utils/LazyServiceRef.h"
 
 #include <limits>
@@ -12,9 +13,15 @@
 
 namespace core
 {
+class CompVision;
+
 class Player
 {
   public:
+    static constexpr uint8_t INVALID_ID = std::numeric_limits<uint8_t>::max();
+
+    ~Player();
+
     void init(uint8_t id);
 
     uint8_t getId() const
@@ -62,11 +69,18 @@ class Player
         return m_currentPopulation;
     }
 
+    // Visible tiles are as of the last FogOfWar::syncVisibility with the team's vision
     Ref<FogOfWar> getFogOfWar() const
     {
         return m_fow;
     }
 
+    // Sight of the team of the player, where the entities of the player count their sight
+    Ref<TeamVision> getVision() const
+    {
+        return m_vision;
+    }
+
     const std::unordered_set<uint32_t>& getMyBuildings() const
     {
         return m_myBuildings;
@@ -90,27 +104,40 @@ class Player
         return allegianceToPlayers[otherPlayer->getId()];
     }
 
-    bool isAlly(Ref<Player> otherPlayer) const
+    // A bit per player id having the allegiance with this player
+    uint32_t getAllegianceMask(Allegiance allegiance) const
     {
-        return getAllegiance(std::move(otherPlayer)) == Allegiance::ALLY;
+        static_assert(Constants::MAX_PLAYERS <= 32, "Allegiance mask is too narrow");
+
+        uint32_t mask = 0;
+        for (uint32_t id = 0; id < Constants::MAX_PLAYERS; ++id)
+        {
+            if (allegianceToPlayers[id] == allegiance)
+                mask |= 1u << id;
+        }
+        return mask;
     }
 
-    void setAllegiance(Ref<Player> otherPlayer, Allegiance allegiance)
+    bool isAlly(Ref<Player> otherPlayer) const
     {
-        debug_assert(otherPlayer->isValid(), "Invalid player to update allegiance with");
-        debug_assert(otherPlayer->getId() < Constants::MAX_PLAYERS,
-                     "Invalid player ID to update allegiance with");
-
-        allegianceToPlayers[otherPlayer->getId()] = allegiance;
+        return getAllegiance(std::move(otherPlayer)) == Allegiance::ALLY;
     }
 
+    // Mutual allies share the team vision, hence changing allegiance merges or splits teams
+    void setAllegiance(Ref<Player> otherPlayer, Allegiance allegiance);
+
   private:
-    static constexpr uint8_t INVALID_ID = std::numeric_limits<uint8_t>::max();
+    bool isMutualAlly(const Player& other) const;
+    void mergeTeams(Player& other);
+    void splitTeam();
+    void moveSight(uint32_t entity, const CompVision& vision, TeamVision& from, TeamVision& to);
 
+  private:
     uint8_t m_id = INVALID_ID;
     std::vector<InGameResource> m_resources;
     std::unordered_set<uint8_t> m_ownedEntities;
     Ref<FogOfWar> m_fow;
+    Ref<TeamVision> m_vision;
     std::unordered_set<uint32_t> m_myBuildings;
     std::unordered_set<uint32_t> m_myConstructionSites;
     LazyServiceRef<StateManager> m_stateMan;
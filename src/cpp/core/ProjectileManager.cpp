@@ -6,6 +6,7 @@
 #include "components/CompHealth.h"
 #include "components/CompProjectile.h"
 #include "components/CompTransform.h"
+#include "debug.h"
 #include "logging/Logger.h"
 #include "utils/Maths.h"
 
@@ -15,28 +16,84 @@ ProjectileManager::ProjectileManager()
 {
     registerCallback(Event::Type::TICK, this, &ProjectileManager::onTick);
     registerCallback(Event::Type::PROJECTILE_CREATED, this, &ProjectileManager::onProjectileCreate);
+
+    declareAccess(SystemAccess()
+                      .reads<Settings, TileMap, CompArmor>()
+                      .writes<CompProjectile, CompTransform, CompEntityInfo, CompGraphics,
+                              CompHealth, EntityLifetime>()
+                      .appends<DirtyEntities>());
 }
 
 bool ProjectileManager::onTick(const Event& e)
 {
+    const auto count = m_flights.size();
+    if (count == 0)
+        return false;
+
     auto& tickData = e.getData<TickData>();
-    auto timeS = (double) tickData.deltaTimeMs / 1000.0;
-    const auto collisionRadiusSq = PROJECTILE_COLLISION_RADIUS * PROJECTILE_COLLISION_RADIUS;
-    auto& gameMap = m_stateMan->gameMap();
+    const auto step = float(tickData.deltaTimeMs / 1000.0 * m_settings->getGameSpeed());
+    const float collisionRadiusSq = PROJECTILE_COLLISION_RADIUS * PROJECTILE_COLLISION_RADIUS;
+
+    float* x = m_flights.x.data();
+    float* y = m_flights.y.data();
+    const float* directionX = m_flights.directionX.data();
+    const float* directionY = m_flights.directionY.data();
+    const float* speed = m_flights.speed.data();
+
+    // Independent iterations over plain arrays, hence vectorizable
+    for (size_t i = 0; i < count; ++i)
+    {
+        x[i] += directionX[i] * speed[i] * step;
+        y[i] += directionY[i] * speed[i] * step;
+    }
+
+    const float* targetX = m_flights.targetX.data();
+    const float* targetY = m_flights.targetY.data();
+    const float* originX = m_flights.originX.data();
+    const float* originY = m_flights.originY.data();
+    const float* rangeSq = m_flights.rangeSq.data();
 
-    for (auto it = m_projectilesTracking.begin(); it != m_projectilesTracking.end();)
+    m_arrivals.resize(count);
+    for (size_t i = 0; i < count; ++i)
     {
-        auto projectile = *it;
-        auto [projectileComp, transformComp, info, graphics] =
-            m_stateMan->getComponents<CompProjectile, CompTransform, CompEntityInfo, CompGraphics>(
-                projectile);
+        const float toTargetX = targetX[i] - x[i];
+        const float toTargetY = targetY[i] - y[i];
+        const float traveledX = x[i] - originX[i];
+        const float traveledY = y[i] - originY[i];
 
-        transformComp.position += (projectileComp.direction *
-                                   (projectileComp.speed * timeS * m_settings->getGameSpeed()));
+        const bool atTarget = toTargetX * toTargetX + toTargetY * toTargetY < collisionRadiusSq;
+        // In case if the collision check didn't work, the projectile is done once it is
+        // out of range anyway as a fallback.
+        const bool outOfRange = traveledX * traveledX + traveledY * traveledY >= rangeSq[i];
+
+        m_arrivals[i] = atTarget     ? Arrival::AT_TARGET
+                        : outOfRange ? Arrival::OUT_OF_RANGE
+                                     : Arrival::IN_FLIGHT;
+    }
+
+    publishPositions();
+
+    // Backwards, since removing swaps the last projectile in
+    for (size_t i = count; i-- > 0;)
+    {
+        if (m_arrivals[i] != Arrival::IN_FLIGHT)
+        {
+            onArrival(i, m_arrivals[i]);
+            m_flights.remove(i);
+        }
+    }
+    return false;
+}
 
-        auto traveledDistanceSq =
-            transformComp.position.distanceSquared(projectileComp.originPosition);
+void ProjectileManager::publishPositions()
+{
+    for (size_t i = 0; i < m_flights.size(); ++i)
+    {
+        auto& transform = m_stateMan->getComponent<CompTransform>(m_flights.entity[i]);
+        transform.position = Feet(m_flights.x[i], m_flights.y[i]);
 
+#ifndef NDEBUG
+        auto& graphics = m_stateMan->getComponent<CompGraphics>(m_flights.entity[i]);
         if (graphics.debugOverlays.empty())
         {
             DebugOverlay anchor;
@@ -45,58 +102,47 @@ bool ProjectileManager::onTick(const Event& e)
             anchor.circlePixelRadius = 10;
             graphics.debugOverlays.push_back(anchor);
         }
-        graphics.debugOverlays[0].absolutePosition = transformComp.position;
-        StateManager::markDirty(projectile);
+        graphics.debugOverlays[0].absolutePosition = transform.position;
+#endif
+    }
+    StateManager::markDirty(m_flights.entity);
+}
 
-        auto distanceToTarget =
-            transformComp.position.distanceSquared(projectileComp.targetPosition);
-        if (distanceToTarget < collisionRadiusSq)
-        {
-            // Hit or not, projectile is done
-            if (projectileComp.damageMode == ProjectileDamageMode::ON_HIT)
-            {
-                auto hit = getHit(transformComp.position);
-                if (hit != entt::null)
-                {
-                    auto [targetArmor, targetHealth] =
-                        m_stateMan->getComponents<CompArmor, CompHealth>(hit);
-                    auto damage = getDamage(projectileComp, targetArmor);
+void ProjectileManager::onArrival(size_t index, Arrival arrival)
+{
+    const auto projectile = m_flights.entity[index];
 
-                    targetHealth.health -= damage;
+    // Hit or not, projectile is done
+    if (arrival == Arrival::AT_TARGET and
+        m_flights.damageMode[index] == ProjectileDamageMode::ON_HIT)
+    {
+        auto hit = getHit(Feet(m_flights.x[index], m_flights.y[index]));
+        if (hit != entt::null)
+        {
+            auto& projectileComp = m_stateMan->getComponent<CompProjectile>(projectile);
+            auto [targetArmor, targetHealth] =
+                m_stateMan->getComponents<CompArmor, CompHealth>(hit);
+            auto damage = getDamage(projectileComp, targetArmor);
 
-                    spdlog::debug("HIT. Dealt {} damage, target health {}", damage,
-                                  targetHealth.health);
-                }
-            }
+            targetHealth.health -= damage;
 
-            info.isDestroyed = true;
-            m_stateMan->destroyEntity(projectile);
-            it = m_projectilesTracking.erase(it);
-            continue;
+            spdlog::debug("HIT. Dealt {} damage, target health {}", damage, targetHealth.health);
         }
-        else if (traveledDistanceSq >= projectileComp.rangeSq)
-        {
-            // In case if the previous collision check didn't work, destroy the
-            // projectile if it is out of range anyway as a fallback.
-            info.isDestroyed = true;
-            m_stateMan->destroyEntity(projectile);
-            it = m_projectilesTracking.erase(it);
-            continue;
-        }
-        ++it;
     }
-    return false;
+    releaseProjectile(projectile, m_flights.entityType[index]);
 }
 
 bool ProjectileManager::onProjectileCreate(const Event& e)
 {
     auto& data = e.getData<ProjectileData>();
+    debug_assert(data.properties != nullptr, "Projectile properties are not set");
+    auto projectileEntity = acquireProjectile(data.projectileEntityType);
 
-    spdlog::debug("Projectile {} received to track", data.projectileEntity);
+    spdlog::debug("Projectile {} received to track", projectileEntity);
 
     auto [projectile, transform] =
-        m_stateMan->getComponents<CompProjectile, CompTransform>(data.projectileEntity);
-    projectile = data.properties;
+        m_stateMan->getComponents<CompProjectile, CompTransform>(projectileEntity);
+    projectile = *data.properties;
     projectile.originPosition = data.originPos;
     projectile.targetPosition = data.targetPos;
     projectile.direction = (data.targetPos - data.originPos).normalized();
@@ -106,31 +152,69 @@ bool ProjectileManager::onProjectileCreate(const Event& e)
 
     if (data.speed <= 0)
     {
-        spdlog::warn("Projectile {} has invalid speed {}", data.projectileEntity, data.speed);
+        spdlog::warn("Projectile {} has invalid speed {}", projectileEntity, data.speed);
     }
     transform.position = data.originPos;
-    m_projectilesTracking.push_back(data.projectileEntity);
+    m_flights.add(projectileEntity, data.projectileEntityType, projectile, data.originPos);
 
     return false;
 }
 
+uint32_t ProjectileManager::acquireProjectile(uint32_t entityType)
+{
+    auto& freeProjectiles = m_freeProjectiles[entityType];
+    if (freeProjectiles.empty())
+        return m_entityFactory->createEntity(entityType);
+
+    auto entity = freeProjectiles.back();
+    freeProjectiles.pop_back();
+    m_stateMan->getComponent<CompEntityInfo>(entity).isDestroyed = false;
+    return entity;
+}
+
+void ProjectileManager::releaseProjectile(uint32_t entity, uint32_t entityType)
+{
+    auto [info, projectile] = m_stateMan->getComponents<CompEntityInfo, CompProjectile>(entity);
+    info.isDestroyed = true;
+    // Stays hidden at the start of the next flight until it has a previous position to
+    // derive the angle from (see GraphicsInstructor)
+    projectile.previousPixelPos = Vec2::null;
+    StateManager::markDirty(entity);
+
+    m_freeProjectiles[entityType].push_back(entity);
+}
+
 uint32_t ProjectileManager::getHit(const Feet& pos) const
 {
-    auto entity = m_stateMan->gameMap().getEntity(MapLayerType::STATIC, pos.toTile());
+    auto& gameMap = m_stateMan->gameMap();
+    const auto tile = pos.toTile();
+
+    auto entity = gameMap.getEntity(MapLayerType::STATIC, tile);
     if (entity != entt::null)
     {
         return entity;
     }
 
-    auto units = m_stateMan->getUnitsAround(pos, std::nullopt, std::nullopt);
-    for (auto unit : units)
+    // Units overlapping the position might be standing on the neighbouring tiles
+    for (int x = tile.x - 1; x <= tile.x + 1; ++x)
     {
-        auto& unitTransform = m_stateMan->getComponent<CompTransform>(unit);
-
-        auto hit = maths::isOverlapping(unitTransform.position, unitTransform.collisionRadius, pos);
-        if (hit)
+        for (int y = tile.y - 1; y <= tile.y + 1; ++y)
         {
-            return unit;
+            Tile neighbour(x, y);
+            if (not gameMap.isValidPos(neighbour))
+                continue;
+
+            for (auto unit : gameMap.getEntities(MapLayerType::UNITS, neighbour))
+            {
+                auto& unitTransform = m_stateMan->getComponent<CompTransform>(unit);
+
+                auto hit = maths::isOverlapping(unitTransform.position,
+                                                unitTransform.collisionRadius, pos);
+                if (hit)
+                {
+                    return unit;
+                }
+            }
         }
     }
     return entt::null;
@@ -149,4 +233,47 @@ float ProjectileManager::getDamage(const ProjectileProperties& projectile,
     }
     totalDamage = std::max(1.0f, totalDamage * (1.0f - target.damageResistance.value()));
     return totalDamage;
-}
\ No newline at end of file
+}
+
+void ProjectileManager::Flights::add(uint32_t projectile,
+                                     uint32_t projectileType,
+                                     const CompProjectile& properties,
+                                     const Feet& position)
+{
+    entity.push_back(projectile);
+    entityType.push_back(projectileType);
+    x.push_back(position.x);
+    y.push_back(position.y);
+    directionX.push_back(properties.direction.x);
+    directionY.push_back(properties.direction.y);
+    speed.push_back(properties.speed);
+    targetX.push_back(properties.targetPosition.x);
+    targetY.push_back(properties.targetPosition.y);
+    originX.push_back(properties.originPosition.x);
+    originY.push_back(properties.originPosition.y);
+    rangeSq.push_back(properties.rangeSq);
+    damageMode.push_back(properties.damageMode);
+}
+
+void ProjectileManager::Flights::remove(size_t index)
+{
+    auto removeAt = [index](auto& values)
+    {
+        values[index] = values.back();
+        values.pop_back();
+    };
+
+    removeAt(entity);
+    removeAt(entityType);
+    removeAt(x);
+    removeAt(y);
+    removeAt(directionX);
+    removeAt(directionY);
+    removeAt(speed);
+    removeAt(targetX);
+    removeAt(targetY);
+    removeAt(originX);
+    removeAt(originY);
+    removeAt(rangeSq);
+    removeAt(damageMode);
+}
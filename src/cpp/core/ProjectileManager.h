@@ -1,28 +1,84 @@
 #ifndef CORE_PROJECTILEMANAGER_H
 #define CORE_PROJECTILEMANAGER_H
+#include "EntityFactory.h"
 #include "EventHandler.h"
 #include "StateManager.h"
 #include "components/CompArmor.h"
+#include "components/CompProjectile.h"
+
+#include <unordered_map>
+#include <vector>
 
 namespace core
 {
 class StateManager;
 
+/*
+ *   Simulates the projectiles in flight. Flight state is kept as a structure of
+ *   arrays and advanced with plain loops over it, components are only touched to
+ *   publish the new positions and on hits.
+ *
+ *   Projectile entities are recycled per entity type rather than destroyed, since
+ *   massed archers create and retire them at a high rate.
+ */
 class ProjectileManager : public EventHandler
 {
   public:
     ProjectileManager();
 
   private:
+    // Projectiles in flight, index i of every array belongs to the same projectile
+    struct Flights
+    {
+        std::vector<uint32_t> entity;
+        std::vector<uint32_t> entityType;
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> directionX;
+        std::vector<float> directionY;
+        std::vector<float> speed;
+        std::vector<float> targetX;
+        std::vector<float> targetY;
+        std::vector<float> originX;
+        std::vector<float> originY;
+        std::vector<float> rangeSq;
+        std::vector<ProjectileDamageMode> damageMode;
+
+        size_t size() const
+        {
+            return entity.size();
+        }
+
+        void add(uint32_t projectile,
+                 uint32_t projectileType,
+                 const CompProjectile& properties,
+                 const Feet& position);
+        void remove(size_t index);
+    };
+
+    enum class Arrival : uint8_t
+    {
+        IN_FLIGHT = 0,
+        AT_TARGET,
+        OUT_OF_RANGE
+    };
+
     bool onTick(const Event& e);
     bool onProjectileCreate(const Event& e);
+    uint32_t acquireProjectile(uint32_t entityType);
+    void releaseProjectile(uint32_t entity, uint32_t entityType);
+    void publishPositions();
+    void onArrival(size_t index, Arrival arrival);
     uint32_t getHit(const Feet& pos) const;
     float getDamage(const ProjectileProperties& projectile, const CompArmor& target) const;
 
   private:
-    std::list<uint32_t> m_projectilesTracking;
+    Flights m_flights;
+    std::vector<Arrival> m_arrivals;
+    std::unordered_map<uint32_t, std::vector<uint32_t>> m_freeProjectiles; // by entity type
     LazyServiceRef<StateManager> m_stateMan;
     LazyServiceRef<Settings> m_settings;
+    LazyServiceRef<EntityFactory> m_entityFactory;
 
     const int PROJECTILE_COLLISION_RADIUS = 10;
 };
@@ -4,8 +4,10 @@
 #include "Coordinates.h"
 #include "EventLoop.h"
 #include "FPSCounter.h"
+#include "GraphicsDelta.h"
 #include "GraphicsLoader.h"
 #include "GraphicsRegistry.h"
+#include "InputEventQueue.h"
 #include "RenderingContext.h"
 #include "SDL3_gfxPrimitives.h"
 #include "ServiceRegistry.h"
@@ -21,7 +23,6 @@
 #include "components/CompRendering.h"
 #include "components/CompTransform.h"
 #include "logging/Logger.h"
-#include "utils/ObjectPool.h"
 
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_video.h>
@@ -58,6 +59,11 @@ struct FontAtlas
     int atlasWidth = 0;
     int atlasHeight = 0;
 };
+
+// Tag of the rendering components whose frame the renderer advances (see AnimationPlayback)
+struct PlayingAnimation
+{
+};
 } // namespace core
 
 FontAtlas createFontAtlas(SDL_Renderer* renderer, TTF_Font* font, int padding = 2)
@@ -239,12 +245,17 @@ class RendererImpl
     void renderImGui();
     void cleanup();
     bool handleEvents();
+    void forwardInputEvent(const SDL_Event& event);
     void updateRenderingComponents();
+    void applyGraphicsDelta(const GraphicsDelta& delta, int tick);
+    bool applyPlayback(uint32_t entity, CompRendering& rc, int tick);
+    bool setFrame(CompRendering& rc, int frame) const;
+    void advanceAnimations();
     void renderDebugInfo(FPSCounter& counter);
     void renderGameEntities();
     void renderCursor();
     bool isReady() const;
-    void renderTexture(SDL_FRect& dstRect, CompRendering* rc);
+    void renderTexture(SDL_FRect& dstRect, CompRendering* rc, bool inFog = false);
     void renderText(const Vec2& screenPos, const std::string& text, const Color& color);
     void renderGraphicAddons(const Vec2& screenPos, CompRendering* rc);
     void renderGraphicAddonsAfterParent(const Vec2& screenPos, CompRendering* rc);
@@ -266,6 +277,7 @@ class RendererImpl
     std::thread m_renderThread;
     std::atomic<bool> m_running = false;
     LazyServiceRef<Settings> m_settings;
+    LazyServiceRef<InputEventQueue> m_inputQueue;
     GraphicsRegistry& m_graphicsRegistry;
 
     std::condition_variable m_sdlInitCV;
@@ -290,7 +302,7 @@ class RendererImpl
     bool m_isSelecting = false;
 
     StatsCounter<uint64_t> m_frameTime;
-    StatsCounter<uint64_t> m_waitTime;
+    StatsCounter<uint64_t> m_framesPerRender; // Simulation frames per new frame received
 
     size_t m_texturesDrew = 0;
 
@@ -303,12 +315,14 @@ class RendererImpl
     FontAtlas m_fontAtlas;
 
     bool m_showFogOfWar = true;
+    FogOfWar m_fogOfWar; // Kept up to date by the deltas from the simulator
 
     volatile bool m_isReady = false;
 
     GraphicsID m_currentCursor;
 
     entt::basic_registry<uint32_t> m_registry;
+    CompRendering m_beforeUpdate; // Reused for the z-order updates
 };
 
 void RendererImpl::renderImGui()
@@ -459,10 +473,18 @@ void RendererImpl::renderingLoop()
     bool running = true;
     FPSCounter fpsCounter;
 
+    int lastFrame = 0;
+
     while (running)
     {
-        auto frame = m_synchronizer.getReceiverFrameData().frameNumber;
-        // spdlog::info("Rendering frame {}", frame);
+        // Simulation runs at its own rate, the latest frame (if any) carries everything since
+        // the last one taken
+        if (m_synchronizer.receive())
+        {
+            const auto frame = m_synchronizer.getReceiverFrameData().frameNumber;
+            m_framesPerRender.addSample(frame - lastFrame);
+            lastFrame = frame;
+        }
 
         auto start = SDL_GetTicks();
         fpsCounter.frame();
@@ -475,7 +497,9 @@ void RendererImpl::renderingLoop()
         }
         generateTicks();
 
+        m_fogOfWar.applyDelta(m_synchronizer.getReceiverFrameData().fogOfWarDelta);
         updateRenderingComponents();
+        advanceAnimations();
         renderBackground();
         renderGameEntities();
         renderSelectionBox();
@@ -487,12 +511,6 @@ void RendererImpl::renderingLoop()
 
         m_frameTime.addSample(SDL_GetTicks() - start);
 
-        auto waitStart = SDL_GetTicks();
-
-        if (!EventLoop::isPaused())
-            m_synchronizer.waitForSender();
-        m_waitTime.addSample(SDL_GetTicks() - waitStart);
-
         int delay = (1000 / m_settings->getTargetFPS()) - (SDL_GetTicks() - start);
         delay = std::max(1, delay);
 
@@ -501,7 +519,7 @@ void RendererImpl::renderingLoop()
         fpsCounter.sleptFor(delay);
         fpsCounter.getTotalSleep();
 
-        m_waitTime.resetIfCountIs(1000);
+        m_framesPerRender.resetIfCountIs(1000);
         m_frameTime.resetIfCountIs(1000);
 
         m_isReady = true;
@@ -518,7 +536,6 @@ void RendererImpl::renderingLoop()
 
     SDL_DestroyWindow(m_window);
     SDL_Quit();
-    m_synchronizer.shutdown();
     m_stopSource->request_stop();
 }
 
@@ -541,11 +558,14 @@ void RendererImpl::renderCursor()
     }
 }
 
-void RendererImpl::renderTexture(SDL_FRect& dstRect, CompRendering* rc)
+// Entities on explored tiles, which are not currently visible, are drawn darker
+void RendererImpl::renderTexture(SDL_FRect& dstRect, CompRendering* rc, bool inFog)
 {
     if (dstRect.w > 0 && dstRect.h > 0 && rc->texture != nullptr)
     {
-        SDL_SetTextureColorMod(rc->texture, rc->shading.r, rc->shading.g, rc->shading.b);
+        const int divisor = inFog ? 2 : 1;
+        SDL_SetTextureColorMod(rc->texture, rc->shading.r / divisor, rc->shading.g / divisor,
+                               rc->shading.b / divisor);
         SDL_RenderTextureRotated(m_renderer, rc->texture, &(rc->srcRect), &dstRect, 0, nullptr,
                                  rc->flip);
         ++m_texturesDrew;
@@ -577,6 +597,8 @@ bool RendererImpl::handleEvents()
         {
             return false;
         }
+        forwardInputEvent(event);
+
         // handle mouse click events
         if (event.type == SDL_EVENT_MOUSE_BUTTON_DOWN)
         {
@@ -626,104 +648,162 @@ bool RendererImpl::handleEvents()
     return true;
 }
 
+// Pass the input to the simulation. It will be consumed at the next tick boundary.
+void RendererImpl::forwardInputEvent(const SDL_Event& event)
+{
+    InputEvent input;
+    input.timestampNs = event.common.timestamp;
+
+    switch (event.type)
+    {
+    case SDL_EVENT_KEY_DOWN:
+    case SDL_EVENT_KEY_UP:
+        if (event.key.repeat)
+            return;
+        input.type =
+            event.type == SDL_EVENT_KEY_DOWN ? Event::Type::KEY_DOWN : Event::Type::KEY_UP;
+        input.keyCode = event.key.scancode;
+        break;
+    case SDL_EVENT_MOUSE_MOTION:
+        input.type = Event::Type::MOUSE_MOVE;
+        input.screenPos = Vec2(event.motion.x, event.motion.y);
+        break;
+    case SDL_EVENT_MOUSE_BUTTON_DOWN:
+    case SDL_EVENT_MOUSE_BUTTON_UP:
+        if (event.button.button == SDL_BUTTON_LEFT)
+            input.button = MouseClickData::Button::LEFT;
+        else if (event.button.button == SDL_BUTTON_RIGHT)
+            input.button = MouseClickData::Button::RIGHT;
+        else
+            return;
+        input.type = event.type == SDL_EVENT_MOUSE_BUTTON_DOWN ? Event::Type::MOUSE_BTN_DOWN
+                                                               : Event::Type::MOUSE_BTN_UP;
+        input.screenPos = Vec2(event.button.x, event.button.y);
+        break;
+    default:
+        return;
+    }
+    m_inputQueue->push(input);
+}
+
 /**
- * @brief Updates the graphic components by processing messages from the simulator.
- *
- * This function handles graphic instructions by dequeuing messages from the simulator queue
- * and processing their command buffers. It updates the graphics components of entities
- * based on the instructions provided in the messages. If a texture is not found for an entity,
- * an error is logged. Invalid message types or other unexpected conditions will throw
- * exceptions.
+ * @brief Updates the rendering components by the graphic records from the simulator.
  *
- * @throws std::runtime_error If a message with an invalid type is encountered.
+ * Records carry only the changes of the entities (see GraphicsDelta), they are applied in
+ * place to the rendering components. Textures not loaded yet are loaded before applying any,
+ * since the records must be applied in order.
  */
 void RendererImpl::updateRenderingComponents()
 {
-    // spdlog::debug("Handling graphic instructions...");
-    auto& frameData = m_synchronizer.getReceiverFrameData().graphicUpdates;
+    auto& updates = m_synchronizer.getReceiverFrameData().graphicUpdates;
+    const auto tick = m_synchronizer.getReceiverFrameData().tick;
+
     std::list<GraphicsID> idsNeedToLoad;
-    std::list<CompGraphics*> lazyLoadedInstructions;
+    updates.forEach(
+        [&](const GraphicsDelta& delta)
+        {
+            if ((delta.changed & GraphicsDelta::ID) and not m_graphicsRegistry.hasTexture(delta.id))
+                idsNeedToLoad.push_back(delta.id);
+        });
 
-    for (const auto& instruction : frameData)
+    if (idsNeedToLoad.empty() == false)
     {
-        uint32_t entity = instruction->entityID;
-        if (not m_registry.all_of<CompRendering>(instruction->entityID))
-        {
-            entity = m_registry.create(instruction->entityID);
-            debug_assert(entity == instruction->entityID,
-                         "Entity ID mismatch between simulation and renderer");
-            m_registry.emplace_or_replace<CompRendering>(entity, CompRendering());
-        }
+        AtlasGeneratorBasic atlasGenerator;
+        m_graphicsLoader.loadGraphics(*m_renderer, m_graphicsRegistry, atlasGenerator,
+                                      idsNeedToLoad);
+    }
 
-        auto& oldRenderingComp = m_registry.get<CompRendering>(entity);
+    updates.forEach([&](const GraphicsDelta& delta) { applyGraphicsDelta(delta, tick); });
+    updates.clear();
+}
 
-        if (m_graphicsRegistry.hasTexture(*instruction))
-        {
-            CompRendering beforeUpdateRendingCompCopy = oldRenderingComp;
-            auto& updatedRenderingComp = oldRenderingComp;
-            static_cast<CompGraphics&>(updatedRenderingComp) = *instruction;
+void RendererImpl::applyGraphicsDelta(const GraphicsDelta& delta, int tick)
+{
+    const uint32_t entity = delta.entityID;
+    if (not m_registry.all_of<CompRendering>(entity))
+    {
+        [[maybe_unused]] auto created = m_registry.create(entity);
+        debug_assert(created == entity, "Entity ID mismatch between simulation and renderer");
+        m_registry.emplace<CompRendering>(entity);
+    }
+    auto& rc = m_registry.get<CompRendering>(entity);
+
+    // Z-order cares about where the entity is and whether it is drawn
+    const uint16_t placementFields = GraphicsDelta::POSITION | GraphicsDelta::VISIBILITY |
+                                     GraphicsDelta::LAND_AREA;
+    const bool isPlacementChanged = delta.changed & placementFields;
+    if (isPlacementChanged)
+    {
+        // Only what the z-order reads of the current, instead of copying the whole component
+        m_beforeUpdate.entityID = rc.entityID;
+        m_beforeUpdate.positionInFeet = rc.positionInFeet;
+        m_beforeUpdate.landArea.tiles.assign(rc.landArea.tiles.begin(), rc.landArea.tiles.end());
+    }
 
-            updatedRenderingComp.additionalZOffset = 0;
+    delta.applyTo(rc);
+    const bool isFrameChanged = applyPlayback(entity, rc, tick);
 
-            // Graphic addons on this entity might draw below (screen's Y) the entity. So we need to
-            // consider the overall bottom most position as the Z value. Eg: Unit's selection
-            // ellipse should draw on top of the below tile
-            for (auto& addon : updatedRenderingComp.addons)
+    if (delta.changed & GraphicsDelta::ADDONS)
+    {
+        // Graphic addons on this entity might draw below (screen's Y) the entity. So we need to
+        // consider the overall bottom most position as the Z value. Eg: Unit's selection
+        // ellipse should draw on top of the below tile
+        rc.additionalZOffset = 0;
+        for (auto& addon : rc.addons)
+        {
+            switch (addon.type)
             {
-                switch (addon.type)
-                {
-                case GraphicAddon::Type::ISO_CIRCLE:
-                    updatedRenderingComp.additionalZOffset = Constants::FEET_PER_TILE + 1;
-                    break;
-                }
+            case GraphicAddon::Type::ISO_CIRCLE:
+                rc.additionalZOffset = Constants::FEET_PER_TILE + 1;
+                break;
             }
-
-            updatedRenderingComp.updateTextureDetails(m_graphicsRegistry);
-            m_zOrderStrategy->onUpdate(beforeUpdateRendingCompCopy, updatedRenderingComp);
-            ObjectPool<CompGraphics>::release(instruction);
-        }
-        else
-        {
-            GraphicsID idToLoad = *instruction; // Slicing
-            idsNeedToLoad.push_back(idToLoad);
-            lazyLoadedInstructions.push_back(instruction);
         }
     }
 
-    if (idsNeedToLoad.empty() == false)
+    if ((delta.changed & GraphicsDelta::ID) or isFrameChanged)
+        rc.updateTextureDetails(m_graphicsRegistry);
+
+    if (isPlacementChanged)
+        m_zOrderStrategy->onUpdate(m_beforeUpdate, rc);
+}
+
+// Instructions carry only the start of a playing animation, the frame follows the tick.
+// Returns true if the frame changed.
+bool RendererImpl::applyPlayback(uint32_t entity, CompRendering& rc, int tick)
+{
+    const bool isPlaying = rc.playback.isPlaying() and rc.playback.action == int(rc.action) and
+                           not rc.isDestroyed;
+    if (not isPlaying)
     {
-        AtlasGeneratorBasic atlasGenerator;
-        m_graphicsLoader.loadGraphics(*m_renderer, m_graphicsRegistry, atlasGenerator,
-                                      idsNeedToLoad);
-        for (auto& instruction : lazyLoadedInstructions)
-        {
-            auto& oldRenderingComp = m_registry.get<CompRendering>(instruction->entityID);
-            auto& updatedRenderingComp = oldRenderingComp;
+        m_registry.remove<PlayingAnimation>(entity);
+        return false;
+    }
+    m_registry.emplace_or_replace<PlayingAnimation>(entity);
+    return setFrame(rc, rc.playback.getFrameAt(tick));
+}
 
-            CompRendering beforeUpdate = oldRenderingComp;
+// Returns true if the frame changed. Frames without a texture (yet) are skipped.
+bool RendererImpl::setFrame(CompRendering& rc, int frame) const
+{
+    GraphicsID id = rc; // Slicing
+    id.frame = frame;
+    if (rc.frame == id.frame or not m_graphicsRegistry.hasTexture(id))
+        return false;
 
-            static_cast<CompGraphics&>(updatedRenderingComp) = *instruction;
-            updatedRenderingComp.additionalZOffset = 0;
+    rc.frame = id.frame;
+    return true;
+}
 
-            // Graphic addons on this entity might draw below (screen's Y) the entity. So we need to
-            // consider the overall bottom most position as the Z value. Eg: Unit's selection
-            // ellipse should draw on top of the below tile
-            for (auto& addon : updatedRenderingComp.addons)
-            {
-                switch (addon.type)
-                {
-                case GraphicAddon::Type::ISO_CIRCLE:
-                    updatedRenderingComp.additionalZOffset = Constants::FEET_PER_TILE + 1;
-                    break;
-                }
-            }
-            updatedRenderingComp.updateTextureDetails(m_graphicsRegistry);
+void RendererImpl::advanceAnimations()
+{
+    const auto tick = m_synchronizer.getReceiverFrameData().tick;
 
-            m_zOrderStrategy->onUpdate(beforeUpdate, updatedRenderingComp);
-            ObjectPool<CompGraphics>::release(instruction);
-        }
+    for (auto [entity, rc] : m_registry.view<PlayingAnimation, CompRendering>().each())
+    {
+        // Neither the position nor the layer changes, hence z-order stays as is
+        if (setFrame(rc, rc.playback.getFrameAt(tick)))
+            rc.updateTextureDetails(m_graphicsRegistry);
     }
-    frameData.clear();
 }
 
 void RendererImpl::renderDebugInfo(FPSCounter& counter)
@@ -731,7 +811,7 @@ void RendererImpl::renderDebugInfo(FPSCounter& counter)
     addDebugText("Average FPS        : " + std::to_string(counter.getAverageFPS()));
     addDebugText("Avg Sleep/frame    : " + std::to_string(counter.getAverageSleepMs()));
     addDebugText("Avg frame time     : " + std::to_string(m_frameTime.average()));
-    addDebugText("Avg wait time      : " + std::to_string(m_waitTime.average()));
+    addDebugText("Avg sim frames     : " + std::to_string(m_framesPerRender.average()));
     addDebugText("Textures Drew      : " + std::to_string(m_texturesDrew));
 
     if (m_showDebugInfo)
@@ -776,10 +856,14 @@ void RendererImpl::renderDebugInfo(FPSCounter& counter)
 void RendererImpl::renderGameEntities()
 {
     auto& objectsToRender = m_zOrderStrategy->zOrder(m_coordinates);
-    auto& fogOfWar = m_synchronizer.getReceiverFrameData().fogOfWar;
+    // Simulation might tick slower than the rendering, moving graphics are drawn in between
+    // their positions of the last two ticks
+    const auto& frameData = m_synchronizer.getReceiverFrameData();
+    const auto tickProgress = frameData.getTickProgress(steady_clock::now());
 
     for (auto& rc : objectsToRender)
     {
+        bool inFog = false;
         Vec2 screenpos = rc->positionInScreenUnits;
         Vec2 anchorAdjustedScreenPos = rc->positionInScreenUnits - rc->anchor;
 
@@ -798,7 +882,8 @@ void RendererImpl::renderGameEntities()
              *    And this is applicable only if the entity has a parent.
              *  - Component 4: Parent's texture position (after anchor adjustment).
              **/
-            screenpos = m_coordinates.feetToScreenUnits(rc->positionInFeet);
+            screenpos = m_coordinates.feetToScreenUnits(
+                rc->getInterpolatedPosition(tickProgress, frameData.tick));
             anchorAdjustedScreenPos = screenpos - rc->anchor;
 
             // TODO: This should be moved outside of positionInFeet null check since this is
@@ -806,7 +891,8 @@ void RendererImpl::renderGameEntities()
             if (rc->parentEntityId != entt::null and not rc->relativePixelPosition.isNull())
             {
                 CompRendering& parentComp = m_registry.get<CompRendering>(rc->parentEntityId);
-                auto parentScreenpos = m_coordinates.feetToScreenUnits(parentComp.positionInFeet);
+                auto parentScreenpos = m_coordinates.feetToScreenUnits(
+                    parentComp.getInterpolatedPosition(tickProgress, frameData.tick));
                 auto anchorAdjustedParentScreenPos = parentScreenpos - parentComp.anchor;
 
                 auto screenPosRelativeToParent =
@@ -818,15 +904,20 @@ void RendererImpl::renderGameEntities()
                 anchorAdjustedScreenPos += rc->selfRelativePixelPosition;
             }
 
-            if (m_showFogOfWar && fogOfWar.isExplored(rc->positionInFeet.toTile()) == false)
-                continue;
+            if (m_showFogOfWar)
+            {
+                auto revealStatus = m_fogOfWar.getRevealStatus(rc->positionInFeet.toTile());
+                if (revealStatus == RevealStatus::UNEXPLORED)
+                    continue;
+                inFog = revealStatus == RevealStatus::EXPLORED;
+            }
         }
 
         SDL_FRect dstRect = {anchorAdjustedScreenPos.x, anchorAdjustedScreenPos.y, rc->srcRect.w,
                              rc->srcRect.h};
 
         renderGraphicAddons(anchorAdjustedScreenPos, rc);
-        renderTexture(dstRect, rc);
+        renderTexture(dstRect, rc, inFog);
         renderGraphicAddonsAfterParent(anchorAdjustedScreenPos, rc);
         renderDebugOverlays(dstRect, rc);
     }
@@ -1113,8 +1204,7 @@ void RendererImpl::generateTicks()
 void RendererImpl::onTick()
 {
     handleViewportMovement();
-    auto& framedata = m_synchronizer.getReceiverFrameData();
-    framedata.viewportPositionInPixels = m_coordinates.getViewportPositionInPixels();
+    m_synchronizer.setFeedback(m_coordinates.getViewportPositionInPixels());
 }
 
 void RendererImpl::handleViewportMovement()
@@ -0,0 +1,115 @@
+#include "ResourceIndex.h"
+
+#include "StateManager.h"
+#include "components/CompEntityInfo.h"
+#include "components/CompResource.h"
+#include "components/CompTransform.h"
+#include "debug.h"
+#include "logging/Logger.h"
+
+using namespace core;
+
+ResourceIndex::ResourceIndex()
+{
+    // No callbacks of its own, the index is updated from TileMap listener callbacks (i.e.
+    // by whichever system modifies the static layer, which then writes this too) and read
+    // by the commands.
+    declareAccess(SystemAccess()
+                      .reads<TileMap, CompResource, CompTransform, CompEntityInfo>()
+                      .writes<ResourceIndex>());
+}
+
+void ResourceIndex::init(int width, int height)
+{
+    for (auto& grid : m_grids)
+    {
+        grid.init(width, height);
+    }
+    m_locations.clear();
+}
+
+void ResourceIndex::onInit(EventLoop& eventLoop)
+{
+    auto& tileMap = m_stateMan->gameMap();
+    init(tileMap.width, tileMap.height);
+    tileMap.registerListner(shared_from_this());
+
+    // Resources placed on the map before this got registered
+    m_stateMan->getEntities<CompResource, CompTransform, CompEntityInfo>().each(
+        [this](uint32_t entity, CompResource& resource, CompTransform& transform,
+               CompEntityInfo& info)
+        {
+            if (not info.isDestroyed)
+                addResource(entity, resource.original.value().type, transform.position.toTile());
+        });
+}
+
+void ResourceIndex::addResource(uint32_t entity, uint8_t resourceType, const Tile& tile)
+{
+    debug_assert(resourceType < Constants::MAX_RESOURCE_TYPES, "Invalid resource type {}",
+                 resourceType);
+
+    auto [it, added] = m_locations.try_emplace(entity, Location{resourceType, tile});
+    if (added)
+        m_grids[resourceType].insert(entity, tile);
+}
+
+void ResourceIndex::removeResource(uint32_t entity)
+{
+    auto it = m_locations.find(entity);
+    if (it == m_locations.end())
+        return;
+
+    const auto& location = it->second;
+    bool removed = m_grids[location.resourceType].remove(entity, location.tile);
+    debug_assert(removed, "Resource {} is missing in the index", entity);
+    m_locations.erase(it);
+}
+
+void ResourceIndex::onEntityEnter(uint32_t entity, const Tile& tile, MapLayerType layer)
+{
+    if (layer != MapLayerType::STATIC)
+        return;
+
+    if (auto resource = m_stateMan->tryGetComponent<CompResource>(entity))
+        addResource(entity, resource->original.value().type, tile);
+}
+
+void ResourceIndex::onEntityExit(uint32_t entity, const Tile& tile, MapLayerType layer)
+{
+    if (layer == MapLayerType::STATIC)
+        removeResource(entity);
+}
+
+uint32_t ResourceIndex::findNearest(uint8_t resourceType, const Tile& from, int maxRadius) const
+{
+    auto nearest = m_grids[resourceType].findNearest(from, maxRadius, accept());
+    return nearest ? nearest->entity : entt::null;
+}
+
+size_t ResourceIndex::findNearest(uint8_t resourceType,
+                                  const Tile& from,
+                                  int maxRadius,
+                                  std::span<uint32_t> out) const
+{
+    return m_grids[resourceType].findKNearest(from, maxRadius, out, accept());
+}
+
+size_t ResourceIndex::findInRadius(uint8_t resourceType,
+                                   const Tile& from,
+                                   int radius,
+                                   std::span<uint32_t> out) const
+{
+    return m_grids[resourceType].findInRadius(from, radius, out, accept());
+}
+
+bool ResourceIndex::isAvailable(uint32_t entity) const
+{
+    auto [resource, info] = m_stateMan->getComponents<CompResource, CompEntityInfo>(entity);
+    return resource.remainingAmount > 0 and not info.isDestroyed;
+}
+
+size_t ResourceIndex::getResourceCount(uint8_t resourceType) const
+{
+    return m_grids[resourceType].size();
+}
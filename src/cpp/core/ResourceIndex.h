@@ -0,0 +1,85 @@
+#ifndef CORE_RESOURCEINDEX_H
+#define CORE_RESOURCEINDEX_H
+
+#include "EventHandler.h"
+#include "SpatialGrid.h"
+#include "TileMapListner.h"
+#include "utils/Constants.h"
+#include "utils/LazyServiceRef.h"
+
+#include <array>
+#include <entt/entity/registry.hpp>
+#include <memory>
+#include <span>
+#include <unordered_map>
+
+namespace core
+{
+class StateManager;
+
+/*
+ *   Spatial index of the resources on the map, a SpatialGrid per resource type. Kept
+ *   in sync through the TileMap listener, i.e. a resource is indexed when it is added
+ *   to the map and dropped when it is removed from the map (i.e. exhausted).
+ *
+ *   Queried by the gatherers to find the next resource once the current one is
+ *   exhausted, without scanning the tiles around them.
+ */
+class ResourceIndex : public EventHandler,
+                      public TileMapListner,
+                      public std::enable_shared_from_this<ResourceIndex>
+{
+  public:
+    ResourceIndex();
+
+    void init(int width, int height);
+
+    void addResource(uint32_t entity, uint8_t resourceType, const Tile& tile);
+    void removeResource(uint32_t entity);
+
+    // Nearest resource of the type within maxRadius tiles, entt::null if none
+    uint32_t findNearest(uint8_t resourceType,
+                         const Tile& from,
+                         int maxRadius = SpatialGrid::UNLIMITED_RADIUS) const;
+    // Nearest resources of the type within maxRadius tiles, nearest first. Returns the
+    // number of resources written to out.
+    size_t findNearest(uint8_t resourceType,
+                       const Tile& from,
+                       int maxRadius,
+                       std::span<uint32_t> out) const;
+    // Resources of the type within radius tiles. Returns the number written to out.
+    size_t findInRadius(uint8_t resourceType,
+                        const Tile& from,
+                        int radius,
+                        std::span<uint32_t> out) const;
+
+    size_t getResourceCount(uint8_t resourceType) const;
+
+  protected:
+    void onInit(EventLoop& eventLoop) override;
+    void onEntityEnter(uint32_t entity, const Tile& tile, MapLayerType layer) override;
+    void onEntityExit(uint32_t entity, const Tile& tile, MapLayerType layer) override;
+
+  private:
+    struct Location
+    {
+        uint8_t resourceType = 0;
+        Tile tile;
+    };
+
+    // Resources leave the map (hence the index) only once ResourceManager handles their
+    // exhaustion, until then they are still in the grids
+    bool isAvailable(uint32_t entity) const;
+
+    auto accept() const
+    {
+        return [this](const SpatialGrid::Item& item) { return isAvailable(item.entity); };
+    }
+
+    LazyServiceRef<StateManager> m_stateMan;
+    std::array<SpatialGrid, Constants::MAX_RESOURCE_TYPES> m_grids;
+    std::unordered_map<uint32_t, Location> m_locations; // by resource entity
+};
+} // namespace core
+
+#endif // CORE_RESOURCEINDEX_H
@@ -27,6 +27,11 @@ class ServiceRegistry
         m_services[std::type_index(typeid(T))] = std::move(service);
     }
 
+    template <typename T> void unregisterService()
+    {
+        m_services.erase(std::type_index(typeid(T)));
+    }
+
     template <typename T> std::shared_ptr<T> getService() const
     {
         auto it = m_services.find(std::type_index(typeid(T)));
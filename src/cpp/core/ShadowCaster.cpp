@@ -0,0 +1,198 @@
+#include "ShadowCaster.h"
+
+#include "TileMap.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+using namespace core;
+
+void ShadowCaster::init(uint32_t width, uint32_t height, size_t capacity)
+{
+    m_width = width;
+    m_height = height;
+    m_blocksPerRow = (m_width + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    m_blockVersions.assign(size_t(m_blocksPerRow) * ((m_height + BLOCK_SIZE - 1) / BLOCK_SIZE),
+                           0);
+    m_version = 0;
+    m_cache.clear();
+    m_capacity = std::max<size_t>(1, capacity);
+    m_useCount = 0;
+}
+
+void ShadowCaster::onOccluderChanged(const Tile& tile)
+{
+    m_blockVersions[tile.y / BLOCK_SIZE * m_blocksPerRow + tile.x / BLOCK_SIZE] = ++m_version;
+}
+
+bool ShadowCaster::isVisible(const TileMap& tileMap,
+                             const Tile& origin,
+                             uint8_t radiusInTiles,
+                             uint32_t viewer,
+                             const Tile& target)
+{
+    const int32_t radius = radiusInTiles;
+    const int32_t dx = target.x - origin.x;
+    const int32_t dy = target.y - origin.y;
+    if (std::abs(dx) > radius or std::abs(dy) > radius)
+        return false;
+
+    const auto& visibility = getVisibility(tileMap, origin, radiusInTiles, viewer);
+    const size_t index = size_t(dy + radius) * (2 * radius + 1) + (dx + radius);
+    return visibility.bits[index / 64] & (uint64_t(1) << (index % 64));
+}
+
+void ShadowCaster::forget(const Tile& origin, uint8_t radiusInTiles)
+{
+    m_cache.erase(getKey(origin, radiusInTiles));
+}
+
+uint64_t ShadowCaster::getKey(const Tile& origin, uint8_t radiusInTiles)
+{
+    return uint64_t(uint16_t(origin.x)) | uint64_t(uint16_t(origin.y)) << 16 |
+           uint64_t(radiusInTiles) << 32;
+}
+
+// Linear, but only when a new origin comes in while full, which is rare
+void ShadowCaster::evictLeastRecentlyUsed()
+{
+    auto oldest = std::min_element(m_cache.begin(), m_cache.end(),
+                                   [](const auto& a, const auto& b)
+                                   { return a.second.lastUse < b.second.lastUse; });
+    if (oldest != m_cache.end())
+        m_cache.erase(oldest);
+}
+
+const ShadowCaster::Visibility& ShadowCaster::getVisibility(const TileMap& tileMap,
+                                                            const Tile& origin,
+                                                            uint8_t radiusInTiles,
+                                                            uint32_t viewer)
+{
+    const uint64_t key = getKey(origin, radiusInTiles);
+    if (m_cache.size() >= m_capacity and not m_cache.contains(key))
+        evictLeastRecentlyUsed();
+
+    auto [it, isNew] = m_cache.try_emplace(key);
+    auto& visibility = it->second;
+    visibility.lastUse = ++m_useCount;
+
+    if (isNew or visibility.viewer != viewer or
+        not isUpToDate(visibility, origin, radiusInTiles))
+    {
+        const size_t side = 2 * size_t(radiusInTiles) + 1;
+        visibility.bits.assign((side * side + 63) / 64, 0);
+        visibility.version = m_version;
+        visibility.viewer = viewer;
+        cast(Cast{tileMap, origin, radiusInTiles, viewer, visibility});
+    }
+    return visibility;
+}
+
+bool ShadowCaster::isUpToDate(const Visibility& visibility,
+                              const Tile& origin,
+                              int32_t radius) const
+{
+    const int32_t minBlockX = std::max(0, origin.x - radius) / BLOCK_SIZE;
+    const int32_t maxBlockX = std::min(m_width - 1, origin.x + radius) / BLOCK_SIZE;
+    const int32_t minBlockY = std::max(0, origin.y - radius) / BLOCK_SIZE;
+    const int32_t maxBlockY = std::min(m_height - 1, origin.y + radius) / BLOCK_SIZE;
+
+    for (int32_t y = minBlockY; y <= maxBlockY; ++y)
+    {
+        for (int32_t x = minBlockX; x <= maxBlockX; ++x)
+        {
+            if (m_blockVersions[y * m_blocksPerRow + x] > visibility.version)
+                return false;
+        }
+    }
+    return true;
+}
+
+void ShadowCaster::cast(const Cast& cast)
+{
+    ++m_castCount;
+    markVisible(cast, 0, 0);
+
+    // Transforms from the octant coordinates (i.e. rows going away from the origin) to
+    // the map ones, one column per octant
+    static constexpr int32_t transforms[4][8] = {{1, 0, 0, -1, -1, 0, 0, 1},
+                                                 {0, 1, -1, 0, 0, -1, 1, 0},
+                                                 {0, 1, 1, 0, 0, -1, -1, 0},
+                                                 {1, 0, 0, 1, -1, 0, 0, -1}};
+    for (int octant = 0; octant < 8; ++octant)
+    {
+        castOctant(cast, 1, 1.0f, 0.0f, transforms[0][octant], transforms[1][octant],
+                   transforms[2][octant], transforms[3][octant]);
+    }
+}
+
+// Scans the rows of the octant from the given one, within the slopes not yet shadowed.
+// Hitting a blocker narrows the rest of the row, and the part before it continues on the
+// next rows recursively.
+void ShadowCaster::castOctant(const Cast& cast,
+                              int32_t row,
+                              float startSlope,
+                              float endSlope,
+                              int32_t xx,
+                              int32_t xy,
+                              int32_t yx,
+                              int32_t yy)
+{
+    if (startSlope < endSlope)
+        return;
+
+    const int32_t radiusSq = cast.radius * cast.radius;
+    float nextStartSlope = 0;
+
+    for (int32_t distance = row; distance <= cast.radius; ++distance)
+    {
+        bool blocked = false;
+        const int32_t dy = -distance;
+        for (int32_t dx = -distance; dx <= 0; ++dx)
+        {
+            const float leftSlope = (dx - 0.5f) / (dy + 0.5f);
+            const float rightSlope = (dx + 0.5f) / (dy - 0.5f);
+            if (startSlope < rightSlope)
+                continue;
+            if (endSlope > leftSlope)
+                break;
+
+            const int32_t mapDx = dx * xx + dy * xy;
+            const int32_t mapDy = dx * yx + dy * yy;
+            const Tile tile(cast.origin.x + mapDx, cast.origin.y + mapDy);
+            const bool isInMap = cast.tileMap.isValidPos(tile);
+
+            if (isInMap and mapDx * mapDx + mapDy * mapDy <= radiusSq)
+                markVisible(cast, mapDx, mapDy);
+
+            const bool isOpaque =
+                isInMap and cast.tileMap.isOccupiedByAnother(MapLayerType::STATIC, tile,
+                                                             cast.viewer);
+            if (blocked)
+            {
+                if (isOpaque)
+                {
+                    nextStartSlope = rightSlope;
+                    continue;
+                }
+                blocked = false;
+                startSlope = nextStartSlope;
+            }
+            else if (isOpaque and distance < cast.radius)
+            {
+                blocked = true;
+                castOctant(cast, distance + 1, startSlope, leftSlope, xx, xy, yx, yy);
+                nextStartSlope = rightSlope;
+            }
+        }
+        if (blocked)
+            break;
+    }
+}
+
+void ShadowCaster::markVisible(const Cast& cast, int32_t dx, int32_t dy)
+{
+    const size_t index =
+        size_t(dy + cast.radius) * (2 * cast.radius + 1) + size_t(dx + cast.radius);
+    cast.visibility.bits[index / 64] |= uint64_t(1) << (index % 64);
+}
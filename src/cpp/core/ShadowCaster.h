@@ -0,0 +1,109 @@
+#ifndef CORE_SHADOWCASTER_H
+#define CORE_SHADOWCASTER_H
+
+#include "Tile.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace core
+{
+class TileMap;
+
+/*
+ *   Tiles visible from an origin tile within a radius, when the entities on the STATIC layer
+ *   of the tile map (i.e. buildings, trees) block the sight. Computed with recursive
+ *   shadowcasting, which visits each tile within the radius once. Blocking tiles are visible
+ *   themselves, and the ones occupied only by the viewer don't block.
+ *
+ *   Results are cached per origin and radius along with the version they were cast at. The
+ *   map is split into blocks stamped with the version of their last occluder change, and a
+ *   result is cast again only if a block within its radius changed since. Callers report
+ *   the changes (see onOccluderChanged).
+ *
+ *   Results of an origin no longer watched (e.g. a tracker moved) are dropped with forget.
+ *   The cache is bounded anyway, and the least recently used result makes room for a new one.
+ */
+class ShadowCaster
+{
+  public:
+    static constexpr int32_t BLOCK_SIZE = 8;        // In tiles
+    static constexpr size_t DEFAULT_CAPACITY = 256; // Cached results
+
+    void init(uint32_t width, uint32_t height, size_t capacity = DEFAULT_CAPACITY);
+
+    // An entity entered or left the STATIC layer on the tile
+    void onOccluderChanged(const Tile& tile);
+
+    bool isVisible(const TileMap& tileMap,
+                   const Tile& origin,
+                   uint8_t radiusInTiles,
+                   uint32_t viewer,
+                   const Tile& target);
+
+    // Drops the cached result of the origin and radius, if any
+    void forget(const Tile& origin, uint8_t radiusInTiles);
+
+    size_t getCastCount() const
+    {
+        return m_castCount;
+    }
+
+    size_t getCachedCount() const
+    {
+        return m_cache.size();
+    }
+
+  private:
+    struct Visibility
+    {
+        uint32_t version = 0;
+        uint32_t viewer = 0;
+        uint64_t lastUse = 0;
+        std::vector<uint64_t> bits; // A bit per tile of the square around the origin
+    };
+
+    struct Cast
+    {
+        const TileMap& tileMap;
+        Tile origin;
+        int32_t radius = 0;
+        uint32_t viewer = 0;
+        Visibility& visibility;
+    };
+
+    static uint64_t getKey(const Tile& origin, uint8_t radiusInTiles);
+    void evictLeastRecentlyUsed();
+    const Visibility& getVisibility(const TileMap& tileMap,
+                                    const Tile& origin,
+                                    uint8_t radiusInTiles,
+                                    uint32_t viewer);
+    bool isUpToDate(const Visibility& visibility, const Tile& origin, int32_t radius) const;
+    void cast(const Cast& cast);
+    void castOctant(const Cast& cast,
+                    int32_t row,
+                    float startSlope,
+                    float endSlope,
+                    int32_t xx,
+                    int32_t xy,
+                    int32_t yx,
+                    int32_t yy);
+    static void markVisible(const Cast& cast, int32_t dx, int32_t dy);
+
+  private:
+    int32_t m_width = 0;
+    int32_t m_height = 0;
+    int32_t m_blocksPerRow = 0;
+    std::vector<uint32_t> m_blockVersions;
+    uint32_t m_version = 0;
+    // By origin and radius, trackers are mostly buildings, hence the origins are few
+    std::unordered_map<uint64_t, Visibility> m_cache;
+    size_t m_capacity = DEFAULT_CAPACITY;
+    uint64_t m_useCount = 0;
+    size_t m_castCount = 0;
+};
+} // namespace core
+
+#endif // CORE_SHADOWCASTER_H
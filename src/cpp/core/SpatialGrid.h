@@ -0,0 +1,338 @@
+#ifndef CORE_SPATIALGRID_H
+#define CORE_SPATIALGRID_H
+
+#include "Tile.h"
+#include "debug.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace core
+{
+/*
+ *   Uniform bucket grid of point-like entities (e.g. resources, drop-off points) for
+ *   nearest and radius queries on tiles. Each bucket covers bucketSize x bucketSize
+ *   tiles, hence a query touches only the buckets around the queried tile instead of
+ *   every tile or every entity.
+ *
+ *   Nearest queries search the buckets ring by ring and stop as soon as no further
+ *   ring can have a closer entity, i.e. the cost depends on the distance to the
+ *   result rather than the search radius. Distances are Euclidean, in tiles. Queries
+ *   don't allocate.
+ *
+ *   The grid doesn't know the entities' positions, callers must pass the tile an
+ *   entity was inserted with to remove or move it.
+ */
+class SpatialGrid
+{
+  public:
+    static constexpr int DEFAULT_BUCKET_SIZE = 8;
+    static constexpr int UNLIMITED_RADIUS = std::numeric_limits<int16_t>::max();
+    // Upper bound of the results of a k-nearest query
+    static constexpr size_t MAX_NEAREST_COUNT = 32;
+
+    struct Item
+    {
+        uint32_t entity = 0;
+        Tile tile;
+    };
+
+    struct AcceptAll
+    {
+        constexpr bool operator()(const Item&) const
+        {
+            return true;
+        }
+    };
+
+    static int getDistanceSquared(const Tile& a, const Tile& b)
+    {
+        const int dx = a.x - b.x;
+        const int dy = a.y - b.y;
+        return dx * dx + dy * dy;
+    }
+
+    void init(int width, int height, int bucketSize = DEFAULT_BUCKET_SIZE)
+    {
+        debug_assert(bucketSize > 0, "Invalid bucket size {}", bucketSize);
+
+        m_bucketSize = bucketSize;
+        m_bucketsX = std::max(1, (width + bucketSize - 1) / bucketSize);
+        m_bucketsY = std::max(1, (height + bucketSize - 1) / bucketSize);
+        m_buckets.assign(m_bucketsX * m_bucketsY, {});
+        m_size = 0;
+    }
+
+    void clear()
+    {
+        for (auto& bucket : m_buckets)
+        {
+            bucket.clear();
+        }
+        m_size = 0;
+    }
+
+    bool isInitialized() const
+    {
+        return not m_buckets.empty();
+    }
+
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    void insert(uint32_t entity, const Tile& tile)
+    {
+        getBucket(tile).push_back(Item{entity, tile});
+        ++m_size;
+    }
+
+    // Returns false if the entity isn't in the grid at the tile's bucket
+    bool remove(uint32_t entity, const Tile& tile)
+    {
+        auto& bucket = getBucket(tile);
+        for (auto& item : bucket)
+        {
+            if (item.entity == entity)
+            {
+                item = bucket.back();
+                bucket.pop_back();
+                --m_size;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Returns false if the entity isn't in the grid at the from tile's bucket
+    bool move(uint32_t entity, const Tile& from, const Tile& to)
+    {
+        auto& fromBucket = getBucket(from);
+        auto& toBucket = getBucket(to);
+
+        if (&fromBucket == &toBucket)
+        {
+            for (auto& item : fromBucket)
+            {
+                if (item.entity == entity)
+                {
+                    item.tile = to;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        if (not remove(entity, from))
+            return false;
+
+        insert(entity, to);
+        return true;
+    }
+
+    // Nearest accepted entity within maxRadius tiles (inclusive), if any
+    template <typename Accept = AcceptAll>
+    std::optional<Item> findNearest(const Tile& from,
+                                    int maxRadius = UNLIMITED_RADIUS,
+                                    Accept&& accept = {}) const
+    {
+        std::optional<Item> nearest;
+        int limit = maxRadius * maxRadius;
+
+        visitNearestFirst(
+            from, [&]() { return limit; },
+            [&](const Item& item, int distance)
+            {
+                if ((not nearest or distance < limit) and accept(item))
+                {
+                    nearest = item;
+                    limit = distance;
+                }
+            });
+        return nearest;
+    }
+
+    /*
+     *   Writes the accepted entities within maxRadius tiles to out, nearest first, at
+     *   most out.size() (capped at MAX_NEAREST_COUNT) of them. Returns the number of
+     *   entities written.
+     */
+    template <typename Accept = AcceptAll>
+    size_t findKNearest(const Tile& from,
+                        int maxRadius,
+                        std::span<uint32_t> out,
+                        Accept&& accept = {}) const
+    {
+        debug_assert(out.size() <= MAX_NEAREST_COUNT, "Too many results requested: {}",
+                     out.size());
+
+        const size_t capacity = std::min(out.size(), MAX_NEAREST_COUNT);
+        if (capacity == 0)
+            return 0;
+
+        std::array<std::pair<int, uint32_t>, MAX_NEAREST_COUNT> found; // distance, entity
+        size_t count = 0;
+        const int maxDistance = maxRadius * maxRadius;
+
+        visitNearestFirst(
+            from,
+            [&]() { return count < capacity ? maxDistance : found[count - 1].first - 1; },
+            [&](const Item& item, int distance)
+            {
+                if (not accept(item))
+                    return;
+
+                // Keep sorted by distance, dropping the farthest if full
+                size_t index = std::min(count, capacity - 1);
+                while (index > 0 and found[index - 1].first > distance)
+                {
+                    found[index] = found[index - 1];
+                    --index;
+                }
+                found[index] = {distance, item.entity};
+                count = std::min(count + 1, capacity);
+            });
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            out[i] = found[i].second;
+        }
+        return count;
+    }
+
+    // Invokes fn(item, distanceSquared) for every entity within radius tiles (inclusive)
+    template <typename Fn> void forEachInRadius(const Tile& from, int radius, Fn&& fn) const
+    {
+        if (m_size == 0)
+            return;
+
+        const int radiusSquared = radius * radius;
+        const int minX = getBucketX(from.x - radius);
+        const int maxX = getBucketX(from.x + radius);
+        const int minY = getBucketY(from.y - radius);
+        const int maxY = getBucketY(from.y + radius);
+
+        for (int by = minY; by <= maxY; ++by)
+        {
+            for (int bx = minX; bx <= maxX; ++bx)
+            {
+                for (const auto& item : m_buckets[by * m_bucketsX + bx])
+                {
+                    auto distance = getDistanceSquared(from, item.tile);
+                    if (distance <= radiusSquared)
+                        fn(item, distance);
+                }
+            }
+        }
+    }
+
+    /*
+     *   Writes the accepted entities within radius tiles to out, in no particular
+     *   order, until out is full. Returns the number of entities written.
+     */
+    template <typename Accept = AcceptAll>
+    size_t findInRadius(const Tile& from,
+                        int radius,
+                        std::span<uint32_t> out,
+                        Accept&& accept = {}) const
+    {
+        size_t count = 0;
+        forEachInRadius(from, radius,
+                        [&](const Item& item, int)
+                        {
+                            if (count < out.size() and accept(item))
+                                out[count++] = item.entity;
+                        });
+        return count;
+    }
+
+  private:
+    int getBucketX(int x) const
+    {
+        return std::clamp(x / m_bucketSize, 0, m_bucketsX - 1);
+    }
+
+    int getBucketY(int y) const
+    {
+        return std::clamp(y / m_bucketSize, 0, m_bucketsY - 1);
+    }
+
+    std::vector<Item>& getBucket(const Tile& tile)
+    {
+        debug_assert(not m_buckets.empty(), "SpatialGrid is not initialized");
+        return m_buckets[getBucketY(tile.y) * m_bucketsX + getBucketX(tile.x)];
+    }
+
+    /*
+     *   Visits the buckets ring by ring around the tile's bucket, calling
+     *   fn(item, distanceSquared) for the items within limit() squared tiles. Stops
+     *   once the next ring can't have an item within the limit, which fn may lower.
+     */
+    template <typename Limit, typename Fn>
+    void visitNearestFirst(const Tile& from, Limit&& limit, Fn&& fn) const
+    {
+        if (m_size == 0)
+            return;
+
+        const int centerX = getBucketX(from.x);
+        const int centerY = getBucketY(from.y);
+        const int maxRing = std::max({centerX, centerY, m_bucketsX - 1 - centerX,
+                                      m_bucketsY - 1 - centerY});
+
+        auto visitBucket = [&](int bx, int by)
+        {
+            if (bx < 0 or by < 0 or bx >= m_bucketsX or by >= m_bucketsY)
+                return;
+
+            for (const auto& item : m_buckets[by * m_bucketsX + bx])
+            {
+                auto distance = getDistanceSquared(from, item.tile);
+                if (distance <= limit())
+                    fn(item, distance);
+            }
+        };
+
+        visitBucket(centerX, centerY);
+
+        for (int ring = 1; ring <= maxRing; ++ring)
+        {
+            // Every tile of this ring is at least this far on one of the axes
+            const int gap = (ring - 1) * m_bucketSize + 1;
+            if (gap * gap > limit())
+                break;
+
+            for (int bx = centerX - ring; bx <= centerX + ring; ++bx)
+            {
+                visitBucket(bx, centerY - ring);
+                visitBucket(bx, centerY + ring);
+            }
+            for (int by = centerY - ring + 1; by < centerY + ring; ++by)
+            {
+                visitBucket(centerX - ring, by);
+                visitBucket(centerX + ring, by);
+            }
+        }
+    }
+
+    int m_bucketSize = DEFAULT_BUCKET_SIZE;
+    int m_bucketsX = 0;
+    int m_bucketsY = 0;
+    std::vector<std::vector<Item>> m_buckets;
+    size_t m_size = 0;
+};
+} // namespace core
+
+#endif // CORE_SPATIALGRID_H
@@ -54,16 +54,33 @@ bool StateManager::isRendererReady() const
 
 void StateManager::clearDirtyEntities()
 {
+    t_dirtyEntities.clear();
     g_dirtyEntities.clear();
 }
 
 void StateManager::markDirty(uint32_t entityId)
 {
-    g_dirtyEntities.insert(entityId);
+    t_dirtyEntities.push_back(entityId);
+}
+
+void StateManager::markDirty(std::span<const uint32_t> entityIds)
+{
+    t_dirtyEntities.insert(t_dirtyEntities.end(), entityIds.begin(), entityIds.end());
+}
+
+void StateManager::mergeDirtyEntities()
+{
+    if (t_dirtyEntities.empty())
+        return;
+
+    std::lock_guard<std::mutex> lock(g_dirtyEntitiesMutex);
+    g_dirtyEntities.insert(t_dirtyEntities.begin(), t_dirtyEntities.end());
+    t_dirtyEntities.clear();
 }
 
 std::set<uint32_t>& StateManager::getDirtyEntities()
 {
+    mergeDirtyEntities();
     return g_dirtyEntities;
 }
 
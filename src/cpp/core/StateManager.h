@@ -8,6 +8,8 @@
 #include "utils/LazyServiceRef.h"
 
 #include <entt/entity/registry.hpp>
+#include <mutex>
+#include <span>
 #include <vector>
 
 namespace core
@@ -113,8 +115,19 @@ class StateManager
 
     bool isRendererReady() const;
 
+    // Includes the ones marked by the calling thread, and by other threads up to their last
+    // mergeDirtyEntities
     static std::set<uint32_t>& getDirtyEntities();
+    // Thread-safe and lock free, systems running concurrently can mark entities dirty. Marks
+    // are kept per thread until merged.
     static void markDirty(uint32_t entityId);
+    static void markDirty(std::span<const uint32_t> entityIds);
+    // Moves the marks of the calling thread to the shared set. Called by SystemScheduler
+    // before dispatching a tick on the dispatching thread, and once a system is done before
+    // its dependents start. Hence the pool threads keep no marks outside a system.
+    static void mergeDirtyEntities();
+    // Clears the shared set and the marks of the calling thread. Marks of the systems still
+    // running concurrently are merged after, i.e. they are dirty for the next tick.
     static void clearDirtyEntities();
 
   private:
@@ -127,6 +140,8 @@ class StateManager
     DensityGrid m_densityGrid;
 
     inline static std::set<uint32_t> g_dirtyEntities;
+    inline static std::mutex g_dirtyEntitiesMutex;
+    inline static thread_local std::vector<uint32_t> t_dirtyEntities;
 };
 } // namespace core
 
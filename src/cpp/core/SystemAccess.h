@@ -0,0 +1,91 @@
+#ifndef CORE_SYSTEMACCESS_H
+#define CORE_SYSTEMACCESS_H
+
+#include <algorithm>
+#include <typeindex>
+#include <vector>
+
+namespace core
+{
+// Tags for shared state which is neither a component nor a service
+struct EntityLifetime // Creating or destroying entities (i.e. structural registry changes)
+{
+};
+struct DirtyEntities // StateManager's dirty entity set
+{
+};
+
+/*
+ *   Data a system touches while processing a TICK. Components, services and the
+ *   above tags are identified by their types.
+ *
+ *   - reads   : Only reads
+ *   - writes  : Reads and modifies
+ *   - appends : Only inserts in a thread-safe and order independent manner (e.g.
+ *               StateManager::markDirty). Appending systems can run together, but
+ *               not with systems reading or writing the same data.
+ *
+ *   Two systems conflict if one writes what the other touches in any way, or if one
+ *   appends to what the other reads. Non conflicting systems might run concurrently.
+ *
+ *   Note: Component pools are assumed to exist already (i.e. created while the world
+ *   is loaded), accessing components doesn't change the registry structure.
+ */
+class SystemAccess
+{
+  public:
+    template <typename... T> SystemAccess& reads()
+    {
+        (add<T>(m_reads), ...);
+        return *this;
+    }
+
+    template <typename... T> SystemAccess& writes()
+    {
+        (add<T>(m_writes), ...);
+        return *this;
+    }
+
+    template <typename... T> SystemAccess& appends()
+    {
+        (add<T>(m_appends), ...);
+        return *this;
+    }
+
+    bool conflictsWith(const SystemAccess& other) const
+    {
+        return intersects(m_writes, other.m_reads) or intersects(m_writes, other.m_writes) or
+               intersects(m_writes, other.m_appends) or intersects(other.m_writes, m_reads) or
+               intersects(other.m_writes, m_appends) or intersects(m_appends, other.m_reads) or
+               intersects(other.m_appends, m_reads);
+    }
+
+  private:
+    template <typename T> static void add(std::vector<std::type_index>& types)
+    {
+        std::type_index type(typeid(T));
+        if (std::find(types.begin(), types.end(), type) == types.end())
+        {
+            types.push_back(type);
+        }
+    }
+
+    static bool intersects(const std::vector<std::type_index>& lhs,
+                           const std::vector<std::type_index>& rhs)
+    {
+        for (const auto& type : lhs)
+        {
+            if (std::find(rhs.begin(), rhs.end(), type) != rhs.end())
+                return true;
+        }
+        return false;
+    }
+
+  private:
+    std::vector<std::type_index> m_reads;
+    std::vector<std::type_index> m_writes;
+    std::vector<std::type_index> m_appends;
+};
+} // namespace core
+
+#endif // CORE_SYSTEMACCESS_H
@@ -0,0 +1,150 @@
+#include "SystemScheduler.h"
+
+#include "EventHandler.h"
+#include "EventPublisher.h"
+#include "StateManager.h"
+#include "logging/Logger.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace core
+{
+// Collects events published by a system while it runs on a worker thread
+class BufferedEventPublisher : public EventPublisher
+{
+  public:
+    void publish(const Event& event) override
+    {
+        m_events.push_back(event);
+    }
+
+    // Route publishEvent calls of the current thread to the given publisher
+    static Ref<EventPublisher> redirect(Ref<EventPublisher> publisher)
+    {
+        return exchangePublisher(std::move(publisher));
+    }
+
+    std::vector<Event> m_events;
+};
+} // namespace core
+
+using namespace core;
+
+SystemScheduler::SystemScheduler() = default;
+
+SystemScheduler::~SystemScheduler() = default;
+
+void SystemScheduler::setSystems(const std::list<std::shared_ptr<EventHandler>>& systems)
+{
+    m_nodes.clear();
+    m_isParallel = false;
+
+    for (auto& system : systems)
+    {
+        auto index = m_nodes.size();
+        Node node{.system = system, .publisher = std::make_shared<BufferedEventPublisher>()};
+        auto& access = system->getAccess();
+
+        for (size_t i = 0; i < index; ++i)
+        {
+            auto& other = m_nodes[i];
+            auto& otherAccess = other.system->getAccess();
+            bool conflicts = not access.has_value() or not otherAccess.has_value() or
+                             access->conflictsWith(otherAccess.value());
+            if (conflicts)
+            {
+                other.dependents.push_back(index);
+                ++node.dependencyCount;
+            }
+        }
+        // Not depending on all the previous ones means it can overlap with some
+        if (node.dependencyCount < static_cast<int>(index))
+        {
+            m_isParallel = true;
+        }
+        m_nodes.push_back(std::move(node));
+    }
+
+    m_remainingDependencies = std::make_unique<std::atomic<int>[]>(m_nodes.size());
+
+    if (m_isParallel and m_pool == nullptr)
+    {
+        auto workerCount = std::max(1u, std::thread::hardware_concurrency()) - 1;
+        workerCount = std::min<size_t>(workerCount, m_nodes.size() - 1);
+        m_pool = std::make_unique<TaskPool>(workerCount);
+    }
+    spdlog::info("System scheduler: {} systems, {}", m_nodes.size(),
+                 m_isParallel ? "parallel" : "serial");
+}
+
+void SystemScheduler::dispatch(const Event& event)
+{
+    if (m_isParallel)
+        dispatchConcurrently(event);
+    else
+        dispatchSerially(event);
+}
+
+void SystemScheduler::dispatchSerially(const Event& event)
+{
+    for (auto& node : m_nodes)
+    {
+        bool consumed = node.system->dispatchEvent(event);
+        if (consumed)
+            break;
+    }
+}
+
+void SystemScheduler::dispatchConcurrently(const Event& event)
+{
+    // Marks of the dispatching thread (e.g. input handled on the event loop) go to the shared
+    // set first, since the systems read it on the pool threads
+    StateManager::mergeDirtyEntities();
+
+    for (size_t i = 0; i < m_nodes.size(); ++i)
+    {
+        m_remainingDependencies[i].store(m_nodes[i].dependencyCount, std::memory_order_relaxed);
+    }
+
+    for (size_t i = 0; i < m_nodes.size(); ++i)
+    {
+        if (m_nodes[i].dependencyCount == 0)
+        {
+            m_pool->submit([this, i, &event]() { runNode(i, event); });
+        }
+    }
+    m_pool->waitIdle();
+    // Systems run by waitIdle merged theirs already, i.e. no thread keeps marks past the tick
+    StateManager::mergeDirtyEntities();
+
+    // Commit in the registration order, regardless of the completion order
+    for (auto& node : m_nodes)
+    {
+        for (auto& published : node.publisher->m_events)
+        {
+            publishEvent(published);
+        }
+        node.publisher->m_events.clear();
+    }
+}
+
+void SystemScheduler::runNode(size_t index, const Event& event)
+{
+    auto& node = m_nodes[index];
+
+    auto previous = BufferedEventPublisher::redirect(node.publisher);
+    // Consumption has no meaning when systems run concurrently
+    node.system->dispatchEvent(event);
+    BufferedEventPublisher::redirect(std::move(previous));
+    // Before the dependents, which might read them
+    StateManager::mergeDirtyEntities();
+
+    for (auto dependent : node.dependents)
+    {
+        if (m_remainingDependencies[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            m_pool->submit([this, dependent, &event]() { runNode(dependent, event); });
+        }
+    }
+}
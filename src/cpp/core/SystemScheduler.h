@@ -0,0 +1,71 @@
+#ifndef CORE_SYSTEMSCHEDULER_H
+#define CORE_SYSTEMSCHEDULER_H
+
+#include "Event.h"
+#include "TaskPool.h"
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <vector>
+
+namespace core
+{
+class EventHandler;
+class BufferedEventPublisher;
+
+/*
+ *   Dispatches TICK to the systems (i.e. EventHandlers), running the ones with non
+ *   conflicting declared access (see SystemAccess) concurrently.
+ *
+ *   Approach:
+ *   Systems form a dependency graph in the registration order, a system depends on
+ *   every earlier system it conflicts with. Systems without a declared access
+ *   conflict with all the others, hence they act as barriers. A system is submitted
+ *   to the TaskPool once all its dependencies are completed.
+ *
+ *   Events published by the systems while running concurrently are buffered per
+ *   system and committed in the registration order after all the systems are done.
+ *   So the outcome doesn't depend on the thread timing.
+ *   Entities marked dirty are kept per thread and merged once the marking system
+ *   is done, i.e. before any system depending on it starts.
+ *
+ *   If the graph is a plain chain (e.g. no declarations at all) systems run one by
+ *   one on the calling thread as before, including stopping at a consuming system.
+ */
+class SystemScheduler
+{
+  public:
+    SystemScheduler();
+    ~SystemScheduler();
+
+    void setSystems(const std::list<std::shared_ptr<EventHandler>>& systems);
+    void dispatch(const Event& event);
+
+    bool isParallel() const
+    {
+        return m_isParallel;
+    }
+
+  private:
+    struct Node
+    {
+        std::shared_ptr<EventHandler> system;
+        std::vector<size_t> dependents;
+        int dependencyCount = 0;
+        std::shared_ptr<BufferedEventPublisher> publisher;
+    };
+
+    void dispatchSerially(const Event& event);
+    void dispatchConcurrently(const Event& event);
+    void runNode(size_t index, const Event& event);
+
+  private:
+    std::vector<Node> m_nodes;
+    std::unique_ptr<std::atomic<int>[]> m_remainingDependencies;
+    std::unique_ptr<TaskPool> m_pool;
+    bool m_isParallel = false;
+};
+} // namespace core
+
+#endif // CORE_SYSTEMSCHEDULER_H
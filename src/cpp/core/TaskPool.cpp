@@ -0,0 +1,131 @@
+#include "TaskPool.h"
+
+#include <limits>
+
+using namespace core;
+
+namespace
+{
+// Queue index of the current worker thread, or none for non-worker threads
+thread_local size_t t_workerQueue = std::numeric_limits<size_t>::max();
+} // namespace
+
+TaskPool::TaskPool(size_t workerCount)
+{
+    for (size_t i = 0; i < workerCount + 1; ++i)
+    {
+        m_queues.push_back(std::make_unique<TaskQueue>());
+    }
+    for (size_t i = 0; i < workerCount; ++i)
+    {
+        m_workers.emplace_back(&TaskPool::workerLoop, this, i);
+    }
+}
+
+TaskPool::~TaskPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stopping = true;
+    }
+    m_sleepCV.notify_all();
+
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+void TaskPool::submit(Task task)
+{
+    auto queue = t_workerQueue;
+    if (queue >= m_queues.size())
+    {
+        queue = m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+    }
+
+    m_pendingTasks.fetch_add(1, std::memory_order_acq_rel);
+    {
+        std::lock_guard<std::mutex> lock(m_queues[queue]->mutex);
+        m_queues[queue]->tasks.push_back(std::move(task));
+        m_queuedTasks.fetch_add(1, std::memory_order_acq_rel);
+    }
+    {
+        // Avoid a lost wakeup of a worker which just found all the queues empty
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    m_sleepCV.notify_one();
+}
+
+void TaskPool::waitIdle()
+{
+    const auto externalQueue = m_queues.size() - 1;
+    while (m_pendingTasks.load(std::memory_order_acquire) != 0)
+    {
+        if (not tryRunTask(externalQueue))
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void TaskPool::workerLoop(size_t index)
+{
+    t_workerQueue = index;
+
+    while (true)
+    {
+        if (tryRunTask(index))
+            continue;
+
+        // Tasks running on other threads don't wake the idle ones, only the queued ones do
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_sleepCV.wait(lock,
+                       [this]()
+                       {
+                           return m_stopping or
+                                  m_queuedTasks.load(std::memory_order_acquire) != 0;
+                       });
+        if (m_stopping)
+            break;
+    }
+}
+
+bool TaskPool::tryRunTask(size_t ownQueue)
+{
+    Task task;
+    bool found = tryPop(ownQueue, true, task);
+
+    for (size_t i = 1; not found and i < m_queues.size(); ++i)
+    {
+        found = tryPop((ownQueue + i) % m_queues.size(), false, task);
+    }
+
+    if (found)
+    {
+        task();
+        m_pendingTasks.fetch_sub(1, std::memory_order_acq_rel);
+    }
+    return found;
+}
+
+bool TaskPool::tryPop(size_t queue, bool fromBack, Task& task)
+{
+    auto& taskQueue = *m_queues[queue];
+    std::lock_guard<std::mutex> lock(taskQueue.mutex);
+    if (taskQueue.tasks.empty())
+        return false;
+
+    if (fromBack)
+    {
+        task = std::move(taskQueue.tasks.back());
+        taskQueue.tasks.pop_back();
+    }
+    else
+    {
+        task = std::move(taskQueue.tasks.front());
+        taskQueue.tasks.pop_front();
+    }
+    m_queuedTasks.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
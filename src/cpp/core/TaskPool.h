@@ -0,0 +1,72 @@
+#ifndef CORE_TASKPOOL_H
+#define CORE_TASKPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace core
+{
+/*
+ *   Fixed size worker pool with work stealing.
+ *
+ *   Approach:
+ *   Every worker owns a task deque. A task submitted from a worker goes to its own
+ *   deque (i.e. follow-up tasks stay on the same core), others are distributed in a
+ *   round robin manner. Workers take from the back of their own deque and steal from
+ *   the front of others' when theirs is empty. The thread waiting for the tasks
+ *   (see waitIdle) executes tasks too rather than blocking.
+ */
+class TaskPool
+{
+  public:
+    using Task = std::function<void()>;
+
+    explicit TaskPool(size_t workerCount);
+    ~TaskPool();
+
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    void submit(Task task);
+
+    // Execute and wait until all the submitted tasks (including the ones submitted by
+    // tasks) are completed.
+    void waitIdle();
+
+    size_t getWorkerCount() const
+    {
+        return m_workers.size();
+    }
+
+  private:
+    struct TaskQueue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void workerLoop(size_t index);
+    bool tryRunTask(size_t ownQueue);
+    bool tryPop(size_t queue, bool fromBack, Task& task);
+
+  private:
+    // One queue per worker and an additional one for external submissions
+    std::vector<std::unique_ptr<TaskQueue>> m_queues;
+    std::vector<std::thread> m_workers;
+    std::atomic<size_t> m_pendingTasks = 0; // Queued or running, for waitIdle
+    std::atomic<size_t> m_queuedTasks = 0;  // Idle workers sleep until there is one
+    std::atomic<size_t> m_nextQueue = 0;
+    std::atomic<bool> m_stopping = false;
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_sleepCV;
+};
+} // namespace core
+
+#endif // CORE_TASKPOOL_H
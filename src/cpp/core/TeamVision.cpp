@@ -0,0 +1,171 @@
+#include "TeamVision.h"
+
+#include "Tile.h"
+#include "debug.h"
+#include "utils/Size.h"
+
+#include <algorithm>
+
+using namespace core;
+
+void TeamVision::init(uint32_t width, uint32_t height)
+{
+    m_width = width;
+    m_height = height;
+    m_wordsPerRow = (m_width + FogOfWar::TILES_PER_WORD - 1) / FogOfWar::TILES_PER_WORD;
+    m_words.assign(size_t(m_wordsPerRow) * m_height, 0);
+    m_sightCounts.assign(size_t(m_width) * m_height, 0);
+    m_rowVersions.assign(m_height, 0);
+    m_version = 0;
+    m_id = s_nextId++;
+}
+
+void TeamVision::addSight(const Tile& center, uint32_t lineOfSight)
+{
+    addSightToCircle(center, lineOfSight / Constants::FEET_PER_TILE, 1);
+}
+
+void TeamVision::removeSight(const Tile& center, uint32_t lineOfSight)
+{
+    addSightToCircle(center, lineOfSight / Constants::FEET_PER_TILE, -1);
+}
+
+// Only the tiles the unit stops or starts seeing change, i.e. the difference of the
+// circles in each row.
+void TeamVision::moveSight(const Tile& from, const Tile& to, uint32_t lineOfSight)
+{
+    if (from == to)
+        return;
+
+    const uint8_t radius = lineOfSight / Constants::FEET_PER_TILE;
+    const int32_t minY = std::min(from.y, to.y) - radius;
+    const int32_t maxY = std::max(from.y, to.y) + radius;
+
+    for (int32_t y = std::max(0, minY); y <= std::min(m_height - 1, maxY); ++y)
+    {
+        const auto [oldMinX, oldMaxX] = getSpan(from, radius, y);
+        const auto [newMinX, newMaxX] = getSpan(to, radius, y);
+
+        // Left and right remainders of a span after cutting the other one out
+        auto addDifference = [this, y](int32_t minX, int32_t maxX, int32_t cutMinX,
+                                       int32_t cutMaxX, int delta)
+        {
+            if (cutMinX > cutMaxX)
+            {
+                addSightToRow(y, minX, maxX, delta);
+                return;
+            }
+            addSightToRow(y, minX, std::min(maxX, cutMinX - 1), delta);
+            addSightToRow(y, std::max(minX, cutMaxX + 1), maxX, delta);
+        };
+
+        // Incrementing first to not let the tiles seen by both go dark in between
+        addDifference(newMinX, newMaxX, oldMinX, oldMaxX, 1);
+        addDifference(oldMinX, oldMaxX, newMinX, newMaxX, -1);
+    }
+}
+
+void TeamVision::addSight(const LandArea& landArea, uint32_t lineOfSight)
+{
+    FogOfWar::forEachSpanInRadius(landArea, lineOfSight / Constants::FEET_PER_TILE,
+                                  Size(m_width, m_height),
+                                  [this](int32_t y, int32_t minX, int32_t maxX)
+                                  { addSightToRow(y, minX, maxX, 1); });
+}
+
+void TeamVision::removeSight(const LandArea& landArea, uint32_t lineOfSight)
+{
+    FogOfWar::forEachSpanInRadius(landArea, lineOfSight / Constants::FEET_PER_TILE,
+                                  Size(m_width, m_height),
+                                  [this](int32_t y, int32_t minX, int32_t maxX)
+                                  { addSightToRow(y, minX, maxX, -1); });
+}
+
+void TeamVision::addSights(const TeamVision& other)
+{
+    debug_assert(other.m_width == m_width and other.m_height == m_height,
+                 "Cannot add sights of a differently sized team vision");
+
+    for (size_t i = 0; i < m_sightCounts.size(); ++i)
+    {
+        m_sightCounts[i] += other.m_sightCounts[i];
+    }
+    // Tiles seen by either team count as seen by the merged one
+    for (size_t i = 0; i < m_words.size(); ++i)
+    {
+        m_words[i] |= other.m_words[i];
+    }
+
+    ++m_version;
+    std::fill(m_rowVersions.begin(), m_rowVersions.end(), m_version);
+}
+
+bool TeamVision::isVisible(const Tile& tile) const
+{
+    debug_assert(tile.x >= 0 and tile.x < m_width and tile.y >= 0 and tile.y < m_height,
+                 "Tile ({}, {}) is outside the map", tile.x, tile.y);
+    return m_sightCounts[size_t(tile.y) * m_width + tile.x] > 0;
+}
+
+void TeamVision::addMember(Player* player)
+{
+    if (std::find(m_members.begin(), m_members.end(), player) == m_members.end())
+        m_members.push_back(player);
+}
+
+void TeamVision::removeMember(Player* player)
+{
+    std::erase(m_members, player);
+}
+
+void TeamVision::addSightToRow(int32_t y, int32_t minX, int32_t maxX, int delta)
+{
+    for (int32_t x = minX; x <= maxX; ++x)
+    {
+        addSightToTile(Tile(x, y), delta);
+    }
+}
+
+void TeamVision::addSightToTile(const Tile& tile, int delta)
+{
+    auto& count = m_sightCounts[size_t(tile.y) * m_width + tile.x];
+    debug_assert(delta > 0 or count > 0, "Removing a sight from unseen tile ({}, {})", tile.x,
+                 tile.y);
+    count += delta;
+
+    auto& word = m_words[tile.y * m_wordsPerRow + tile.x / FogOfWar::TILES_PER_WORD];
+    const auto shift = tile.x % FogOfWar::TILES_PER_WORD * 2;
+
+    if (delta > 0 and count == 1)
+    {
+        word |= FogOfWar::Word(0b11) << shift;
+        m_rowVersions[tile.y] = ++m_version;
+    }
+    else if (delta < 0 and count == 0)
+    {
+        word &= ~(FogOfWar::Word(0b10) << shift); // Stays seen
+        m_rowVersions[tile.y] = ++m_version;
+    }
+}
+
+void TeamVision::addSightToCircle(const Tile& center, uint8_t radiusInTiles, int delta)
+{
+    for (int32_t y = std::max(0, center.y - radiusInTiles);
+         y <= std::min(m_height - 1, center.y + radiusInTiles); ++y)
+    {
+        const auto [minX, maxX] = getSpan(center, radiusInTiles, y);
+        addSightToRow(y, minX, maxX, delta);
+    }
+}
+
+std::pair<int32_t, int32_t> TeamVision::getSpan(const Tile& center,
+                                                uint8_t radiusInTiles,
+                                                int32_t y) const
+{
+    const int32_t dy = std::abs(y - center.y);
+    if (dy > radiusInTiles)
+        return {0, -1};
+
+    const int32_t halfWidth = FogOfWar::getCircleSpans(radiusInTiles)[dy];
+    return {std::max(0, center.x - halfWidth), std::min(m_width - 1, center.x + halfWidth)};
+}
@@ -0,0 +1,106 @@
+#ifndef CORE_TEAMVISION_H
+#define CORE_TEAMVISION_H
+
+#include "FogOfWar.h"
+
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace core
+{
+class Player;
+
+/*
+ *   Live sight of a team of allied players, counted per tile once for the whole team.
+ *   The entities of all the members add their sight here, and the fog of war of each
+ *   member derives its visible tiles from it when synced (see FogOfWar::syncVisibility).
+ *
+ *   Tiles are packed the same way as FogOfWar, with the low bit set once seen by the team
+ *   and the high bit while seen. Each row is stamped with the version it changed at, so
+ *   that syncing a fog of war copies only the rows changed since its last sync.
+ *
+ *   Players share a team vision while they are mutual allies (see Player::setAllegiance).
+ *   Each init gives the team a new id, which tells a fog of war that the team it last synced
+ *   with was replaced (even if at the same address).
+ */
+class TeamVision
+{
+  public:
+    void init(uint32_t width, uint32_t height);
+
+    void addSight(const Tile& center, uint32_t lineOfSight);
+    void removeSight(const Tile& center, uint32_t lineOfSight);
+    void moveSight(const Tile& from, const Tile& to, uint32_t lineOfSight);
+    void addSight(const LandArea& landArea, uint32_t lineOfSight);
+    void removeSight(const LandArea& landArea, uint32_t lineOfSight);
+
+    // Adds the sights counted by the other team, i.e. when the teams merge
+    void addSights(const TeamVision& other);
+
+    bool isVisible(const Tile& tile) const;
+
+    std::span<const FogOfWar::Word> getRow(int32_t y) const
+    {
+        return {m_words.data() + size_t(y) * m_wordsPerRow, size_t(m_wordsPerRow)};
+    }
+
+    uint32_t getRowVersion(int32_t y) const
+    {
+        return m_rowVersions[y];
+    }
+
+    uint32_t getVersion() const
+    {
+        return m_version;
+    }
+
+    // Unique per init, never 0
+    uint32_t getId() const
+    {
+        return m_id;
+    }
+
+    int32_t getWidth() const
+    {
+        return m_width;
+    }
+
+    int32_t getHeight() const
+    {
+        return m_height;
+    }
+
+    const std::vector<Player*>& getMembers() const
+    {
+        return m_members;
+    }
+
+    void addMember(Player* player);
+    void removeMember(Player* player);
+
+  private:
+    void addSightToRow(int32_t y, int32_t minX, int32_t maxX, int delta);
+    void addSightToTile(const Tile& tile, int delta);
+    void addSightToCircle(const Tile& center, uint8_t radiusInTiles, int delta);
+    // Clamped span of the circle on the row, empty (i.e. min > max) if not covered
+    std::pair<int32_t, int32_t> getSpan(const Tile& center, uint8_t radiusInTiles, int32_t y) const;
+
+  private:
+    int32_t m_width = 0;
+    int32_t m_height = 0;
+    int32_t m_wordsPerRow = 0;
+    std::vector<FogOfWar::Word> m_words;
+    std::vector<uint16_t> m_sightCounts;
+    std::vector<uint32_t> m_rowVersions;
+    uint32_t m_version = 0;
+    uint32_t m_id = 0;
+    std::vector<Player*> m_members;
+
+    static inline std::atomic<uint32_t> s_nextId = 1;
+};
+} // namespace core
+
+#endif // CORE_TEAMVISION_H
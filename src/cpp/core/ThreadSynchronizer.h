@@ -2,79 +2,90 @@
 #define THREADSYNCHRONIZER_H
 
 #include <atomic>
-#include <condition_variable>
-#include <functional>
-#include <iostream>
-#include <mutex>
-#include <thread>
 
 namespace core
 {
+/*
+ *   Lock-free triple buffer handing frames from a sender (simulation) to a receiver
+ *   (renderer), so that both run at their own rates and neither waits for the other.
+ *
+ *   The sender fills its frame and publishes it to the middle slot, taking the slot's
+ *   previous frame as the next one to fill. The receiver takes the middle frame whenever
+ *   a new one is published, otherwise it keeps reading its current one.
+ *
+ *   A published frame the receiver hasn't taken yet (i.e. the receiver is slower) is taken
+ *   back by the sender before publishing the next one. Its content is merged into the new
+ *   frame (see T::mergeOlder), hence changes carried by the frames accumulate rather than
+ *   get lost.
+ *
+ *   Data flowing back from the receiver (T::Feedback) is a single latest-wins value.
+ */
 template <typename T> class ThreadSynchronizer
 {
   public:
+    using Feedback = typename T::Feedback;
+
     T& getSenderFrameData()
     {
-        return m_buffers[m_senderIndex.load()];
+        return m_buffers[m_senderIndex];
     }
 
     T& getReceiverFrameData()
     {
-        return m_buffers[m_receiverIndex.load()];
+        return m_buffers[m_receiverIndex];
     }
 
-    void waitForSender()
+    // Never waits for the receiver
+    void publish()
     {
+        // Unpublishing the frame not taken yet. Only the sender sets the fresh flag, hence
+        // the frame is the sender's alone once it's cleared.
+        int middle = m_middle.load(std::memory_order_acquire);
+        if ((middle & FRESH) and
+            m_middle.compare_exchange_strong(middle, middle & ~FRESH, std::memory_order_acq_rel))
         {
-            std::unique_lock lock(m_mtx);
-            m_frameReady = false;
+            m_buffers[m_senderIndex].mergeOlder(m_buffers[middle & ~FRESH]);
         }
-        m_cv.notify_one(); // Wake up Simulator
 
-        {
-            std::unique_lock lock(m_mtx);
-            m_cv.wait(lock, [this] { return m_frameReady || m_shutdown; });
-        }
+        const int previous = m_middle.exchange(m_senderIndex | FRESH, std::memory_order_acq_rel);
+        m_senderIndex = previous & ~FRESH;
     }
 
-    void waitForReceiver(std::function<void()> synchronizedBlock = []() {})
+    // Takes the latest published frame if any, returns false if the current one is the latest
+    bool receive()
     {
-        {
-            std::unique_lock lock(m_mtx);
-            m_cv.wait(lock, [this] { return !m_frameReady || m_shutdown; });
+        int middle = m_middle.load(std::memory_order_acquire);
+        if (not(middle & FRESH))
+            return false;
 
-            if (m_shutdown)
-                return;
+        // Fails if the sender took the frame back meanwhile, to publish it merged shortly
+        if (not m_middle.compare_exchange_strong(middle, m_receiverIndex,
+                                                 std::memory_order_acq_rel))
+            return false;
 
-            synchronizedBlock();
+        m_receiverIndex = middle & ~FRESH;
+        return true;
+    }
 
-            int temp = m_senderIndex.load(std::memory_order_relaxed);
-            m_senderIndex.store(m_receiverIndex.load(std::memory_order_relaxed),
-                                std::memory_order_relaxed);
-            m_receiverIndex.store(temp, std::memory_order_relaxed);
-            m_frameReady = true;
-        }
-        m_cv.notify_one();
+    void setFeedback(const Feedback& feedback)
+    {
+        m_feedback.store(feedback, std::memory_order_relaxed);
     }
 
-    void shutdown()
+    Feedback getFeedback() const
     {
-        {
-            std::unique_lock lock(m_mtx);
-            m_shutdown = true;
-        }
-        m_cv.notify_all(); // Wake up all waiting threads
+        return m_feedback.load(std::memory_order_relaxed);
     }
 
   private:
-    T m_buffers[2];
-    std::atomic<int> m_senderIndex{0};
-    std::atomic<int> m_receiverIndex{1};
-    std::atomic<bool> m_shutdown{false};
-    std::mutex m_mtx;
-    std::condition_variable m_cv;
-    bool m_frameReady = false;
+    static constexpr int FRESH = 0b100; // Published, but not taken by the receiver yet
+
+    T m_buffers[3];
+    int m_senderIndex = 0;        // Sender's alone
+    int m_receiverIndex = 1;      // Receiver's alone
+    std::atomic<int> m_middle{2}; // Index of the frame in between, with the fresh flag
+    std::atomic<Feedback> m_feedback{};
 };
 } // namespace core
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,26 @@
+#ifndef CORE_TIMERID_H
+#define CORE_TIMERID_H
+
+#include <cstdint>
+#include <limits>
+
+namespace core
+{
+// Handle of a timer scheduled with TimerService, stays invalid once the timer is gone
+struct TimerId
+{
+    static constexpr uint32_t INVALID_SLOT = std::numeric_limits<uint32_t>::max();
+
+    uint32_t slot = INVALID_SLOT;
+    uint32_t generation = 0;
+
+    bool isValid() const
+    {
+        return slot != INVALID_SLOT;
+    }
+
+    bool operator==(const TimerId&) const = default;
+};
+} // namespace core
+
+#endif // CORE_TIMERID_H
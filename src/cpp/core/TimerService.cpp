@@ -0,0 +1,110 @@
+#include "TimerService.h"
+
+#include "debug.h"
+
+using namespace core;
+
+TimerService::TimerService()
+{
+    registerCallback(Event::Type::TICK, this, &TimerService::onTick);
+}
+
+TimerService::ChannelId TimerService::registerChannel(ExpiryHandler handler)
+{
+    m_channels.emplace_back().handler = std::move(handler);
+    return ChannelId(m_channels.size() - 1);
+}
+
+TimerId TimerService::schedule(ChannelId channel, uint32_t payload, int tick)
+{
+    debug_assert(channel < m_channels.size(), "Invalid timer channel {}", channel);
+
+    uint32_t slot;
+    if (m_freeSlots.empty())
+    {
+        slot = uint32_t(m_timers.size());
+        m_timers.emplace_back();
+    }
+    else
+    {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+
+    auto& timer = m_timers[slot];
+    timer.payload = payload;
+    timer.channel = channel;
+    timer.isPending = true;
+    ++m_pendingCount;
+
+    TimerId id{.slot = slot, .generation = timer.generation};
+    m_wheel.schedule(id, tick);
+    return id;
+}
+
+TimerId TimerService::scheduleAfter(ChannelId channel, uint32_t payload, int ticks)
+{
+    return schedule(channel, payload, getCurrentTick() + ticks);
+}
+
+bool TimerService::cancel(TimerId& timer)
+{
+    const bool pending = isPending(timer);
+    if (pending)
+        release(timer.slot);
+
+    timer = TimerId();
+    return pending;
+}
+
+bool TimerService::isPending(const TimerId& timer) const
+{
+    return timer.isValid() and timer.slot < m_timers.size() and
+           m_timers[timer.slot].generation == timer.generation and
+           m_timers[timer.slot].isPending;
+}
+
+void TimerService::advance(int tick)
+{
+    for (int current = getCurrentTick() + 1; current <= tick; ++current)
+    {
+        m_wheel.advance(current,
+                        [this](const TimerId& id, int)
+                        {
+                            if (not isPending(id))
+                                return; // Cancelled
+
+                            const auto& timer = m_timers[id.slot];
+                            auto& channel = m_channels[timer.channel];
+                            if (channel.due.empty())
+                                m_dueChannels.push_back(timer.channel);
+
+                            channel.due.push_back(timer.payload);
+                            release(id.slot);
+                        });
+
+        // Handlers might schedule again, which lands on the later ticks
+        for (auto channelId : m_dueChannels)
+        {
+            auto& channel = m_channels[channelId];
+            channel.handler(channel.due, current);
+            channel.due.clear();
+        }
+        m_dueChannels.clear();
+    }
+}
+
+bool TimerService::onTick(const Event& e)
+{
+    advance(e.getData<TickData>().currentTick);
+    return false;
+}
+
+void TimerService::release(uint32_t slot)
+{
+    auto& timer = m_timers[slot];
+    timer.isPending = false;
+    ++timer.generation; // Invalidates the ids and the entry left in the wheel
+    --m_pendingCount;
+    m_freeSlots.push_back(slot);
+}
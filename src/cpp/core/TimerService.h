@@ -0,0 +1,86 @@
+#ifndef CORE_TIMERSERVICE_H
+#define CORE_TIMERSERVICE_H
+
+#include "EventHandler.h"
+#include "TimerId.h"
+#include "TimingWheel.h"
+
+#include <functional>
+#include <span>
+#include <vector>
+
+namespace core
+{
+/*
+ *   Central timers keyed by simulation tick, for systems advancing time based state
+ *   (e.g. unit production, burning buildings) to do work only when something is due
+ *   rather than visiting every entity every tick.
+ *
+ *   A system registers a channel with an expiry handler and schedules timers carrying
+ *   a payload (typically an entity) on it. The handler receives the payloads of all
+ *   its timers due at a tick in one go. Scheduling and cancelling are O(1), backed by
+ *   a TimingWheel. Cancelled timers stay in the wheel until their tick and are
+ *   skipped by the generation of their slot.
+ *
+ *   Expiry handlers run within the TICK of this service, which is registered before
+ *   the systems using it and doesn't declare its access (i.e. it runs alone).
+ */
+class TimerService : public EventHandler
+{
+  public:
+    using ChannelId = uint16_t;
+    using ExpiryHandler = std::function<void(std::span<const uint32_t> payloads, int tick)>;
+
+    TimerService();
+
+    ChannelId registerChannel(ExpiryHandler handler);
+
+    // Ticks at or before the current one are due at the next tick
+    TimerId schedule(ChannelId channel, uint32_t payload, int tick);
+    TimerId scheduleAfter(ChannelId channel, uint32_t payload, int ticks);
+    // Returns false if the timer already expired or got cancelled. Resets the id.
+    bool cancel(TimerId& timer);
+    bool isPending(const TimerId& timer) const;
+
+    // Fires the timers due up to and including the given tick
+    void advance(int tick);
+
+    int getCurrentTick() const
+    {
+        return m_wheel.getCurrentTick();
+    }
+
+    size_t getPendingCount() const
+    {
+        return m_pendingCount;
+    }
+
+  private:
+    struct Timer
+    {
+        uint32_t payload = 0;
+        uint32_t generation = 0;
+        ChannelId channel = 0;
+        bool isPending = false;
+    };
+
+    struct Channel
+    {
+        ExpiryHandler handler;
+        std::vector<uint32_t> due; // Payloads due at the tick being fired
+    };
+
+    bool onTick(const Event& e);
+    void release(uint32_t slot);
+
+  private:
+    TimingWheel<TimerId> m_wheel;
+    std::vector<Timer> m_timers;
+    std::vector<uint32_t> m_freeSlots;
+    std::vector<Channel> m_channels;
+    std::vector<ChannelId> m_dueChannels;
+    size_t m_pendingCount = 0;
+};
+} // namespace core
+
+#endif // CORE_TIMERSERVICE_H
@@ -0,0 +1,146 @@
+#ifndef CORE_TIMINGWHEEL_H
+#define CORE_TIMINGWHEEL_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace core
+{
+/*
+ *   Hierarchical timing wheel keyed by simulation tick. Scheduling is O(1) and
+ *   advancing by a tick is O(1) amortized, regardless of the number of pending
+ *   entries (i.e. unlike a priority queue).
+ *
+ *   Level 0 has a slot per tick for the next 64 ticks, level 1 a slot per 64 ticks
+ *   for the next 4096 ticks and so on. Entries of a higher level slot are moved to
+ *   the lower levels (cascaded) when the wheel reaches the start of that slot.
+ *   Entries further than the last level are parked in its farthest slot and get
+ *   cascaded again until they are in range.
+ *
+ *   Entries are not removable. Owners should validate an entry when it fires (e.g.
+ *   compare the tick against the one they expect) rather than cancelling it.
+ */
+template <typename T> class TimingWheel
+{
+  public:
+    static constexpr int SLOT_BITS = 6;
+    static constexpr int SLOTS = 1 << SLOT_BITS;
+    static constexpr int LEVELS = 4;
+
+    // Ticks at or before the current one are due at the next advance
+    void schedule(const T& value, int tick)
+    {
+        if (tick <= m_currentTick)
+            tick = m_currentTick + 1;
+
+        insert(Entry{tick, value});
+        ++m_size;
+    }
+
+    /*
+     *   Moves the wheel to the given tick, invoking fn(value, tick) for every entry due
+     *   on the way, in the tick order. Entries scheduled within the callback for the
+     *   ticks already passed are due at the next advance.
+     */
+    template <typename Fn> void advance(int tick, Fn&& fn)
+    {
+        while (m_currentTick < tick)
+        {
+            ++m_currentTick;
+            cascade();
+
+            auto& slot = m_slots[0][m_currentTick & (SLOTS - 1)];
+            if (slot.empty())
+                continue;
+
+            m_firing.swap(slot);
+            for (auto& entry : m_firing)
+            {
+                // Parked far entries might still be out of range
+                if (entry.tick != m_currentTick) [[unlikely]]
+                {
+                    insert(entry);
+                    continue;
+                }
+                --m_size;
+                fn(entry.value, entry.tick);
+            }
+            m_firing.clear();
+        }
+    }
+
+    int getCurrentTick() const
+    {
+        return m_currentTick;
+    }
+
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+  private:
+    struct Entry
+    {
+        int tick = 0;
+        T value;
+    };
+
+    static constexpr int64_t levelSpan(int level)
+    {
+        return int64_t(1) << (SLOT_BITS * level);
+    }
+
+    void insert(const Entry& entry)
+    {
+        const int64_t delta = int64_t(entry.tick) - m_currentTick;
+
+        int level = 0;
+        while (level < LEVELS - 1 and delta >= levelSpan(level + 1))
+            ++level;
+
+        int64_t tick = entry.tick;
+        if (delta >= levelSpan(LEVELS))
+        {
+            // Park at the farthest slot of the last level
+            tick = m_currentTick + levelSpan(LEVELS) - 1;
+        }
+        auto slot = (tick >> (SLOT_BITS * level)) & (SLOTS - 1);
+        m_slots[level][slot].push_back(entry);
+    }
+
+    void cascade()
+    {
+        for (int level = 1; level < LEVELS; ++level)
+        {
+            // Higher levels turn only when all the lower ones wrap around
+            if ((m_currentTick & (levelSpan(level) - 1)) != 0)
+                break;
+
+            auto slot = (m_currentTick >> (SLOT_BITS * level)) & (SLOTS - 1);
+            m_cascading.swap(m_slots[level][slot]);
+            for (auto& entry : m_cascading)
+            {
+                insert(entry);
+            }
+            m_cascading.clear();
+        }
+    }
+
+  private:
+    std::array<std::array<std::vector<Entry>, SLOTS>, LEVELS> m_slots;
+    std::vector<Entry> m_firing;
+    std::vector<Entry> m_cascading;
+    int m_currentTick = 0;
+    size_t m_size = 0;
+};
+} // namespace core
+
+#endif // CORE_TIMINGWHEEL_H
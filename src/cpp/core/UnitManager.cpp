@@ -19,21 +19,32 @@ UnitManager::UnitManager()
 {
     registerCallback(Event::Type::ENTITY_DELETE, this, &UnitManager::onEntityDeletion);
     registerCallback(Event::Type::UNIT_CREATION_FINISHED, this, &UnitManager::onCreateUnit);
-    registerCallback(Event::Type::UNIT_TILE_MOVEMENT, this, &UnitManager::onUnitTileMovement);
+    registerBatchCallback(Event::Type::UNIT_TILE_MOVEMENT, this,
+                          &UnitManager::onUnitTileMovements);
     registerCallback(Event::Type::TICK, this, &UnitManager::onTick);
     registerCallback(Event::Type::UNIT_FORMATION_COMMAND_MOVE, this,
                      &UnitManager::onUnitFormationMove);
     registerCallback(Event::Type::UNIT_FORMATION_DELETE, this, &UnitManager::onUnitFormationDelete);
 }
 
-bool UnitManager::onUnitTileMovement(const Event& e)
+void UnitManager::onUnitTileMovements(std::span<const Event> events,
+                                      std::span<uint8_t> consumed)
 {
-    auto& data = e.getData<UnitTileMovementData>();
-    auto [player, unit, vision] =
-        m_stateMan->getComponents<CompPlayer, CompUnit, CompVision>(data.unit);
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+        if (consumed[i])
+            continue;
 
-    player.player->getFogOfWar()->markAsExplored(data.positionFeet, vision.lineOfSight);
-    return false;
+        auto& data = events[i].getData<UnitTileMovementData>();
+        auto [player, vision] = m_stateMan->getComponents<CompPlayer, CompVision>(data.unit);
+
+        if (vision.hasVision)
+        {
+            player.player->getVision()->moveSight(vision.sightCenter, data.tile,
+                                                  vision.lineOfSight);
+            vision.sightCenter = data.tile;
+        }
+    }
 }
 
 bool UnitManager::onEntityDeletion(const Event& e)
@@ -43,13 +54,12 @@ bool UnitManager::onEntityDeletion(const Event& e)
     {
         spdlog::debug("Deleting unit {}", entity);
 
-        auto [info, transform, playerComp, unit] =
-            m_stateMan->getComponents<CompEntityInfo, CompTransform, CompPlayer, CompUnit>(entity);
+        auto [info, transform, playerComp, unit, vision] =
+            m_stateMan
+                ->getComponents<CompEntityInfo, CompTransform, CompPlayer, CompUnit, CompVision>(
+                    entity);
         info.isDestroyed = true;
-        while (not unit.commandQueue.empty())
-        {
-            unit.commandQueue.pop();
-        }
+        unit.commandQueue.clearAndDestroy();
         StateManager::markDirty(entity);
         m_stateMan->gameMap().removeEntity(MapLayerType::UNITS, transform.position.toTile(),
                                            entity);
@@ -57,16 +67,28 @@ bool UnitManager::onEntityDeletion(const Event& e)
         m_stateMan->gameMap().removeEntity(MapLayerType::ON_GROUND, transform.position.toTile(),
                                            entity);
         playerComp.player->removeOwnership(entity);
+        removeSight(playerComp, vision); // Dead units lost it already
     }
     return false;
 }
 
+void UnitManager::removeSight(const CompPlayer& player, CompVision& vision)
+{
+    if (vision.hasVision)
+    {
+        player.player->getVision()->removeSight(vision.sightCenter, vision.lineOfSight);
+        vision.hasVision = false;
+    }
+}
+
 bool UnitManager::onCreateUnit(const Event& e)
 {
     auto& data = e.getData<UnitCreationData>();
 
     auto stateMan = ServiceRegistry::getInstance().getService<StateManager>();
     auto factory = ServiceRegistry::getInstance().getService<EntityFactory>();
+    auto players = ServiceRegistry::getInstance().getService<PlayerFactory>();
+    auto player = players->getPlayer(data.playerId);
 
     auto unit = factory->createEntity(data.entityType);
     auto [transform, unitComp, selectible, playerComp, vision] =
@@ -79,13 +101,15 @@ bool UnitManager::onCreateUnit(const Event& e)
     selectible.boundingBoxes[static_cast<int>(Direction::NONE)] = box;
     selectible.selectionIndicator = {GraphicAddon::Type::ISO_CIRCLE,
                                      GraphicAddon::IsoCircle{10, Vec2(0, 0)}};*/
-    playerComp.player = data.player;
+    playerComp.player = player;
 
     auto newTile = transform.position.toTile();
     stateMan->gameMap().addEntity(MapLayerType::UNITS, newTile, unit);
     playerComp.player->ownEntity(unit);
 
-    data.player->getFogOfWar()->markAsExplored(transform.position, vision.lineOfSight);
+    player->getVision()->addSight(newTile, vision.lineOfSight);
+    vision.sightCenter = newTile;
+    vision.hasVision = true;
     return false;
 }
 
@@ -116,9 +140,10 @@ void UnitManager::handleHealths()
             if (healthComp.health <= 0 and not healthComp.isDead)
             {
                 spdlog::debug("Unit {} died", entity);
-                auto [playerComp, transform] =
-                    m_stateMan->getComponents<CompPlayer, CompTransform>(entity);
+                auto [playerComp, transform, vision] =
+                    m_stateMan->getComponents<CompPlayer, CompTransform, CompVision>(entity);
                 playerComp.player->removeOwnership(entity);
+                removeSight(playerComp, vision);
 
                 auto& gameMap = m_stateMan->gameMap();
                 gameMap.removeEntity(MapLayerType::UNITS, transform.position.toTile(), entity);
@@ -9,6 +9,8 @@
 namespace core
 {
 class StateManager;
+class CompPlayer;
+class CompVision;
 
 class UnitManager : public EventHandler
 {
@@ -19,7 +21,7 @@ class UnitManager : public EventHandler
     bool onTick(const Event& e);
     bool onEntityDeletion(const Event& e);
     bool onCreateUnit(const Event& e);
-    bool onUnitTileMovement(const Event& e);
+    void onUnitTileMovements(std::span<const Event> events, std::span<uint8_t> consumed);
     bool onUnitFormationMove(const Event& e);
     bool onUnitFormationDelete(const Event& e);
 
@@ -27,6 +29,7 @@ class UnitManager : public EventHandler
     void handleHealths();
     void buildDensityGrid();
     void handleFormations(int deltaTimeMs);
+    void removeSight(const CompPlayer& player, CompVision& vision);
     LazyServiceRef<StateManager> m_stateMan;
     Ref<Player> m_nature;
     std::set<Ref<BaseUnitFormation>> m_formations;
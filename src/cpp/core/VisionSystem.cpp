@@ -6,12 +6,20 @@
 #include "logging/Logger.h"
 #include "utils/Maths.h"
 
+#include <algorithm>
+
 using namespace core;
 
 VisionSystem::VisionSystem()
 {
     registerCallback(Event::Type::TICK, this, &VisionSystem::onTick);
     registerCallback(Event::Type::TRACKING_REQUEST, this, &VisionSystem::onTrackingRequest);
+
+    // Tracking state is also updated via TileMap listener callbacks, hence TileMap
+    // writers must not run at the same time. Dirty entities are the ones moved.
+    declareAccess(SystemAccess()
+                      .reads<TileMap, CompTransform, CompVision, DirtyEntities>()
+                      .writes<VisionSystem>());
 }
 
 VisionSystem::~VisionSystem()
@@ -19,30 +27,27 @@ VisionSystem::~VisionSystem()
     // destructor
 }
 
-uint32_t getCompositeId(uint32_t tracker, uint32_t target)
-{
-    return tracker * Constants::MAX_ENTITIES + target;
-}
-
-bool VisionSystem::isInLOS(const Tracking& trackerData, const Target& target)
+bool VisionSystem::isInLOS(const Tracker& tracker, const Feet& targetPosition)
 {
-    CompVision& vision = trackerData.trackerVision;
-
-    if (vision.lineOfSightShape == LineOfSightShape::CIRCLE)
+    if (tracker.shape == LineOfSightShape::CIRCLE or
+        tracker.shape == LineOfSightShape::OCCLUDED_CIRCLE)
     {
-        CompTransform& targetTransform = target.transform;
-        auto& trackerPosition = trackerData.trackingRequest.center;
-
-        float sqDistance = trackerPosition.distanceSquared(targetTransform.position);
-        return (vision.lineOfSight * vision.lineOfSight) > sqDistance;
+        float sqDistance = tracker.center.distanceSquared(targetPosition);
+        if ((tracker.lineOfSight * tracker.lineOfSight) <= sqDistance)
+            return false;
+
+        return tracker.shape == LineOfSightShape::CIRCLE or
+               m_shadowCaster.isVisible(m_stateMan->gameMap(), tracker.center.toTile(),
+                                        tracker.lineOfSight / Constants::FEET_PER_TILE,
+                                        tracker.entity, targetPosition.toTile());
     }
-    else if (vision.lineOfSightShape == LineOfSightShape::ROUNDED_SQUARE)
+    else if (tracker.shape == LineOfSightShape::ROUNDED_SQUARE)
     {
-        CompTransform& targetTransform = target.transform;
-        CompVision& trackerVision = trackerData.trackerVision;
+        if (tracker.isRectangularArea)
+            return maths::isOverlapping(targetPosition, tracker.lineOfSight, tracker.areaBounds);
 
-        return isWithinBuildingLineOfSight(trackerData.trackingRequest.landArea,
-                                           trackerVision.lineOfSight, targetTransform.position);
+        return isWithinBuildingLineOfSight(tracker.landArea, tracker.lineOfSight,
+                                           targetPosition);
     }
     return false;
 }
@@ -54,48 +59,66 @@ void VisionSystem::onEntityEnter(uint32_t entity, const Tile& tile, MapLayerType
 
     const auto& trackers = m_trackersTileMap.getEntities(MapLayerType::STATIC, tile);
 
-    for (auto tracker : trackers)
+    for (auto trackerEntity : trackers)
     {
-        auto it = m_possibleTargetsByTracker.find(tracker);
+        auto tracker = findTracker(trackerEntity);
+        if (tracker == nullptr)
+            continue;
 
-        if (it == m_possibleTargetsByTracker.end())
+        auto it = tracker->findCandidate(target);
+        if (it == tracker->candidates.end() or it->target != target)
         {
-            auto& trackingRequest = m_trackingRequests[tracker];
-            auto& trackerVision = m_stateMan->getComponent<CompVision>(tracker);
-            Tracking tracking(trackerVision, trackingRequest);
-            tracking.targets.emplace(target, Target(target, m_stateMan.getRef()));
-            m_possibleTargetsByTracker.emplace(tracker, tracking);
-        }
-        else
-        {
-            auto& tracking = it->second;
-            tracking.targets.try_emplace(target, Target(target, m_stateMan.getRef()));
+            it = tracker->candidates.insert(it, Candidate());
+            it->target = target;
+            m_trackersByTarget[target].push_back(m_trackerIndices[trackerEntity]);
         }
+        ++it->watchedTiles;
     }
+
+    if (not trackers.empty())
+        m_pendingTargets.push_back(target);
+
+    if (layer == MapLayerType::STATIC)
+        onOccluderChanged(tile);
 }
 
 void VisionSystem::onEntityExit(uint32_t entity, const Tile& tile, MapLayerType layer)
 {
     const auto& trackers = m_trackersTileMap.getEntities(MapLayerType::STATIC, tile);
 
-    for (auto tracker : trackers)
+    for (auto trackerEntity : trackers)
     {
-        auto it = m_possibleTargetsByTracker.find(tracker);
-        if (it != m_possibleTargetsByTracker.end())
-        {
-            auto& tracking = it->second;
-            auto targetIt = tracking.targets.find(entity);
+        auto tracker = findTracker(trackerEntity);
+        if (tracker == nullptr)
+            continue;
+
+        // Dropped at the next evaluation if the target doesn't enter another watched tile
+        auto it = tracker->findCandidate(entity);
+        if (it != tracker->candidates.end() and it->target == entity and it->watchedTiles > 0)
+            --it->watchedTiles;
+    }
 
-            if (targetIt != tracking.targets.end())
-            {
-                auto& target = targetIt->second;
+    if (not trackers.empty())
+        m_pendingTargets.push_back(entity);
 
-                if (not isInLOS(tracking, target))
-                {
-                    auto& tracking = it->second;
-                    tracking.targets.erase(target.entity);
-                }
-            }
+    if (layer == MapLayerType::STATIC)
+        onOccluderChanged(tile);
+}
+
+void VisionSystem::onOccluderChanged(const Tile& tile)
+{
+    m_shadowCaster.onOccluderChanged(tile);
+
+    // Shadows might have moved over or off the targets standing still
+    for (auto trackerEntity : m_trackersTileMap.getEntities(MapLayerType::STATIC, tile))
+    {
+        auto tracker = findTracker(trackerEntity);
+        if (tracker == nullptr or tracker->shape != LineOfSightShape::OCCLUDED_CIRCLE)
+            continue;
+
+        for (const auto& candidate : tracker->candidates)
+        {
+            m_pendingTargets.push_back(candidate.target);
         }
     }
 }
@@ -106,46 +129,86 @@ void VisionSystem::onInit(EventLoop& eventLoop)
     tileMap.registerListner(shared_from_this());
 
     m_trackersTileMap.init(tileMap.width, tileMap.height);
+    m_shadowCaster.init(tileMap.width, tileMap.height);
 }
 
 bool VisionSystem::onTick(const Event& e)
 {
-    for (const auto& [tracker, tracking] : m_possibleTargetsByTracker)
+    m_targetsToEvaluate.swap(m_pendingTargets);
+    m_pendingTargets.clear();
+
+    for (auto entity : StateManager::getDirtyEntities())
+    {
+        if (m_trackersByTarget.contains(entity))
+            m_targetsToEvaluate.push_back(entity);
+    }
+
+    std::sort(m_targetsToEvaluate.begin(), m_targetsToEvaluate.end());
+    m_targetsToEvaluate.erase(std::unique(m_targetsToEvaluate.begin(), m_targetsToEvaluate.end()),
+                              m_targetsToEvaluate.end());
+
+    for (auto target : m_targetsToEvaluate)
+    {
+        evaluate(target);
+    }
+    m_targetsToEvaluate.clear();
+    return false;
+}
+
+void VisionSystem::evaluate(uint32_t target)
+{
+    auto it = m_trackersByTarget.find(target);
+    if (it == m_trackersByTarget.end())
+        return;
+
+    auto& trackerIndices = it->second;
+    // Backwards, since dropping a candidate swaps the last tracker in
+    for (size_t i = trackerIndices.size(); i-- > 0;)
     {
-        for (const auto& [_, target] : tracking.targets)
+        auto& tracker = m_trackers[trackerIndices[i]];
+        auto candidate = tracker.findCandidate(target);
+
+        const bool isWatched = candidate->watchedTiles > 0;
+        const bool inLOS =
+            isWatched and
+            isInLOS(tracker, m_stateMan->getComponent<CompTransform>(target).position);
+
+        if (inLOS != candidate->isInLOS)
         {
-            auto compositeId = getCompositeId(tracker, target.entity);
-            auto it = m_activelyTrackedTargets.find(compositeId);
+            candidate->isInLOS = inLOS;
 
-            if (isInLOS(tracking, target))
+            LineOfSightData data;
+            data.tracker = tracker.entity;
+            data.target = target;
+
+            if (inLOS)
             {
-                if (it == m_activelyTrackedTargets.end()) // Not actively tracked, but now in LOS
-                {
-                    spdlog::debug("Start tracking {} by tracker {}", target.entity, tracker);
-                    m_activelyTrackedTargets.insert(compositeId);
-
-                    LineOfSightData data;
-                    data.tracker = tracker;
-                    data.target = target.entity;
-                    publishEvent(Event::Type::WITHIN_LINE_OF_SIGHT, data);
-                }
+                spdlog::debug("Start tracking {} by tracker {}", target, tracker.entity);
+                publishEvent(Event::Type::WITHIN_LINE_OF_SIGHT, data);
             }
             else
             {
-                if (it != m_activelyTrackedTargets.end()) // Actively tracked, but now out of LOS
-                {
-                    spdlog::debug("Stop tracking {} by tracker {}", target.entity, tracker);
-                    m_activelyTrackedTargets.erase(compositeId);
-
-                    LineOfSightData data;
-                    data.tracker = tracker;
-                    data.target = target.entity;
-                    publishEvent(Event::Type::OUT_OF_LINE_OF_SIGHT, data);
-                }
+                spdlog::debug("Stop tracking {} by tracker {}", target, tracker.entity);
+                publishEvent(Event::Type::OUT_OF_LINE_OF_SIGHT, data);
             }
         }
+
+        if (not isWatched)
+        {
+            tracker.candidates.erase(candidate);
+            trackerIndices[i] = trackerIndices.back();
+            trackerIndices.pop_back();
+        }
     }
-    return false;
+
+    if (trackerIndices.empty())
+        m_trackersByTarget.erase(it);
+}
+
+VisionSystem::Tracker* VisionSystem::findTracker(uint32_t entity)
+{
+    auto it = m_trackerIndices.find(entity);
+    return it == m_trackerIndices.end() ? nullptr : &m_trackers[it->second];
 }
 
 bool VisionSystem::onTrackingRequest(const Event& e)
@@ -162,7 +225,23 @@ bool VisionSystem::onTrackingRequest(const Event& e)
     {
         spdlog::debug("A tracking request for entity {}", data.entity);
 
-        m_trackingRequests[data.entity] = data;
+        auto [it, isNew] = m_trackerIndices.try_emplace(data.entity, m_trackers.size());
+        if (isNew)
+            m_trackers.emplace_back();
+
+        auto& tracker = m_trackers[it->second];
+        if (not isNew and tracker.shape == LineOfSightShape::OCCLUDED_CIRCLE)
+        {
+            // Shadows of the previous origin won't be asked for again
+            m_shadowCaster.forget(tracker.center.toTile(),
+                                  tracker.lineOfSight / Constants::FEET_PER_TILE);
+        }
+        tracker.entity = data.entity;
+        tracker.shape = vision.lineOfSightShape;
+        tracker.lineOfSight = vision.lineOfSight;
+        tracker.center = data.center;
+        tracker.landArea = data.landArea;
+        setAreaBounds(tracker);
 
         if (vision.lineOfSightShape == LineOfSightShape::ROUNDED_SQUARE)
         {
@@ -177,7 +256,8 @@ bool VisionSystem::onTrackingRequest(const Event& e)
                     m_trackersTileMap.addEntity(MapLayerType::STATIC, t, data.entity);
                 });
         }
-        else if (vision.lineOfSightShape == LineOfSightShape::CIRCLE)
+        else if (vision.lineOfSightShape == LineOfSightShape::CIRCLE or
+                 vision.lineOfSightShape == LineOfSightShape::OCCLUDED_CIRCLE)
         {
             debug_assert(data.center.isNull() == false,
                          "Entity center position cannot be null to enable visibility");
@@ -199,10 +279,38 @@ bool VisionSystem::onTrackingRequest(const Event& e)
     return false;
 }
 
-VisionSystem::Target::Target(uint32_t entity, Ref<StateManager> stateMan)
-    : entity(entity), info(stateMan->getComponent<CompEntityInfo>(entity)),
-      transform(stateMan->getComponent<CompTransform>(entity))
+std::vector<VisionSystem::Candidate>::iterator VisionSystem::Tracker::findCandidate(
+    uint32_t target)
 {
+    return std::lower_bound(candidates.begin(), candidates.end(), target,
+                            [](const Candidate& candidate, uint32_t target)
+                            { return candidate.target < target; });
+}
+
+void VisionSystem::setAreaBounds(Tracker& tracker)
+{
+    const auto& tiles = tracker.landArea.tiles;
+    tracker.isRectangularArea = false;
+    if (tiles.empty())
+        return;
+
+    int minX = tiles[0].x, maxX = tiles[0].x, minY = tiles[0].y, maxY = tiles[0].y;
+    for (const auto& t : tiles)
+    {
+        minX = std::min(minX, t.x);
+        maxX = std::max(maxX, t.x);
+        minY = std::min(minY, t.y);
+        maxY = std::max(maxY, t.y);
+    }
+
+    // Land areas don't repeat tiles, hence filling the bounds means being the bounds
+    const auto tilesInBounds = size_t(maxX - minX + 1) * (maxY - minY + 1);
+    tracker.isRectangularArea = tiles.size() == tilesInBounds;
+
+    const float feetPerTile = Constants::FEET_PER_TILE;
+    tracker.areaBounds = Rect<float>(minX * feetPerTile, minY * feetPerTile,
+                                     (maxX - minX + 1) * feetPerTile,
+                                     (maxY - minY + 1) * feetPerTile);
 }
 
 bool VisionSystem::isWithinBuildingLineOfSight(const LandArea& landArea,
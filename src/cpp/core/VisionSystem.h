@@ -1,6 +1,8 @@
 #ifndef CORE_VISIONSYSTEM_H
 #define CORE_VISIONSYSTEM_H
 #include "EventHandler.h"
+#include "Rect.h"
+#include "ShadowCaster.h"
 #include "TileMapListner.h"
 #include "components/CompEntityInfo.h"
 #include "components/CompTransform.h"
@@ -10,6 +12,16 @@
 
 namespace core
 {
+/*
+ *   Publishes WITHIN_LINE_OF_SIGHT and OUT_OF_LINE_OF_SIGHT for the entities tracking
+ *   others (e.g. gates). Entities entering the tiles watched by a tracker become its
+ *   candidates, and a tracker/candidate pair is tested again only when the candidate
+ *   moved (i.e. got dirty or changed tiles) since the last tick.
+ *
+ *   Occluded circles test the target's tile against the shadows cast by the STATIC
+ *   entities around the tracker (see ShadowCaster). A STATIC entity entering or leaving a
+ *   watched tile tests the candidates of the occluded trackers watching it again.
+ */
 class VisionSystem : public TileMapListner,
                      public EventHandler,
                      public std::enable_shared_from_this<VisionSystem>
@@ -29,34 +41,47 @@ class VisionSystem : public TileMapListner,
                                             uint32_t lineOfSight,
                                             const Feet& pointToCheck);
 
-    struct Target
+    // A possible target standing on the tiles watched by a tracker
+    struct Candidate
     {
-        uint32_t entity = entt::null;
-        std::reference_wrapper<CompEntityInfo> info;
-        std::reference_wrapper<CompTransform> transform;
-
-        Target(uint32_t entity, Ref<StateManager> stateMan);
+        uint32_t target = entt::null;
+        uint16_t watchedTiles = 0; // Watched tiles the target is on, dropped at zero
+        bool isInLOS = false;      // I.e. actively tracked
     };
 
-    struct Tracking
+    struct Tracker
     {
-        std::reference_wrapper<CompVision> trackerVision;
-        TrackingRequestData trackingRequest;
-        std::unordered_map<uint32_t, Target> targets; // by target entity id
-
-        Tracking(CompVision& trackerVision, const TrackingRequestData& request)
-            : trackerVision(trackerVision), trackingRequest(request)
-        {
-        }
+        uint32_t entity = entt::null;
+        LineOfSightShape shape = LineOfSightShape::CIRCLE;
+        float lineOfSight = 0; // In feet
+        Feet center;
+        // Rounded square LOS around the land area. Land areas are rectangles in practice
+        // (i.e. buildings), then the distance to the bounds is enough. Otherwise the
+        // tiles are checked one by one.
+        Rect<float> areaBounds;
+        bool isRectangularArea = false;
+        LandArea landArea;
+        std::vector<Candidate> candidates; // Sorted by target
+
+        std::vector<Candidate>::iterator findCandidate(uint32_t target);
     };
 
-    static bool isInLOS(const Tracking& trackerData, const Target& target);
+    bool isInLOS(const Tracker& tracker, const Feet& targetPosition);
+    void onOccluderChanged(const Tile& tile);
+    static void setAreaBounds(Tracker& tracker);
+    void evaluate(uint32_t target);
+    Tracker* findTracker(uint32_t entity);
 
-    std::unordered_map<uint32_t, TrackingRequestData> m_trackingRequests;
-    std::unordered_map<uint32_t, Tracking> m_possibleTargetsByTracker;
-    std::unordered_set<uint32_t> m_activelyTrackedTargets;
+    std::vector<Tracker> m_trackers;
+    std::unordered_map<uint32_t, uint32_t> m_trackerIndices; // By tracker entity
+    // Indices of the trackers having the target as a candidate, by target entity
+    std::unordered_map<uint32_t, std::vector<uint32_t>> m_trackersByTarget;
+    // Targets to test since the last tick, besides the dirty (i.e. moved) ones
+    std::vector<uint32_t> m_pendingTargets;
+    std::vector<uint32_t> m_targetsToEvaluate;
     LazyServiceRef<StateManager> m_stateMan;
     TileMap m_trackersTileMap;
+    ShadowCaster m_shadowCaster;
 };
 } // namespace core
 
@@ -100,16 +100,10 @@ void ZOrderStrategyByTiles::onUpdate(const CompRendering& current, CompRendering
     if (not update.positionInFeet.isNull())
     {
         const auto& layer = getMapLayerType(update.layer);
-        LandArea currentLand =
-            current.isBig() ? current.landArea : LandArea{{current.positionInFeet.toTile()}};
-        LandArea updateLand =
-            update.isBig() ? update.landArea : LandArea{{update.positionInFeet.toTile()}};
-        const bool positionChanged =
-            current.positionInFeet.toTile() != update.positionInFeet.toTile();
 
         if (update.isDestroyed or not update.isEnabled)
         {
-            m_gameMap.removeEntity(layer, currentLand, current.entityID);
+            removeFromMap(layer, current);
         }
         else
         {
@@ -117,9 +111,9 @@ void ZOrderStrategyByTiles::onUpdate(const CompRendering& current, CompRendering
             {
                 // TODO: This will result in always removing and adding entities
                 // could optimize this.
-                m_gameMap.removeEntity(layer, currentLand, current.entityID);
+                removeFromMap(layer, current);
             }
-            m_gameMap.addEntity(layer, updateLand, update.entityID);
+            addToMap(layer, update);
         }
     }
     else
@@ -135,6 +129,23 @@ void ZOrderStrategyByTiles::onUpdate(const CompRendering& current, CompRendering
     m_renderingComponents[update.entityID] = &update;
 }
 
+// Small entities occupy the tile of their position, without making a land area of it
+void ZOrderStrategyByTiles::addToMap(MapLayerType layer, const CompRendering& graphic)
+{
+    if (graphic.isBig())
+        m_gameMap.addEntity(layer, graphic.landArea, graphic.entityID);
+    else
+        m_gameMap.addEntity(layer, graphic.positionInFeet.toTile(), graphic.entityID);
+}
+
+void ZOrderStrategyByTiles::removeFromMap(MapLayerType layer, const CompRendering& graphic)
+{
+    if (graphic.isBig())
+        m_gameMap.removeEntity(layer, graphic.landArea, graphic.entityID);
+    else
+        m_gameMap.removeEntity(layer, graphic.positionInFeet.toTile(), graphic.entityID);
+}
+
 const std::vector<core::CompRendering*>& ZOrderStrategyByTiles::zOrder(
     const Coordinates& coordinates)
 {
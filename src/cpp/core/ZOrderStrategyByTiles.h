@@ -23,6 +23,8 @@ class ZOrderStrategyByTiles : public ZOrderStrategy
     const std::vector<CompRendering*>& zOrder(const Coordinates& coordinates) override;
 
   private:
+    void addToMap(MapLayerType layer, const CompRendering& graphic);
+    void removeFromMap(MapLayerType layer, const CompRendering& graphic);
     void processLayer(const MapLayerType& layer, const Coordinates& coordinates);
     void processUILayer();
     const std::vector<core::CompRendering*>& consolidateAllLayers();
@@ -80,10 +80,9 @@ void CmdBuild::destroy()
 /**
  * @brief Animates the building action for the unit.
  *
- * Overrides the unit's action to BUILDING and increments the animation frame
- * based on the animation speed and elapsed ticks. Marks the entity as dirty when
- * the frame is updated to ensure changes are processed. The animation frames loop
- * continuously, making the building action repeatable.
+ * Overrides the unit's action to BUILDING and loops its animation based on the
+ * animation speed. The renderer advances the frames, hence the entity is marked as
+ * dirty only when the playback (re)starts.
  *
  * @param deltaTimeMs The elapsed time in milliseconds since the last tick.
  */
@@ -94,12 +93,9 @@ void CmdBuild::animate(int deltaTimeMs, int currentTick)
 
     auto ticksPerFrame =
         int(m_settings->getTicksPerSecond() / (actionAnimation.speed * m_settings->getGameSpeed()));
-    if (currentTick % ticksPerFrame == 0)
-    {
+    // Building is repeatable, the renderer loops it
+    if (m_components->animation.loop(UnitAction::BUILDING, currentTick, ticksPerFrame))
         StateManager::markDirty(m_entityID);
-        m_components->animation.frame++;
-        m_components->animation.frame %= actionAnimation.frames; // Building is repeatable
-    }
 }
 
 /**
@@ -241,8 +237,7 @@ bool CmdBuild::lookForResourceToGather(std::list<Command*>& newCommands)
     {
         // TODO : use LOS
         auto resource = CmdGatherResource::findClosestResource(
-            resouceType, m_components->transform.position.toTile(),
-            Constants::MAX_RESOURCE_LOOKUP_RADIUS, m_stateMan.getRef());
+            resouceType, m_components->transform.position.toTile());
 
         if (resource != entt::null)
         {
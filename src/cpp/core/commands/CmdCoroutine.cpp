@@ -0,0 +1,115 @@
+#include "CmdCoroutine.h"
+
+#include "components/CompTransform.h"
+#include "logging/Logger.h"
+
+using namespace core;
+
+CmdCoroutine::Awaiter CmdCoroutine::ticks(int count)
+{
+    if (count <= 0)
+        return Awaiter{.ready = true};
+
+    m_wait = Wait::TICKS;
+    m_resumeTick = m_currentTick + count;
+    return Awaiter{};
+}
+
+CmdCoroutine::Awaiter CmdCoroutine::moveTo(const Target& target, UnitAction action)
+{
+    m_move.emplace();
+    m_move->target.emplace(target);
+    m_move->actionOverride = action;
+    m_move->collisionRadius = m_components->transform.collisionRadius;
+    m_move->setPriority(getPriority());
+    m_move->setEntityID(m_entityID);
+    m_move->init();
+
+    // Through the base since CmdMove keeps its Command overrides private
+    Command& move = m_move.value();
+    move.onQueue();
+    move.onStart();
+
+    m_wait = Wait::MOVE;
+    return Awaiter{};
+}
+
+CmdCoroutine::Awaiter CmdCoroutine::until(std::function<bool()> condition)
+{
+    if (condition())
+        return Awaiter{.ready = true};
+
+    m_wait = Wait::CONDITION;
+    m_condition = std::move(condition);
+    return Awaiter{};
+}
+
+bool CmdCoroutine::onExecute(int deltaTimeMs, int currentTick, std::list<Command*>& subCommands)
+{
+    m_currentTick = currentTick;
+
+    if (not m_task)
+        m_task = run();
+    else if (isWaiting(deltaTimeMs, currentTick, subCommands))
+        return false;
+
+    m_wait = Wait::NONE;
+    m_task.resume();
+
+    if (m_task.done())
+    {
+        m_task.reset();
+        return true;
+    }
+
+    if (m_wait == Wait::TICKS)
+        sleepUntil(m_resumeTick);
+    return false;
+}
+
+bool CmdCoroutine::isWaiting(int deltaTimeMs, int currentTick, std::list<Command*>& subCommands)
+{
+    switch (m_wait)
+    {
+    case Wait::TICKS:
+        if (currentTick < m_resumeTick)
+        {
+            // Woken up early (e.g. by a new command), keep sleeping
+            sleepUntil(m_resumeTick);
+            return true;
+        }
+        return false;
+    case Wait::MOVE:
+    {
+        Command& move = m_move.value();
+        if (not move.onExecute(deltaTimeMs, currentTick, subCommands))
+            return true;
+
+        m_move.reset();
+        return false;
+    }
+    case Wait::CONDITION:
+        if (not m_condition())
+            return true;
+
+        m_condition = nullptr;
+        return false;
+    case Wait::NONE:
+        return false;
+    }
+    return false;
+}
+
+void CmdCoroutine::destroy()
+{
+    abandon();
+    release();
+}
+
+void CmdCoroutine::abandon()
+{
+    m_task.reset();
+    m_move.reset();
+    m_condition = nullptr;
+    m_wait = Wait::NONE;
+}
@@ -0,0 +1,103 @@
+#ifndef CMDCOROUTINE_H
+#define CMDCOROUTINE_H
+
+#include "Target.h"
+#include "commands/CmdMove.h"
+#include "commands/Command.h"
+#include "commands/CommandTask.h"
+
+#include <coroutine>
+#include <functional>
+#include <optional>
+
+namespace core
+{
+/*
+ *   Base of the commands written as coroutines rather than state machines. E.g.
+ *
+ *       CommandTask run() override
+ *       {
+ *           co_await moveTo(target);
+ *           co_await ticks(10);
+ *       }
+ *
+ *   The coroutine is resumed from onExecute, i.e. by CommandCenter's tick, and the
+ *   command completes when the coroutine returns. While waiting:
+ *   - ticks(n): the unit sleeps (see Command::sleepUntil), costing nothing per tick.
+ *   - moveTo(target): an inline CmdMove is driven by this command, instead of queuing
+ *     a pooled move sub-command.
+ *   - until(condition): the condition is polled every tick.
+ *
+ *   Subclasses implement run() and release() (returning the object to its pool),
+ *   destroy() releases the coroutine frame first.
+ */
+class CmdCoroutine : public Command
+{
+  public:
+    CmdCoroutine() = default;
+
+    // A copy starts from the beginning, i.e. the coroutine state isn't copied
+    CmdCoroutine(const CmdCoroutine& other) : Command(other)
+    {
+    }
+
+    CmdCoroutine& operator=(const CmdCoroutine& other)
+    {
+        Command::operator=(other);
+        abandon();
+        return *this;
+    }
+
+  protected:
+    struct Awaiter
+    {
+        bool ready = false;
+
+        bool await_ready() const noexcept
+        {
+            return ready;
+        }
+
+        void await_suspend(std::coroutine_handle<>) const noexcept
+        {
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+    };
+
+    // Body of the command, the command completes when it returns
+    virtual CommandTask run() = 0;
+    // Return this object to its pool
+    virtual void release() = 0;
+
+    Awaiter ticks(int count);
+    Awaiter moveTo(const Target& target, UnitAction action = UnitAction::MOVE);
+    Awaiter until(std::function<bool()> condition);
+
+    bool onExecute(int deltaTimeMs, int currentTick, std::list<Command*>& subCommands) final;
+    void destroy() final;
+
+  private:
+    enum class Wait
+    {
+        NONE,
+        TICKS,
+        MOVE,
+        CONDITION
+    };
+
+    bool isWaiting(int deltaTimeMs, int currentTick, std::list<Command*>& subCommands);
+    void abandon();
+
+    CommandTask m_task;
+    Wait m_wait = Wait::NONE;
+    int m_currentTick = 0;
+    int m_resumeTick = 0;
+    std::optional<CmdMove> m_move;
+    std::function<bool()> m_condition;
+};
+} // namespace core
+
+#endif
@@ -17,6 +17,8 @@ class CmdDecayCorpse : public Command
   private:
     void onStart() override
     {
+        // Stepped here, to know when the animation ends
+        m_components->animation.stop();
         m_components->animation.frame = 0;
     }
 
@@ -52,8 +54,11 @@ class CmdDecayCorpse : public Command
         bool completed = false;
 
         // TODO: speed should be float to accept very low speed animations like corpse decay
-        auto ticksPerFrame = m_settings->getTicksPerSecond() / actionAnimation.speed;
-        if (currentTick % (int) ticksPerFrame == 0)
+        auto ticksPerFrame = (int) (m_settings->getTicksPerSecond() / actionAnimation.speed);
+        // Decaying is slow, sleep until the next frame
+        sleepUntil((currentTick / ticksPerFrame + 1) * ticksPerFrame);
+
+        if (currentTick % ticksPerFrame == 0)
         {
             StateManager::markDirty(m_entityID);
             m_components->animation.frame++;
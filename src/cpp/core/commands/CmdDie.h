@@ -19,6 +19,8 @@ class CmdDie : public Command
   private:
     void onStart() override
     {
+        // Stepped here, to know when the animation ends
+        m_components->animation.stop();
         m_components->animation.frame = 0;
     }
 
@@ -82,10 +84,7 @@ class CmdDie : public Command
     {
         spdlog::debug("Target {} death is completed, converting to a corpse", m_entityID);
 
-        while (not m_components->unit.commandQueue.empty())
-        {
-            m_components->unit.commandQueue.pop();
-        }
+        m_components->unit.commandQueue.clearAndDestroy(this);
         auto moveCmd = ObjectPool<CmdDecayCorpse>::acquire();
         subCommands.push_back(moveCmd);
     }
@@ -2,13 +2,13 @@
 #define CMDDROPRESOURCE_H
 
 #include "Coordinates.h"
+#include "DropOffIndex.h"
 #include "Feet.h"
 #include "Player.h"
 #include "Rect.h"
 #include "ServiceRegistry.h"
 #include "StateManager.h"
-#include "commands/CmdMove.h"
-#include "commands/Command.h"
+#include "commands/CmdCoroutine.h"
 #include "components/CompAction.h"
 #include "components/CompAnimation.h"
 #include "components/CompBuilding.h"
@@ -21,12 +21,13 @@
 #include "utils/ObjectPool.h"
 
 #include <algorithm>
+#include <cstdlib>
 
 namespace core
 {
 class PathService;
 
-class CmdDropResource : public Command
+class CmdDropResource : public CmdCoroutine
 {
   public:
     uint8_t resourceType = Constants::RESOURCE_TYPE_NONE;
@@ -35,6 +36,11 @@ class CmdDropResource : public Command
     uint32_t m_dropOffEntity = entt::null;
     CompResourceGatherer* m_gatherer = nullptr;
     LazyServiceRef<PathService> m_pathService;
+    LazyServiceRef<DropOffIndex> m_dropOffIndex;
+
+    // A cached drop-off point is reused while the gatherer is within this many tiles
+    // of where it was looked up from
+    static constexpr int DROP_OFF_CACHE_DISTANCE = DropOffIndex::BUCKET_SIZE;
 
   private:
     std::string toString() const override
@@ -47,7 +53,7 @@ class CmdDropResource : public Command
         return ObjectPool<CmdDropResource>::acquire(*this);
     }
 
-    void destroy() override
+    void release() override
     {
         ObjectPool<CmdDropResource>::release(this);
     }
@@ -64,31 +70,29 @@ class CmdDropResource : public Command
     }
 
     /**
-     * @brief Executes the drop resource command logic.
-     *
-     * This method attempts to find the closest drop-off building for the resource.
-     * If the drop-off building is close enough, it drops the resource and returns true
-     * marking the end of the command execution.
-     * Otherwise, it issues a command to move towards the drop-off building and returns false.
+     * @brief Drop resource command logic.
      *
-     * @param deltaTimeMs The elapsed time in milliseconds since the last execution.
-     * @param subCommands A list to which any sub-commands generated during execution are added.
-     * @return true if the resource was successfully dropped off; false otherwise.
+     * Finds the closest drop-off building for the resource and moves towards it until it is
+     * close enough, then drops the resource which completes the command. If there is no
+     * drop-off building, the unit waits for one to become available.
      */
-    bool onExecute(int deltaTimeMs, int currentTick, std::list<Command*>& subCommands) override
+    CommandTask run() override
     {
-        findClosestDropOffBuilding();
-
-        if (isDropOffCloseEnough())
-        {
-            dropResource();
-            return true;
-        }
-        else
+        while (true)
         {
-            goToDropOffBuilding(subCommands);
+            findClosestDropOffBuilding();
+
+            if (isDropOffCloseEnough())
+            {
+                dropResource();
+                co_return;
+            }
+
+            if (m_dropOffEntity != entt::null)
+                co_await goToDropOffBuilding();
+            else
+                co_await ticks(1);
         }
-        return false;
     }
 
     /**
@@ -101,42 +105,32 @@ class CmdDropResource : public Command
         auto [action, animation] = m_stateMan->getComponents<CompAction, CompAnimation>(m_entityID);
 
         action.action = m_gatherer->getCarryingAction(resourceType);
+        animation.stop();
         animation.frame = 0;
         StateManager::markDirty(m_entityID);
     }
 
     /**
-     * @brief Adds a movement command to subCommands to move the gatherer to the drop-off building.
+     * @brief Moves the gatherer to the drop-off building, to be awaited.
      *
-     * This function creates a CmdMove command, sets its target entity to the drop-off building,
-     * configures its action and priority, and appends it to the provided subCommands list.
-     *
-     * @param subCommands A list of Command pointers to which the movement command will be added.
+     * The movement is driven inline by this command (see CmdCoroutine::moveTo) with the
+     * carrying action of the resource, until the drop-off building is close enough.
      */
-    void goToDropOffBuilding(std::list<Command*>& subCommands)
+    Awaiter goToDropOffBuilding()
     {
-        if (m_dropOffEntity != entt::null)
-        {
-            const auto [dropOffTransform, dropOffBuilding] =
-                m_stateMan->getComponents<CompTransform, CompBuilding>(m_dropOffEntity);
+        const auto [dropOffTransform, dropOffBuilding] =
+            m_stateMan->getComponents<CompTransform, CompBuilding>(m_dropOffEntity);
 
-            spdlog::debug("Target {} at {} is not close enough to drop-off, moving...",
-                          m_dropOffEntity, dropOffTransform.position.toString());
-            auto moveCmd = ObjectPool<CmdMove>::acquire();
-            moveCmd->collisionRadius = m_components->transform.collisionRadius;
+        spdlog::debug("Target {} at {} is not close enough to drop-off, moving...",
+                      m_dropOffEntity, dropOffTransform.position.toString());
 
-            auto targetPos = m_pathService->findClosestVacantPosAroundLand(
-                m_entityID, m_components->transform.position, dropOffBuilding.landArea);
+        auto targetPos = m_pathService->findClosestVacantPosAroundLand(
+            m_entityID, m_components->transform.position, dropOffBuilding.landArea);
 
-            Target targetData(targetPos, Target::Type::BUILDING);
-            targetData.arrivalEvaluator = [this]() { return this->isDropOffCloseEnough(); };
+        Target targetData(targetPos, Target::Type::BUILDING);
+        targetData.arrivalEvaluator = [this]() { return this->isDropOffCloseEnough(); };
 
-            moveCmd->target.emplace(targetData);
-            moveCmd->actionOverride = m_gatherer->getCarryingAction(resourceType);
-            moveCmd->setPriority(getPriority() + CHILD_PRIORITY_OFFSET);
-
-            subCommands.push_back(moveCmd);
-        }
+        return moveTo(targetData, m_gatherer->getCarryingAction(resourceType));
     }
 
     /**
@@ -186,10 +180,9 @@ class CmdDropResource : public Command
      * @brief Finds the closest valid drop-off building for the current unit and updates
      * m_dropOffEntity.
      *
-     * This function searches through all buildings owned by the player to find the nearest building
-     * that can accept the specified resource type as a drop-off point. It calculates the squared
-     * distance between the unit and each candidate building, selecting the one with the smallest
-     * distance.
+     * Looks up the player's drop-off points in the DropOffIndex. The result is cached in the
+     * gatherer and reused by the later drop-offs until the player's drop-off points change or
+     * the gatherer moved away from where it looked up from.
      *
      * @note If a valid drop-off building is already found and valid, the function returns early.
      * @note Not finding a drop-off building is considered a valid scenario. So the unit would stand
@@ -200,31 +193,28 @@ class CmdDropResource : public Command
         if (isDropOffFoundAndValid())
             return;
 
-        m_dropOffEntity = entt::null;
-        float currentClosestDistance = std::numeric_limits<float>::max();
+        const auto playerId = m_components->player.player->getId();
+        const auto version = m_dropOffIndex->getVersion(playerId);
+        const auto tile = m_components->transform.position.toTile();
+        auto& cache = m_gatherer->dropOffCache;
 
-        for (auto buildingEntity : m_components->player.player->getMyBuildings())
+        if (cache.indexVersion == version and cache.resourceType == resourceType and
+            std::abs(cache.from.x - tile.x) <= DROP_OFF_CACHE_DISTANCE and
+            std::abs(cache.from.y - tile.y) <= DROP_OFF_CACHE_DISTANCE)
         {
-            auto [transform, building] =
-                m_stateMan->getComponents<CompTransform, CompBuilding>(buildingEntity);
-
-            if (building.acceptResource(resourceType))
-            {
-                auto distance =
-                    transform.position.distanceSquared(m_components->transform.position);
-
-                if (distance < currentClosestDistance)
-                {
-                    currentClosestDistance = distance;
-                    m_dropOffEntity = buildingEntity;
-                }
-            }
+            m_dropOffEntity = cache.entity;
+            return;
         }
 
+        m_dropOffEntity = m_dropOffIndex->findNearest(playerId, resourceType, tile);
+        cache = {.entity = m_dropOffEntity,
+                 .indexVersion = version,
+                 .resourceType = resourceType,
+                 .from = tile};
+
         if (m_dropOffEntity != entt::null)
         {
-            spdlog::debug("Selected {} at distance sq {} as the drop off building", m_dropOffEntity,
-                          currentClosestDistance);
+            spdlog::debug("Selected {} as the drop off building", m_dropOffEntity);
         }
         // Not being able to find a drop-off point is a valid scenario
     }
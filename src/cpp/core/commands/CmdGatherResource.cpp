@@ -1,77 +1,16 @@
 #include "CmdGatherResource.h"
 
 #include "ProximityChecker.h"
+#include "ResourceIndex.h"
 
 uint32_t core::CmdGatherResource::findClosestResource(uint8_t resourceType,
                                                       const Tile& startTile,
-                                                      int maxRadius,
-                                                      Ref<StateManager> stateMan)
+                                                      int maxRadius)
 {
-    std::queue<std::pair<Tile, int>> toVisit; // Pair: position, current distance
-    std::unordered_set<Tile> visited;
+    auto& registry = ServiceRegistry::getInstance();
+    debug_assert(registry.hasService<ResourceIndex>(), "ResourceIndex service is not registered");
 
-    uint32_t resourceEntity = entt::null;
-
-    toVisit.push({startTile, 0});
-    visited.insert(startTile);
-
-    static const std::vector<Tile> directions = {{0, -1},  {1, 0},  {0, 1}, {-1, 0},
-                                                 {-1, -1}, {1, -1}, {1, 1}, {-1, 1}};
-
-    while (!toVisit.empty())
-    {
-        auto [current, distance] = toVisit.front();
-        toVisit.pop();
-
-        if (doesTileHaveResource(resourceType, current, resourceEntity, stateMan))
-        {
-            return resourceEntity;
-        }
-
-        if (distance >= maxRadius)
-        {
-            continue; // Stop expanding beyond max radius
-        }
-
-        for (const auto& dir : directions)
-        {
-            Tile neighbor{current.x + dir.x, current.y + dir.y};
-
-            if (!visited.contains(neighbor))
-            {
-                visited.insert(neighbor);
-                toVisit.push({neighbor, distance + 1});
-            }
-        }
-    }
-    return entt::null; // Not found within radius
-}
-
-bool core::CmdGatherResource::doesTileHaveResource(uint8_t resourceType,
-                                                   const Tile& posTile,
-                                                   uint32_t& resourceEntity,
-                                                   Ref<StateManager> stateMan)
-{
-    resourceEntity = entt::null;
-    auto& map = stateMan->gameMap();
-    auto e = map.getEntity(MapLayerType::STATIC, posTile);
-    if (e != entt::null)
-    {
-        const auto& info = stateMan->getComponent<CompEntityInfo>(e);
-        if (!info.isDestroyed)
-        {
-            if (stateMan->hasComponent<CompResource>(e))
-            {
-                const auto& resource = stateMan->getComponent<CompResource>(e);
-                if (resource.original.value().type == resourceType)
-                {
-                    resourceEntity = e;
-                    return true;
-                }
-            }
-        }
-    }
-    return false;
+    return registry.getService<ResourceIndex>()->findNearest(resourceType, startTile, maxRadius);
 }
 
 void core::CmdGatherResource::onStart()
@@ -200,12 +139,8 @@ void core::CmdGatherResource::animate(int currentTick)
 
     auto ticksPerFrame =
         int(m_settings->getTicksPerSecond() / (actionAnimation.speed * m_settings->getGameSpeed()));
-    if (currentTick % ticksPerFrame == 0)
-    {
+    if (m_components->animation.loop(m_components->action.action, currentTick, ticksPerFrame))
         StateManager::markDirty(m_entityID);
-        m_components->animation.frame++;
-        m_components->animation.frame %= actionAnimation.frames;
-    }
 }
 
 bool core::CmdGatherResource::isFull() const
@@ -237,8 +172,7 @@ bool core::CmdGatherResource::lookForAnotherSimilarResource()
     spdlog::debug("Looking for another resource...");
     auto tilePos = m_components->transform.position.toTile();
 
-    auto newResource = findClosestResource(
-        m_targetResourceType, tilePos, Constants::MAX_RESOURCE_LOOKUP_RADIUS, m_stateMan.getRef());
+    auto newResource = findClosestResource(m_targetResourceType, tilePos);
 
     if (newResource != entt::null)
     {
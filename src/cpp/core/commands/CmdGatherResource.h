@@ -6,6 +6,7 @@
 #include "Player.h"
 #include "ServiceRegistry.h"
 #include "Settings.h"
+#include "SpatialGrid.h"
 #include "StateManager.h"
 #include "commands/CmdDropResource.h"
 #include "commands/CmdMove.h"
@@ -21,8 +22,6 @@
 #include "utils/ObjectPool.h"
 
 #include <algorithm>
-#include <queue>
-#include <unordered_set>
 
 namespace core
 {
@@ -37,37 +36,18 @@ class CmdGatherResource : public Command
      * @brief Finds the closest resource entity of the specified type within a given radius from a
      * starting tile.
      *
-     * Performs a breadth-first search (BFS) starting from the provided tile, expanding outward up
-     * to maxRadius tiles. Returns the entity ID of the closest resource found, or entt::null if
-     * none is found within the radius.
+     * Queries the ResourceIndex, i.e. the cost depends on the distance to the closest resource
+     * rather than the radius. Returns the entity ID of the closest resource found, or entt::null
+     * if none is found within the radius.
      *
      * @param resourceType The type of resource to search for.
      * @param startTile The tile from which to start the search.
-     * @param maxRadius The maximum search radius (in tiles).
+     * @param maxRadius The maximum search radius (in tiles), the whole map by default.
      * @return uint32_t The entity ID of the closest resource, or entt::null if not found.
      */
     static uint32_t findClosestResource(uint8_t resourceType,
                                         const Tile& startTile,
-                                        int maxRadius,
-                                        Ref<StateManager> stateMan);
-
-    /**
-     * @brief Checks if the specified tile contains a resource of the given type.
-     *
-     * This function examines the tile at the provided position to determine if it contains
-     * a resource matching the specified resource type. If such a resource is found,
-     * the resource is returned via argument and the function returns true.
-     *
-     * @param resourceType The type of resource to check for.
-     * @param posTile The tile position to inspect.
-     * @param resourceEntity Output parameter that receives the entity ID of the resource if found;
-     * set to entt::null otherwise.
-     * @return true if the tile contains a resource of the specified type; false otherwise.
-     */
-    static bool doesTileHaveResource(uint8_t resourceType,
-                                     const Tile& posTile,
-                                     uint32_t& resourceEntity,
-                                     Ref<StateManager> stateMan);
+                                        int maxRadius = SpatialGrid::UNLIMITED_RADIUS);
 
   private:
     // TODO: This doesn't belong here, this should be in the components
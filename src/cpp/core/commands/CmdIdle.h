@@ -8,7 +8,10 @@
 #include "logging/Logger.h"
 #include "utils/ObjectPool.h"
 
+#include <algorithm>
 #include <random>
+#include <span>
+#include <vector>
 
 namespace core
 {
@@ -26,6 +29,33 @@ class CmdIdle : public Command
         *this = other;
     }
 
+    /**
+     * Batch kernel for CommandCenter. Equivalent to onExecute of each command, but reads
+     * the settings once and marks the animated units dirty with a single lock.
+     */
+    static void executeBatch(std::span<Command* const> commands,
+                             int deltaTimeMs,
+                             int currentTick,
+                             std::span<uint8_t> completed)
+    {
+        if (commands.empty())
+            return;
+
+        auto& settings = static_cast<CmdIdle*>(commands[0])->m_settings;
+        const auto ticksPerSecond = settings->getTicksPerSecond();
+
+        thread_local std::vector<uint32_t> animated;
+        animated.clear();
+        for (auto command : commands)
+        {
+            auto idle = static_cast<CmdIdle*>(command);
+            if (idle->animate(ticksPerSecond, currentTick))
+                animated.push_back(idle->m_entityID);
+        }
+        StateManager::markDirty(animated);
+        std::fill(completed.begin(), completed.end(), 0); // Idling never completes
+    }
+
   private:
     void onStart() override
     {
@@ -45,6 +75,7 @@ class CmdIdle : public Command
         std::uniform_int_distribution<> dist(0, actionAnimation.frames - 1);
         int randomFrame = dist(gen);
 
+        m_components->animation.stop();
         m_components->animation.frame = randomFrame;
     }
 
@@ -65,7 +96,8 @@ class CmdIdle : public Command
      */
     bool onExecute(int deltaTimeMs, int currentTick, std::list<Command*>& subCommands) override
     {
-        animate(currentTick);
+        if (animate(m_settings->getTicksPerSecond(), currentTick))
+            StateManager::markDirty(m_entityID);
         return false; // Idling never completes
     }
 
@@ -84,18 +116,18 @@ class CmdIdle : public Command
         ObjectPool<CmdIdle>::release(this);
     }
 
-    void animate(int currentTick)
+    // Returns true if the playback (re)started, i.e. the unit has to be marked dirty
+    bool animate(int ticksPerSecond, int currentTick)
     {
         m_components->action.action = UnitAction::IDLE;
         const auto& actionAnimation = m_components->animation.animations[UnitAction::IDLE];
 
-        auto ticksPerFrame = m_settings->getTicksPerSecond() / actionAnimation.speed;
-        if (currentTick % (int) ticksPerFrame == 0)
-        {
-            StateManager::markDirty(m_entityID);
-            m_components->animation.frame++;
-            m_components->animation.frame %= actionAnimation.frames; // Idle is always repeatable
-        }
+        auto ticksPerFrame = (int) (ticksPerSecond / actionAnimation.speed);
+        // Idle is always repeatable and the renderer loops it, nothing else to do for a
+        // while. A new command wakes the unit up anyway.
+        sleepUntil(currentTick + ticksPerSecond);
+
+        return m_components->animation.loop(UnitAction::IDLE, currentTick, ticksPerFrame);
     }
 };
 } // namespace core
@@ -1,10 +1,13 @@
 #include "commands/CmdMeleeAttack.h"
 
+#include "EnemyQueryService.h"
 #include "ProximityChecker.h"
 #include "components/CompUnit.h"
 
 void core::CmdMeleeAttack::onStart()
 {
+    debug_assert(m_components->meleeAttack != nullptr, "Entity {} can't melee attack",
+                 m_entityID);
     timeSinceLastAttackMs = 0;
     m_components->unit.formationSlot = FormationSlot();
 }
@@ -28,16 +31,8 @@ bool core::CmdMeleeAttack::onExecute(int deltaTimeMs,
         moveCloser(subCommands);
     }
 
-    bool isCompleted = isComplete();
-    if (isCompleted)
-    {
-        /*if (not lookForAnotherToAttack(subCommands))
-        {
-            lookForAnotherToAttack(subCommands);
-        }*/
-    }
-
-    return isCompleted;
+    // Carry on with the nearest enemy around once the target is down
+    return isComplete() and not lookForAnotherToAttack();
 }
 
 std::string core::CmdMeleeAttack::toString() const
@@ -58,7 +53,7 @@ void core::CmdMeleeAttack::destroy()
 void core::CmdMeleeAttack::attack(int deltaTimeMs)
 {
     const auto reloadTimeMs =
-        1000.0f / (m_components->meleeAttack.attackRate * m_settings->getGameSpeed());
+        1000.0f / (m_components->meleeAttack->attackRate * m_settings->getGameSpeed());
     timeSinceLastAttackMs += deltaTimeMs;
 
     if (timeSinceLastAttackMs >= reloadTimeMs)
@@ -86,12 +81,9 @@ void core::CmdMeleeAttack::animate(int deltaTimeMs, int currentTick)
 
     auto ticksPerFrame =
         int(m_settings->getTicksPerSecond() / (actionAnimation.speed * m_settings->getGameSpeed()));
-    if (currentTick % ticksPerFrame == 0)
-    {
+    // Attacking is repeatable, the renderer loops it
+    if (m_components->animation.loop(UnitAction::ATTACK, currentTick, ticksPerFrame))
         StateManager::markDirty(m_entityID);
-        m_components->animation.frame++;
-        m_components->animation.frame %= actionAnimation.frames; // Attacking is repeatable
-    }
 }
 
 bool core::CmdMeleeAttack::isCloseEnough()
@@ -109,6 +101,21 @@ bool core::CmdMeleeAttack::isComplete()
     return targetHealth.health <= 0;
 }
 
+bool core::CmdMeleeAttack::lookForAnotherToAttack()
+{
+    // Plain radius lookup as far as the unit sees, whether anything blocks the view (i.e.
+    // the actual line of sight) isn't considered
+    const int range = m_components->vision.lineOfSight / Constants::FEET_PER_TILE;
+    auto next = m_enemyQuery->findNearestEnemy(*m_components->player.player,
+                                               m_components->transform.position.toTile(), range);
+    if (next == entt::null)
+        return false;
+
+    spdlog::debug("Target {} is down, attacking {} next", target, next);
+    target = next;
+    return true;
+}
+
 void core::CmdMeleeAttack::moveCloser(std::list<Command*>& newCommands)
 {
     debug_assert(target != entt::null, "Proposed entity to attack is null");
@@ -127,10 +134,10 @@ void core::CmdMeleeAttack::moveCloser(std::list<Command*>& newCommands)
 float core::CmdMeleeAttack::getDamage(const CompArmor& target) const
 {
     float totalDamage = 0.0f;
-    for (size_t i = 0; i < m_components->meleeAttack.attackPerClass.value().size(); ++i)
+    for (size_t i = 0; i < m_components->meleeAttack->attackPerClass.value().size(); ++i)
     {
-        auto multipliedAttack = m_components->meleeAttack.attackPerClass[i] *
-                                m_components->meleeAttack.attackMultiplierPerClass[i];
+        auto multipliedAttack = m_components->meleeAttack->attackPerClass[i] *
+                                m_components->meleeAttack->attackMultiplierPerClass[i];
         auto damage = std::max(0.0f, multipliedAttack - target.armorPerClass[i]);
         totalDamage += damage;
     }
@@ -9,10 +9,13 @@
 #include "components/CompHealth.h"
 #include "components/CompMeleeAttack.h"
 #include "components/CompTransform.h"
+#include "utils/LazyServiceRef.h"
 #include "utils/ObjectPool.h"
 
 namespace core
 {
+class EnemyQueryService;
+
 class CmdMeleeAttack : public Command
 {
   public:
@@ -33,10 +36,12 @@ class CmdMeleeAttack : public Command
     void animate(int deltaTimeMs, int currentTick);
     bool isCloseEnough();
     bool isComplete();
+    bool lookForAnotherToAttack();
     void moveCloser(std::list<Command*>& newCommands);
 
   private:
     int timeSinceLastAttackMs = 0;
+    LazyServiceRef<EnemyQueryService> m_enemyQuery;
 };
 
 } // namespace core
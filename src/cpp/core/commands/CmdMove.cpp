@@ -22,6 +22,8 @@
 #include "logging/Logger.h"
 #include "utils/ObjectPool.h"
 
+#include <limits>
+
 using namespace core;
 
 void CmdMove::onStart()
@@ -137,6 +139,20 @@ bool CmdMove::onExecute(int deltaTimeMs, int currentTick, std::list<Command*>& s
     return move(deltaTimeMs);
 }
 
+void CmdMove::executeBatch(std::span<Command* const> commands,
+                           int deltaTimeMs,
+                           int currentTick,
+                           std::span<uint8_t> completed)
+{
+    std::list<Command*> unused; // Moves never create sub-commands
+    for (size_t i = 0; i < commands.size(); ++i)
+    {
+        // Batch holds only the exact type, hence the qualified (non-virtual) call is safe
+        auto move = static_cast<CmdMove*>(commands[i]);
+        completed[i] = move->CmdMove::onExecute(deltaTimeMs, currentTick, unused);
+    }
+}
+
 std::string CmdMove::toString() const
 {
     return "move";
@@ -155,14 +171,13 @@ void CmdMove::animate(int deltaTimeMs, int currentTick)
     m_components->action.action = actionOverride;
     const auto& actionAnimation = m_components->animation.animations[m_components->action.action];
 
-    auto ticksPerFrame =
-        int(m_settings->getTicksPerSecond() / (actionAnimation.speed * m_settings->getGameSpeed()));
-    if (currentTick % ticksPerFrame == 0)
-    {
+    // A still animation (i.e. zero speed) holds its frame, loop clamps the rest to a tick
+    const auto frameRate = actionAnimation.speed * m_settings->getGameSpeed();
+    const int ticksPerFrame = frameRate > 0 ? int(m_settings->getTicksPerSecond() / frameRate)
+                                            : std::numeric_limits<int>::max();
+    // Renderer plays the frames, only a new playback is sent
+    if (m_components->animation.loop(actionOverride, currentTick, ticksPerFrame))
         StateManager::markDirty(m_entityID);
-        m_components->animation.frame++;
-        m_components->animation.frame %= actionAnimation.frames;
-    }
 }
 
 /**
@@ -252,7 +267,12 @@ void CmdMove::updateUnitPosition(int deltaTimeMs, const Feet& forwardDir)
         publishEvent(Event::Type::UNIT_TILE_MOVEMENT,
                      UnitTileMovementData{m_entityID, newTile, m_components->transform.position});
     }
-    m_components->transform.position = newPos;
+    if (newPos != m_components->transform.position)
+    {
+        m_components->transform.position = newPos;
+        // Only the dirty entities reach the renderer and the vision, once per tick moved
+        StateManager::markDirty(m_entityID);
+    }
 }
 
 Feet CmdMove::avoidCollision(int deltaTimeMs, const Feet& goalPos)
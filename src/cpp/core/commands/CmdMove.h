@@ -10,6 +10,7 @@
 
 #include <entt/entity/registry.hpp>
 #include <list>
+#include <span>
 
 namespace core
 {
@@ -34,6 +35,12 @@ class CmdMove : public Command
     // attacks.
     float collisionRadius = std::numeric_limits<float>::max();
 
+    // Batch kernel for CommandCenter, executes plain moves without virtual dispatch
+    static void executeBatch(std::span<Command* const> commands,
+                             int deltaTimeMs,
+                             int currentTick,
+                             std::span<uint8_t> completed);
+
   protected:
     void animate(int deltaTimeMs, int currentTick);
     bool move(int deltaTimeMs);
@@ -1,6 +1,7 @@
 #include "CmdRangeAttack.h"
 
 #include "CmdMove.h"
+#include "EnemyQueryService.h"
 #include "EventPublisher.h"
 #include "ProximityChecker.h"
 #include "components/CompAction.h"
@@ -14,8 +15,12 @@ using namespace core;
 
 void CmdRangeAttack::onStart()
 {
+    debug_assert(m_components->rangeAttack != nullptr, "Entity {} can't range attack",
+                 m_entityID);
     timeSinceLastAnimationEndMs = 0;
     m_components->unit.formationSlot = FormationSlot();
+    // Stepped here, projectiles are released at a specific frame
+    m_components->animation.stop();
     m_components->animation.frame = 0;
 }
 
@@ -35,17 +40,8 @@ bool CmdRangeAttack::onExecute(int deltaTimeMs, int currentTick, std::list<Comma
         moveCloser(subCommands);
     }
 
-    bool isCompleted = isComplete();
-    if (isCompleted)
-    {
-        // TODO: Implement
-        /*if (not lookForAnotherToAttack(subCommands))
-        {
-            lookForAnotherToAttack(subCommands);
-        }*/
-    }
-
-    return isCompleted;
+    // Carry on with the nearest enemy around once the target is down
+    return isComplete() and not lookForAnotherToAttack();
 }
 
 std::string CmdRangeAttack::toString() const
@@ -69,14 +65,11 @@ void CmdRangeAttack::attack(int deltaTimeMs)
     {
         auto& targetTransform = m_stateMan->getComponent<CompTransform>(target);
 
-        auto& projectile = m_components->rangeAttack.primaryProjectile.value();
-
-        auto projectileEntityType = m_components->rangeAttack.projectileEntityType;
-        auto projectileEntity = m_entityFactory->createEntity(projectileEntityType);
-        auto releaseHeight = m_components->rangeAttack.projectileReleaseHeight;
-        ProjectileData data(projectileEntity, m_components->transform.position,
-                            targetTransform.position, projectile,
-                            m_components->rangeAttack.projectileSpeed, releaseHeight);
+        auto projectileEntityType = m_components->rangeAttack->projectileEntityType;
+        auto releaseHeight = m_components->rangeAttack->projectileReleaseHeight;
+        ProjectileData data(projectileEntityType, m_components->transform.position,
+                            targetTransform.position, m_components->rangeAttack->projectileSpeed,
+                            releaseHeight, m_components->rangeAttack->primaryProjectile.value());
 
         publishEvent(Event::Type::PROJECTILE_CREATED, data);
 
@@ -98,7 +91,7 @@ void CmdRangeAttack::animate(int deltaTimeMs, int currentTick)
     // If the animation is finished, wait reloadTime
     if (m_components->animation.frame >= (actionAnimation.frames - 1))
     {
-        auto& projectile = m_components->rangeAttack.primaryProjectile.value();
+        auto& projectile = *m_components->rangeAttack->primaryProjectile.value();
         // TODO: Incorporate game speed
         const auto reloadTimeMs = projectile.reloadTimeS * 1000;
         timeSinceLastAnimationEndMs += deltaTimeMs;
@@ -125,7 +118,7 @@ void CmdRangeAttack::animate(int deltaTimeMs, int currentTick)
             m_components->transform.face(targetTransform.position);
         }
 
-        if (m_components->animation.frame == m_components->rangeAttack.projectileReleaseFrame)
+        if (m_components->animation.frame == m_components->rangeAttack->projectileReleaseFrame)
             createProjectile = true;
 
         StateManager::markDirty(m_entityID);
@@ -137,7 +130,7 @@ void CmdRangeAttack::animate(int deltaTimeMs, int currentTick)
 bool CmdRangeAttack::isCloseEnough()
 {
     return ProximityChecker::isInProximity(m_components->transform.position,
-                                           m_components->rangeAttack.attackRange, target,
+                                           m_components->rangeAttack->attackRange, target,
                                            m_stateMan.getRef());
 }
 
@@ -149,6 +142,21 @@ bool CmdRangeAttack::isComplete()
     return targetHealth.health <= 0;
 }
 
+bool CmdRangeAttack::lookForAnotherToAttack()
+{
+    // Plain radius lookup as far as the unit sees, whether anything blocks the view (i.e.
+    // the actual line of sight) isn't considered
+    const int range = m_components->vision.lineOfSight / Constants::FEET_PER_TILE;
+    auto next = m_enemyQuery->findNearestEnemy(*m_components->player.player,
+                                               m_components->transform.position.toTile(), range);
+    if (next == entt::null)
+        return false;
+
+    spdlog::debug("Target {} is down, attacking {} next", target, next);
+    target = next;
+    return true;
+}
+
 void CmdRangeAttack::moveCloser(std::list<Command*>& newCommands)
 {
     const auto& targetPosition = m_stateMan->getComponent<CompTransform>(target).position;
@@ -156,7 +164,7 @@ void CmdRangeAttack::moveCloser(std::list<Command*>& newCommands)
     spdlog::debug("Target {} at {} (tile {}) is not close enough to attack, moving...", target,
                   targetPosition.toString(), targetPosition.toTile().toString());
     auto moveCmd = ObjectPool<CmdMove>::acquire();
-    moveCmd->collisionRadius = m_components->rangeAttack.attackRange;
+    moveCmd->collisionRadius = m_components->rangeAttack->attackRange;
     moveCmd->target.emplace(target);
     moveCmd->setPriority(getPriority() + CHILD_PRIORITY_OFFSET);
     newCommands.push_back(moveCmd);
@@ -2,10 +2,11 @@
 #define CORE_CMDRANGEATTACK_H
 
 #include "Command.h"
-#include "EntityFactory.h"
 
 namespace core
 {
+class EnemyQueryService;
+
 class CmdRangeAttack : public Command
 {
   public:
@@ -23,12 +24,13 @@ class CmdRangeAttack : public Command
     void animate(int deltaTimeMs, int currentTick);
     bool isCloseEnough();
     bool isComplete();
+    bool lookForAnotherToAttack();
     void moveCloser(std::list<Command*>& newCommands);
 
     int timeSinceLastAnimationEndMs = 0;
     bool createProjectile = false;
 
-    LazyServiceRef<EntityFactory> m_entityFactory;
+    LazyServiceRef<EnemyQueryService> m_enemyQuery;
 };
 } // namespace core
 
@@ -9,6 +9,7 @@
 
 #include <entt/entity/registry.hpp>
 #include <list>
+#include <utility>
 
 namespace core
 {
@@ -70,7 +71,7 @@ class Command
 
     void init()
     {
-        m_components = std::make_shared<UnitComponentRefs>(m_stateMan.getRef(), m_entityID);
+        m_components.bind(*m_stateMan.getRef(), m_entityID);
     }
 
     uint32_t getEntityID() const
@@ -88,23 +89,35 @@ class Command
         m_executedAtLeastOnce = executed;
     }
 
+    /**
+     * @brief Returns and clears the tick requested via sleepUntil, 0 if none.
+     */
+    inline int takeSleepRequest()
+    {
+        return std::exchange(m_sleepUntilTick, 0);
+    }
+
   protected:
+    /**
+     * @brief Requests CommandCenter to skip the unit until the given tick.
+     *
+     * Meant for commands having nothing to do until a known tick (e.g. the next animation
+     * frame). Applies only if the command didn't complete nor created new commands in the
+     * current execution. The unit wakes up earlier if it receives a new command.
+     */
+    void sleepUntil(int tick)
+    {
+        m_sleepUntilTick = tick;
+    }
+
     LazyServiceRef<Settings> m_settings;
     LazyServiceRef<StateManager> m_stateMan;
     int m_priority = -1;
     uint32_t m_entityID = entt::null;
-    Ref<UnitComponentRefs> m_components;
+    UnitComponentRefsStorage m_components;
 
     bool m_executedAtLeastOnce = false;
-};
-
-// Comparator to use Commands in priority_queue
-struct CompareTaskPtr
-{
-    bool operator()(const Command* a, const Command* b) const
-    {
-        return a->getPriority() < b->getPriority(); // max-heap: higher m_priority = top
-    }
+    int m_sleepUntilTick = 0;
 };
 
 } // namespace core
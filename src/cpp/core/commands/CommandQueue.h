@@ -0,0 +1,143 @@
+#ifndef COMMANDQUEUE_H
+#define COMMANDQUEUE_H
+
+#include "commands/Command.h"
+#include "debug.h"
+
+#include <array>
+#include <cstddef>
+
+namespace core
+{
+/*
+ *   Per unit command queue with a fixed inline capacity, i.e. queuing and completing
+ *   commands never allocate.
+ *
+ *   Commands are kept sorted by priority with the top at the back. Among the commands
+ *   of equal priority, the earlier queued one stays on top (i.e. FIFO). The command
+ *   pointer itself is the handle for removal. Removing the top, which is the common
+ *   case (i.e. the executing command completed), is O(1), any other is bounded by the
+ *   capacity.
+ */
+class CommandQueue
+{
+  public:
+    // Default command, a command, its sub-command and a few follow-ups
+    static constexpr size_t CAPACITY = 8;
+
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    bool full() const
+    {
+        return m_size == CAPACITY;
+    }
+
+    Command* top() const
+    {
+        debug_assert(m_size > 0, "Command queue is empty");
+        return m_commands[m_size - 1];
+    }
+
+    // Returns false if the queue is full, the command isn't queued then
+    bool push(Command* command)
+    {
+        debug_assert(m_size < CAPACITY, "Command queue is full, can't queue {}",
+                     command->toString());
+        if (m_size == CAPACITY) [[unlikely]]
+            return false;
+
+        // Below every command with the same or higher priority
+        size_t index = 0;
+        while (index < m_size and m_commands[index]->getPriority() < command->getPriority())
+        {
+            ++index;
+        }
+        for (size_t i = m_size; i > index; --i)
+        {
+            m_commands[i] = m_commands[i - 1];
+        }
+        m_commands[index] = command;
+        ++m_size;
+        return true;
+    }
+
+    void pop()
+    {
+        debug_assert(m_size > 0, "Command queue is empty");
+        --m_size;
+    }
+
+    // Returns false if the command isn't in the queue
+    bool remove(Command* command)
+    {
+        if (m_size > 0 and m_commands[m_size - 1] == command) [[likely]]
+        {
+            --m_size;
+            return true;
+        }
+
+        for (size_t index = 0; index < m_size; ++index)
+        {
+            if (m_commands[index] == command)
+            {
+                for (size_t i = index; i + 1 < m_size; ++i)
+                {
+                    m_commands[i] = m_commands[i + 1];
+                }
+                --m_size;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Removes the commands matching the predicate, keeping the order of the others
+    template <typename Pred> void removeIf(Pred&& pred)
+    {
+        size_t kept = 0;
+        for (size_t i = 0; i < m_size; ++i)
+        {
+            if (not pred(m_commands[i]))
+            {
+                m_commands[kept++] = m_commands[i];
+            }
+        }
+        m_size = kept;
+    }
+
+    // Destroys every queued command but the given one (e.g. the executing command, which
+    // stays queued for the CommandCenter to complete as usual)
+    void clearAndDestroy(const Command* except = nullptr)
+    {
+        removeIf(
+            [except](Command* command)
+            {
+                if (command == except)
+                    return false;
+
+                command->destroy();
+                return true;
+            });
+    }
+
+    // Forgets the commands without destroying them, e.g. the ones of a copied queue
+    void clear()
+    {
+        m_size = 0;
+    }
+
+  private:
+    std::array<Command*, CAPACITY> m_commands{};
+    size_t m_size = 0;
+};
+} // namespace core
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef COMMANDTASK_H
+#define COMMANDTASK_H
+
+#include "utils/CoroutineFramePool.h"
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+namespace core
+{
+/*
+ *   Coroutine type of the coroutine commands (see CmdCoroutine). Starts suspended,
+ *   the owning command resumes it from its onExecute. Frames come from the
+ *   CoroutineFramePool, so running a command doesn't allocate in the steady state.
+ */
+class CommandTask
+{
+  public:
+    struct promise_type
+    {
+        CommandTask get_return_object()
+        {
+            return CommandTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_always final_suspend() noexcept
+        {
+            return {};
+        }
+
+        void return_void()
+        {
+        }
+
+        void unhandled_exception()
+        {
+            exception = std::current_exception();
+        }
+
+        static void* operator new(size_t size)
+        {
+            return CoroutineFramePool::allocate(size);
+        }
+
+        static void operator delete(void* frame, size_t size)
+        {
+            CoroutineFramePool::release(frame, size);
+        }
+
+        std::exception_ptr exception;
+    };
+
+    CommandTask() = default;
+
+    CommandTask(CommandTask&& other) noexcept : m_handle(std::exchange(other.m_handle, nullptr))
+    {
+    }
+
+    CommandTask& operator=(CommandTask&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            m_handle = std::exchange(other.m_handle, nullptr);
+        }
+        return *this;
+    }
+
+    CommandTask(const CommandTask&) = delete;
+    CommandTask& operator=(const CommandTask&) = delete;
+
+    ~CommandTask()
+    {
+        reset();
+    }
+
+    // Runs until the next suspension point. Rethrows if the coroutine threw.
+    void resume()
+    {
+        m_handle.resume();
+        if (m_handle.promise().exception) [[unlikely]]
+            std::rethrow_exception(std::exchange(m_handle.promise().exception, nullptr));
+    }
+
+    bool done() const
+    {
+        return m_handle.done();
+    }
+
+    void reset()
+    {
+        if (m_handle)
+            m_handle.destroy();
+        m_handle = nullptr;
+    }
+
+    explicit operator bool() const
+    {
+        return bool(m_handle);
+    }
+
+  private:
+    explicit CommandTask(std::coroutine_handle<promise_type> handle) : m_handle(handle)
+    {
+    }
+
+    std::coroutine_handle<promise_type> m_handle;
+};
+} // namespace core
+
+#endif
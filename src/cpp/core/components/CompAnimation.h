@@ -4,8 +4,34 @@
 #include "Property.h"
 #include "utils/Constants.h"
 
+#include <algorithm>
+
 namespace core
 {
+/*
+ *   Looping animation the renderer plays on its own. The frame at a tick is derived
+ *   from the start of the playback, hence the simulation sends the playback once
+ *   instead of every frame change.
+ */
+struct AnimationPlayback
+{
+    int action = -1; // Not playing if negative
+    int startTick = 0;
+    int startFrame = 0;
+    int ticksPerFrame = 1;
+    int frames = 1;
+
+    bool isPlaying() const
+    {
+        return action >= 0;
+    }
+
+    int getFrameAt(int tick) const
+    {
+        return (startFrame + std::max(tick - startTick, 0) / ticksPerFrame) % frames;
+    }
+};
+
 class CompAnimation
 {
   public:
@@ -19,8 +45,39 @@ class CompAnimation
     Property<std::array<ActionAnimation, Constants::MAX_ANIMATIONS>> animations{};
 
   public:
-    int frame = 0;
+    int frame = 0; // The frame to start from while playing
     GraphicLayer layer = GraphicLayer::NONE;
+    AnimationPlayback playback;
+
+    /*
+     *   Loops the animation of the action from the current frame, unless it is already
+     *   looping at the same rate. Returns true if the playback changed, i.e. the entity
+     *   has to be marked dirty.
+     */
+    bool loop(int action, int currentTick, int ticksPerFrame)
+    {
+        ticksPerFrame = std::max(ticksPerFrame, 1);
+        if (playback.action == action and playback.ticksPerFrame == ticksPerFrame)
+            return false;
+
+        const int frames = std::max(animations.value()[action].frames, 1);
+        if (playback.isPlaying())
+            frame = playback.getFrameAt(currentTick);
+
+        frame %= frames;
+        playback = AnimationPlayback{.action = action,
+                                     .startTick = currentTick,
+                                     .startFrame = frame,
+                                     .ticksPerFrame = ticksPerFrame,
+                                     .frames = frames};
+        return true;
+    }
+
+    // For the animations the simulation steps itself (e.g. to act on a specific frame)
+    void stop()
+    {
+        playback = AnimationPlayback();
+    }
 };
 } // namespace core
 
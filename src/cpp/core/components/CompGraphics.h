@@ -2,10 +2,12 @@
 #define COMPGRAPHICS_H
 
 #include "Color.h"
+#include "CompAnimation.h"
 #include "CompBuilding.h"
 #include "Feet.h"
 #include "GraphicAddon.h"
 #include "GraphicsRegistry.h" // For GraphicsID
+#include "utils/Constants.h"
 #include "utils/Size.h"
 
 #include <array>
@@ -61,12 +63,18 @@ class CompGraphics : public GraphicsID
      *   4. positionInScreenUnits: Absolute screen position in pixels.
      */
     Feet positionInFeet = Feet::null;
+    // Of the previous tick, the renderer moves the graphic from it to positionInFeet in between
+    // the ticks (see getInterpolatedPosition)
+    Feet previousPositionInFeet = Feet::null;
+    int positionTick = 0; // Tick the two positions above were taken at
     Vec2 positionInScreenUnits;
     Vec2 relativePixelPosition = Vec2::zero;
     Vec2 selfRelativePixelPosition = Vec2::zero;
 
     std::vector<DebugOverlay> debugOverlays;
     std::vector<GraphicAddon> addons;
+    // Renderer advances the frame itself while playing (for the same action only)
+    AnimationPlayback playback;
     Color shading;
     bool isDestroyed = false;
     bool isEnabled = true;
@@ -83,6 +91,23 @@ class CompGraphics : public GraphicsID
     {
         return not landArea.tiles.empty();
     }
+
+    // tickProgress is the fraction of the tick interval elapsed since the current tick. Positions
+    // taken at an older tick aren't moving anymore (i.e. only the moved entities are updated),
+    // hence drawn at the latest one.
+    Feet getInterpolatedPosition(float tickProgress, int currentTick) const
+    {
+        // Farther than a tick of movement is a jump (e.g. spawned, left a garrison)
+        constexpr float maxDistance = Constants::FEET_PER_TILE * 2;
+
+        if (positionTick != currentTick or previousPositionInFeet.isNull() or
+            positionInFeet.isNull() or
+            previousPositionInFeet.distanceSquared(positionInFeet) > maxDistance * maxDistance)
+        {
+            return positionInFeet;
+        }
+        return previousPositionInFeet + (positionInFeet - previousPositionInFeet) * tickProgress;
+    }
 };
 } // namespace core
 
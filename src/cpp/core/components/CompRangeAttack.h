@@ -8,7 +8,7 @@ namespace core
 class CompRangeAttack
 {
   public:
-    Property<ProjectileProperties> primaryProjectile;
+    Property<Ref<const ProjectileProperties>> primaryProjectile; // Immutable once loaded
     Property<std::vector<ProjectileProperties>> secondaryProjectiles;
     Property<ProjectileDamageMode> damageMode;
     Property<uint32_t> projectileEntityType;
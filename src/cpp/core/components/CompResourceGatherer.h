@@ -3,9 +3,11 @@
 
 #include "InGameResource.h"
 #include "Property.h"
+#include "Tile.h"
 #include "utils/Constants.h"
 #include "utils/Types.h"
 
+#include <entt/entity/registry.hpp>
 #include <unordered_map>
 
 namespace core
@@ -21,8 +23,18 @@ class CompResourceGatherer
     Property<uint32_t> capacity;
     Property<uint32_t> gatherSpeed;
 
+    // Last drop-off point lookup of the gatherer (see CmdDropResource)
+    struct DropOffCache
+    {
+        uint32_t entity = entt::null;
+        uint32_t indexVersion = 0; // DropOffIndex version of the player at the lookup
+        uint8_t resourceType = Constants::RESOURCE_TYPE_NONE;
+        Tile from;
+    };
+
   public:
     uint32_t gatheredAmount = 0;
+    DropOffCache dropOffCache;
 
     static bool canGather(uint8_t resourceType)
     {
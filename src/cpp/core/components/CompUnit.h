@@ -3,14 +3,10 @@
 
 #include "BaseUnitFormation.h"
 #include "Property.h"
-#include "commands/Command.h"
-
-#include <queue>
-#include <vector>
+#include "commands/CommandQueue.h"
 
 namespace core
 {
-using CommandQueueType = std::priority_queue<Command*, std::vector<Command*>, CompareTaskPtr>;
 
 class CompUnit
 {
@@ -21,20 +17,20 @@ class CompUnit
   public:
     Property<Ref<Command>> defaultCommand;
 
-    CommandQueueType commandQueue;
+    CommandQueue commandQueue;
     bool isGarrisoned = false;
+    // Tick until which CommandCenter skips the unit, 0 when awake
+    int sleepingUntilTick = 0;
     FormationSlot formationSlot;
 
     void onCreate(uint32_t entity)
     {
-        while (not commandQueue.empty())
-        {
-            commandQueue.pop();
-        }
+        commandQueue.clear();
         auto cloned = defaultCommand.value()->clone();
         cloned->setEntityID(entity);
         cloned->init();
         commandQueue.push(cloned);
+        sleepingUntilTick = 0;
     }
 };
 
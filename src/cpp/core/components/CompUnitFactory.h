@@ -2,8 +2,10 @@
 #define COMPUNITFACTORY_H
 
 #include "Property.h"
+#include "TimerId.h"
 #include "utils/Constants.h"
 
+#include <algorithm>
 #include <tuple>
 #include <vector>
 
@@ -21,7 +23,10 @@ class CompUnitFactory
 
   public:
     std::vector<uint32_t> productionQueue; // Entity types
-    float currentUnitProgress = 0;
+    // Ticks of the unit in progress (i.e. the front of the queue), both 0 if not started
+    int productionStartTick = 0;
+    int productionEndTick = 0;
+    TimerId productionTimer; // Completion or retry of a paused production
     bool pausedDueToInsufficientHousing = false;
     bool pausedDueToPopulationLimit = false;
 
@@ -33,6 +38,17 @@ class CompUnitFactory
     void onCreate(uint32_t entity)
     {
     }
+
+    // Progress of the unit in progress as a percentage
+    float getProgress(int currentTick) const
+    {
+        if (productionEndTick <= productionStartTick)
+            return 0;
+
+        auto progress = float(currentTick - productionStartTick) * 100.0f /
+                        float(productionEndTick - productionStartTick);
+        return std::clamp(progress, 0.0f, 100.0f);
+    }
 };
 
 } // namespace core
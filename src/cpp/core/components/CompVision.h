@@ -2,6 +2,7 @@
 #define CORE_COMPVISION_H
 
 #include "Property.h"
+#include "Tile.h"
 #include "utils/Types.h"
 
 #include <unordered_set>
@@ -17,6 +18,7 @@ class CompVision
 
   public:
     bool hasVision = false; // Dynamically control whether LOS is in effect
+    Tile sightCenter;       // Where the sight of a unit is counted in the fog of war
     std::unordered_set<uint32_t> nearbyEntities;
 };
 } // namespace core
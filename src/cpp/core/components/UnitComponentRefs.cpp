@@ -17,8 +17,8 @@ UnitComponentRefs::UnitComponentRefs(std::tuple<CompAction&,
                                                 CompTransform&,
                                                 CompUnit&,
                                                 CompVision&> components,
-                                     CompMeleeAttack& attack,
-                                     CompRangeAttack& rangeAttack)
+                                     CompMeleeAttack* attack,
+                                     CompRangeAttack* rangeAttack)
     : action{std::get<0>(components)}, animation{std::get<1>(components)},
       entityInfo{std::get<2>(components)}, player{std::get<3>(components)},
       transform{std::get<4>(components)}, unit{std::get<5>(components)},
@@ -26,19 +26,15 @@ UnitComponentRefs::UnitComponentRefs(std::tuple<CompAction&,
 {
 }
 
-UnitComponentRefs::UnitComponentRefs(Ref<StateManager> stateMan, uint32_t entityID)
-    : UnitComponentRefs(stateMan->getComponents<CompAction,
-                                                CompAnimation,
-                                                CompEntityInfo,
-                                                CompPlayer,
-                                                CompTransform,
-                                                CompUnit,
-                                                CompVision>(entityID),
-                        (stateMan->hasComponent<CompMeleeAttack>(entityID)
-                             ? stateMan->getComponent<CompMeleeAttack>(entityID)
-                             : m_dummyAttack),
-                        (stateMan->hasComponent<CompRangeAttack>(entityID)
-                             ? stateMan->getComponent<CompRangeAttack>(entityID)
-                             : m_dummyRangeAttack))
+UnitComponentRefs::UnitComponentRefs(StateManager& stateMan, uint32_t entityID)
+    : UnitComponentRefs(stateMan.getComponents<CompAction,
+                                               CompAnimation,
+                                               CompEntityInfo,
+                                               CompPlayer,
+                                               CompTransform,
+                                               CompUnit,
+                                               CompVision>(entityID),
+                        stateMan.tryGetComponent<CompMeleeAttack>(entityID),
+                        stateMan.tryGetComponent<CompRangeAttack>(entityID))
 {
 }
\ No newline at end of file
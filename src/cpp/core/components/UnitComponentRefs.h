@@ -7,6 +7,7 @@
 #include "StateManager.h"
 
 #include <cstdint>
+#include <optional>
 #include <tuple>
 
 namespace core
@@ -29,10 +30,11 @@ class UnitComponentRefs
     CompTransform& transform;
     CompUnit& unit;
     CompVision& vision;
-    CompMeleeAttack& meleeAttack;
-    CompRangeAttack& rangeAttack;
+    // Conditional, unlikely that a unit would have both. Null when the unit doesn't have it
+    CompMeleeAttack* meleeAttack = nullptr;
+    CompRangeAttack* rangeAttack = nullptr;
 
-    UnitComponentRefs(Ref<StateManager> stateMan, uint32_t entityID);
+    UnitComponentRefs(StateManager& stateMan, uint32_t entityID);
 
   private:
     UnitComponentRefs(std::tuple<CompAction&,
@@ -42,17 +44,58 @@ class UnitComponentRefs
                                  CompTransform&,
                                  CompUnit&,
                                  CompVision&> components,
-                      CompMeleeAttack& attack,
-                      CompRangeAttack& rangeAttack);
-
-    /*
-     *   meleeAttack and rangeAttack are conditional, unlikely that a unit
-     *   would have both. Yet this class should make command implementation
-     *   easier by providing direct access to attack components. Hence,
-     *   pointing to dummies when not available.
-     */
-    CompMeleeAttack m_dummyAttack;
-    CompRangeAttack m_dummyRangeAttack;
+                      CompMeleeAttack* attack,
+                      CompRangeAttack* rangeAttack);
+};
+
+/*
+ *   Inline storage of UnitComponentRefs for commands, to avoid a heap allocation per
+ *   command. Rebindable, unlike the refs themselves.
+ */
+class UnitComponentRefsStorage
+{
+  public:
+    UnitComponentRefsStorage() = default;
+
+    UnitComponentRefsStorage(const UnitComponentRefsStorage& other)
+    {
+        *this = other;
+    }
+
+    UnitComponentRefsStorage& operator=(const UnitComponentRefsStorage& other)
+    {
+        if (this == &other)
+            return *this;
+
+        m_refs.reset();
+        if (other.m_refs.has_value())
+            m_refs.emplace(*other.m_refs);
+        return *this;
+    }
+
+    void bind(StateManager& stateMan, uint32_t entityID)
+    {
+        m_refs.reset();
+        m_refs.emplace(stateMan, entityID);
+    }
+
+    explicit operator bool() const
+    {
+        return m_refs.has_value();
+    }
+
+    UnitComponentRefs* operator->()
+    {
+        return &m_refs.value();
+    }
+
+    const UnitComponentRefs* operator->() const
+    {
+        return &m_refs.value();
+    }
+
+  private:
+    std::optional<UnitComponentRefs> m_refs;
 };
 } // namespace core
 
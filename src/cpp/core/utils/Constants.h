@@ -21,14 +21,12 @@ class Constants
     static const int MAX_SELECTION_LOOKUP_HEIGHT = 4;
     static const int MAX_RESOURCE_TYPES = 8;
     static const int RESOURCE_TYPE_NONE = 0;
-    // The villager will look MAX_RESOURCE_LOOKUP_RADIUS*MAX_RESOURCE_LOOKUP_RADIUS square for
-    // similar resource once the current resource exhausted
-    static const int MAX_RESOURCE_LOOKUP_RADIUS = 4;
     // A static entity such as building can occupy at most 4x4 tiles
     static const int MAX_STATIC_ENTITY_TILE_SIZE = 4;
-    static const int FIXED_FPS = 60; // Frames per second
-    // Maximum gap between two frames. If the gap is more than this,
-    // frame delay will be capped to this.
+    // Default simulation ticks per second, overridden by Settings::getTicksPerSecond
+    static const int FIXED_FPS = 60;
+    // Maximum backlog of simulation ticks to catch up. If the gap is more than this,
+    // missed ticks are dropped.
     static const int MAX_FRAME_DELAY_MS = 500;
 
     static const int ABSOLUTE_MAX_UNIT_QUEUE_SIZE = 20;
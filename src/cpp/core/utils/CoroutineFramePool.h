@@ -0,0 +1,97 @@
+#ifndef COROUTINEFRAMEPOOL_H
+#define COROUTINEFRAMEPOOL_H
+
+#include <array>
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace core
+{
+/*
+ *   Recycles coroutine frames. Frame size is fixed per coroutine function, hence
+ *   frames are pooled per size class, which effectively makes it a pool per
+ *   coroutine type. Frames larger than the largest class go to the heap directly.
+ *
+ *   Free lists are thread local like ObjectPool's. Frames are plain operator new
+ *   blocks, hence a frame may be released on another thread than the one that
+ *   allocated it (e.g. a command started on a pool worker and destroyed on the event
+ *   loop thread), it just moves to that thread's free list. Since such a thread might
+ *   release more frames than it allocates, a free list keeps at most
+ *   MAX_LOCAL_FREE_FRAMES per size class and frees the rest.
+ */
+class CoroutineFramePool
+{
+  public:
+    CoroutineFramePool() = delete;
+
+    static constexpr size_t GRANULARITY = 64;
+    static constexpr size_t MAX_POOLED_SIZE = 4096;
+    static constexpr size_t MAX_LOCAL_FREE_FRAMES = 1024;
+
+    static void* allocate(size_t size)
+    {
+        if (size > MAX_POOLED_SIZE) [[unlikely]]
+            return ::operator new(size);
+
+        auto& frames = getFreeFrames(size);
+        if (frames.empty())
+            return ::operator new(roundUp(size));
+
+        auto frame = frames.back();
+        frames.pop_back();
+        return frame;
+    }
+
+    static void release(void* frame, size_t size)
+    {
+        if (size > MAX_POOLED_SIZE) [[unlikely]]
+        {
+            ::operator delete(frame);
+            return;
+        }
+        auto& frames = getFreeFrames(size);
+        if (frames.size() >= MAX_LOCAL_FREE_FRAMES)
+        {
+            ::operator delete(frame);
+            return;
+        }
+        frames.push_back(frame);
+    }
+
+    static size_t getFreeCount(size_t size)
+    {
+        return size > MAX_POOLED_SIZE ? 0 : getFreeFrames(size).size();
+    }
+
+  private:
+    static constexpr size_t CLASS_COUNT = MAX_POOLED_SIZE / GRANULARITY;
+
+    static constexpr size_t roundUp(size_t size)
+    {
+        return (size + GRANULARITY - 1) / GRANULARITY * GRANULARITY;
+    }
+
+    struct FreeFrames
+    {
+        std::array<std::vector<void*>, CLASS_COUNT> perClass;
+
+        ~FreeFrames()
+        {
+            for (auto& frames : perClass)
+            {
+                for (auto frame : frames)
+                    ::operator delete(frame);
+            }
+        }
+    };
+
+    static std::vector<void*>& getFreeFrames(size_t size)
+    {
+        static thread_local FreeFrames s_freeFrames;
+        return s_freeFrames.perClass[roundUp(size) / GRANULARITY - 1];
+    }
+};
+} // namespace core
+
+#endif
@@ -256,6 +256,7 @@ enum class LineOfSightShape
 {
     CIRCLE = 0,
     ROUNDED_SQUARE,
+    OCCLUDED_CIRCLE, // Circle, blocked by the buildings and trees in between
 
     UNKNOWN
 };
@@ -41,6 +41,7 @@ extern std::vector<int> getAttackOrArmorPerClass(const std::any&);
 extern std::vector<float> getMultiplierPerClass(const std::any&);
 extern core::ProjectileDamageMode getProjectileDamageMode(const std::any&);
 extern core::ProjectileProperties getProjectile(const std::any&);
+extern core::Ref<const core::ProjectileProperties> getSharedProjectile(const std::any&);
 extern std::vector<core::ProjectileProperties> getProjectilesList(const std::any&);
 
 namespace game
@@ -202,7 +203,7 @@ class ComponentModelMapper
             ModelPropertyMapping<&core::CompMeleeAttack::attackPerClass>            ("Attack", "attack", getAttackOrArmorPerClass),
             ModelPropertyMapping<&core::CompMeleeAttack::attackMultiplierPerClass>  ("Attack", "attack_multiplier", getMultiplierPerClass),
             ModelPropertyMapping<&core::CompHealth::maxHealth>                      ("Health", "health"),
-            ModelPropertyMapping<&core::CompRangeAttack::primaryProjectile>         ("RangeAttack", "primary_projectile", getProjectile),
+            ModelPropertyMapping<&core::CompRangeAttack::primaryProjectile>         ("RangeAttack", "primary_projectile", getSharedProjectile),
             ModelPropertyMapping<&core::CompRangeAttack::secondaryProjectiles>      ("RangeAttack", "secondary_projectiles", getProjectilesList),
             ModelPropertyMapping<&core::CompRangeAttack::damageMode>                ("RangeAttack", "damage_mode", getProjectileDamageMode),
             ModelPropertyMapping<&core::CompRangeAttack::projectileEntityType>      ("RangeAttack", "projectile_entity_type", getEntityType),
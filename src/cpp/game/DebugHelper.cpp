@@ -10,6 +10,11 @@ DebugHelper::DebugHelper()
 {
     registerCallback(Event::Type::TICK, this, &DebugHelper::onTick);
     registerCallback(Event::Type::KEY_UP, this, &DebugHelper::onKeyUp);
+
+    declareAccess(SystemAccess()
+                      .reads<DensityGrid, TileMap>()
+                      .writes<CompGraphics>()
+                      .appends<DirtyEntities>());
 }
 
 DebugHelper::~DebugHelper()
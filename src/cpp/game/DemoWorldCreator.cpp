@@ -48,6 +48,8 @@ using namespace std;
 
 DemoWorldCreator::DemoWorldCreator(const Params& params) : WorldCreator(params)
 {
+    // Doesn't act on TICK
+    declareAccess(SystemAccess());
 }
 
 bool DemoWorldCreator::isReady() const
@@ -163,7 +165,9 @@ void DemoWorldCreator::createVillager(Ref<core::Player> player, const Tile& tile
     auto newTile = transform.position.toTile();
     stateMan->gameMap().addEntity(MapLayerType::UNITS, newTile, villager);
 
-    player->getFogOfWar()->markAsExplored(transform.position, vision.lineOfSight);
+    player->getVision()->addSight(newTile, vision.lineOfSight);
+    vision.sightCenter = newTile;
+    vision.hasVision = true;
 }
 
 void DemoWorldCreator::createMilitaryUnit(const std::string& type,
@@ -188,7 +192,9 @@ void DemoWorldCreator::createMilitaryUnit(const std::string& type,
     auto newTile = transform.position.toTile();
     stateMan->gameMap().addEntity(MapLayerType::UNITS, newTile, villager);
 
-    player->getFogOfWar()->markAsExplored(transform.position, vision.lineOfSight);
+    player->getVision()->addSight(newTile, vision.lineOfSight);
+    vision.sightCenter = newTile;
+    vision.hasVision = true;
 }
 
 void DemoWorldCreator::createMiningCluster(uint32_t entityType,
@@ -1067,6 +1067,8 @@ LineOfSightShape getLOSShape(const std::string& name)
         return LineOfSightShape::CIRCLE;
     else if (name == "rounded_square")
         return LineOfSightShape::ROUNDED_SQUARE;
+    else if (name == "occluded_circle")
+        return LineOfSightShape::OCCLUDED_CIRCLE;
     else
     {
         debug_assert(false, "unknown line-of-sight shape");
@@ -1220,6 +1222,11 @@ core::ProjectileProperties getProjectile(const std::any& value)
     return ProjectileProperties(attacks, attackMultipliers, accuracy, reloadTimeS);
 }
 
+core::Ref<const core::ProjectileProperties> getSharedProjectile(const std::any& value)
+{
+    return CreateRef<const ProjectileProperties>(getProjectile(value));
+}
+
 std::vector<core::ProjectileProperties> getProjectilesList(const std::any& value)
 {
     auto pyObj = std::any_cast<py::object>(value);
@@ -9,6 +9,8 @@
 #include "DebugHelper.h"
 #include "DebugWindow.h"
 #include "DemoWorldCreator.h"
+#include "DropOffIndex.h"
+#include "EnemyQueryService.h"
 #include "EntityModelLoaderV2.h"
 #include "EntityTypeRegistry.h"
 #include "EventLoop.h"
@@ -17,17 +19,20 @@
 #include "GraphicsRegistry.h"
 #include "HUDUpdater.h"
 #include "HumanController.h"
+#include "InputEventQueue.h"
 #include "LogLevelController.h"
 #include "PathService.h"
 #include "PlayerFactory.h"
 #include "ProjectileManager.h"
 #include "Renderer.h"
+#include "ResourceIndex.h"
 #include "ResourceManager.h"
 #include "ServiceRegistry.h"
 #include "SpecialBuildingManager.h"
 #include "StateManager.h"
 #include "SubSystemRegistry.h"
 #include "ThreadSynchronizer.h"
+#include "TimerService.h"
 #include "UIManager.h"
 #include "UnitManager.h"
 #include "VisionSystem.h"
@@ -90,6 +95,9 @@ class Game
         auto coordinates = std::make_shared<core::Coordinates>(settings);
         core::ServiceRegistry::getInstance().registerService(coordinates);
 
+        auto inputQueue = std::make_shared<core::InputEventQueue>();
+        core::ServiceRegistry::getInstance().registerService(inputQueue);
+
         auto eventLoop = std::make_shared<core::EventLoop>(&stopToken);
         auto simulator = std::make_shared<core::GraphicsInstructor>(simulatorRendererSynchronizer);
         core::ServiceRegistry::getInstance().registerService(simulator);
@@ -115,6 +123,9 @@ class Game
         auto hud = std::make_shared<HUDUpdater>();
         core::ServiceRegistry::getInstance().registerService(hud);
 
+        auto timerService = std::make_shared<core::TimerService>();
+        core::ServiceRegistry::getInstance().registerService(timerService);
+
         auto renderer = std::make_shared<core::Renderer>(
             &stopSource, graphicsRegistry, simulatorRendererSynchronizer, graphicsLoader);
         auto cc = std::make_shared<core::CommandCenter>();
@@ -168,6 +179,12 @@ class Game
 
         auto logController = std::make_shared<core::LogLevelController>();
         auto visionSystem = std::make_shared<core::VisionSystem>();
+        auto resourceIndex = std::make_shared<core::ResourceIndex>();
+        core::ServiceRegistry::getInstance().registerService(resourceIndex);
+        auto dropOffIndex = std::make_shared<core::DropOffIndex>();
+        core::ServiceRegistry::getInstance().registerService(dropOffIndex);
+        auto enemyQuery = std::make_shared<core::EnemyQueryService>();
+        core::ServiceRegistry::getInstance().registerService(enemyQuery);
         auto specialBuildingManager = std::make_shared<game::SpecialBuildingManager>();
         auto debugHelper = std::make_shared<game::DebugHelper>();
         auto debugWindow = std::make_shared<core::DebugWindow>();
@@ -181,6 +198,8 @@ class Game
         // Order matters for DebugWindow.
         eventLoop->registerListener(std::move(debugWindow));
         eventLoop->registerListener(std::move(simulator));
+        // Before the systems using timers, so they see the expiries of the same tick
+        eventLoop->registerListener(std::move(timerService));
         eventLoop->registerListener(std::move(cc));
         eventLoop->registerListener(std::move(uiManager));
         eventLoop->registerListener(std::move(playerController));
@@ -191,6 +210,9 @@ class Game
         eventLoop->registerListener(std::move(cursorManager));
         eventLoop->registerListener(std::move(logController));
         eventLoop->registerListener(std::move(visionSystem));
+        eventLoop->registerListener(std::move(resourceIndex));
+        eventLoop->registerListener(std::move(dropOffIndex));
+        eventLoop->registerListener(std::move(enemyQuery));
         eventLoop->registerListener(std::move(specialBuildingManager));
         eventLoop->registerListener(params.worldCreator);
         eventLoop->registerListener(std::move(debugHelper));
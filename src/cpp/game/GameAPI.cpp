@@ -105,7 +105,9 @@ uint32_t GameAPI::createVillager(Ref<core::Player> player, const Feet& pos)
     auto newTile = transform.position.toTile();
     stateMan->gameMap().addEntity(MapLayerType::UNITS, newTile, villager);
 
-    player->getFogOfWar()->markAsExplored(transform.position, vision.lineOfSight);
+    player->getVision()->addSight(newTile, vision.lineOfSight);
+    vision.sightCenter = newTile;
+    vision.hasVision = true;
 
     return villager;
 }
@@ -132,7 +134,9 @@ uint32_t GameAPI::createUnit(core::Ref<core::Player> player,
     auto newTile = transform.position.toTile();
     stateMan->gameMap().addEntity(MapLayerType::UNITS, newTile, villager);
 
-    player->getFogOfWar()->markAsExplored(transform.position, vision.lineOfSight);
+    player->getVision()->addSight(newTile, vision.lineOfSight);
+    vision.sightCenter = newTile;
+    vision.hasVision = true;
 
     return villager;
 }
@@ -194,14 +198,11 @@ void GameAPI::placeBuilding(uint32_t playerId,
     auto eventLoop = static_pointer_cast<EventLoop>(subSys);
     auto eventPublisher = static_pointer_cast<EventPublisher>(eventLoop);
 
-    auto players = ServiceRegistry::getInstance().getService<PlayerFactory>();
-    auto player = players->getPlayer(playerId);
-
     BuildingPlacementData data;
     data.entityType = buildingType;
     data.orientation = orientation;
     data.pos = pos;
-    data.player = player;
+    data.playerId = playerId;
     Event event(Event::Type::BUILDING_REQUESTED, data);
     eventPublisher->publish(event);
 }
@@ -290,9 +291,6 @@ void GameAPI::placeWall(uint32_t playerId,
     auto eventLoop = static_pointer_cast<EventLoop>(subSys);
     auto eventPublisher = static_pointer_cast<EventPublisher>(eventLoop);
 
-    auto players = ServiceRegistry::getInstance().getService<PlayerFactory>();
-    auto player = players->getPlayer(playerId);
-
     std::list<TilePosWithOrientation> buildingPositions;
     Utils::calculateConnectedBuildingsPath(from.toTile(), to.toTile(), buildingPositions);
 
@@ -302,7 +300,7 @@ void GameAPI::placeWall(uint32_t playerId,
         data.entityType = wallEntityType;
         data.orientation = posOri.orientation;
         data.pos = posOri.pos.toFeet();
-        data.player = player;
+        data.playerId = playerId;
         Event event(Event::Type::BUILDING_REQUESTED, data);
         eventPublisher->publish(event);
     }
@@ -17,13 +17,18 @@ HUDUpdater::HUDUpdater()
 {
     registerCallback(Event::Type::ENTITY_SELECTION, this, &HUDUpdater::onUnitSelection);
     registerCallback(Event::Type::TICK, this, &HUDUpdater::onTick);
+
+    declareAccess(SystemAccess()
+                      .reads<HumanController, Player, EntityTypeRegistry, CompBuilding,
+                             CompEntityInfo, CompGarrison, CompUnitFactory>()
+                      .writes<UIManager>());
 }
 
 bool HUDUpdater::onTick(const Event& e)
 {
     updateUIElementReferences();
     updateResourcePanel();
-    updateProgressBar();
+    updateProgressBar(e.getData<TickData>().currentTick);
     updateGarrisonedUnits();
     return false;
 }
@@ -62,7 +67,7 @@ bool HUDUpdater::onUnitSelection(const Event& e)
     return false;
 }
 
-void HUDUpdater::updateProgressBar()
+void HUDUpdater::updateProgressBar(int currentTick)
 {
     m_creationInProgressGroup->setVisible(false);
 
@@ -78,7 +83,7 @@ void HUDUpdater::updateProgressBar()
 
             if (building.isConstructed())
             {
-                updateFactoryUnitCreations(entity);
+                updateFactoryUnitCreations(entity, currentTick);
             }
             else
             {
@@ -130,13 +135,14 @@ void HUDUpdater::updateUIElementReferences()
     }
 }
 
-void HUDUpdater::updateFactoryUnitCreations(uint32_t entity)
+void HUDUpdater::updateFactoryUnitCreations(uint32_t entity, int currentTick)
 {
     m_creationQueueGroup->setVisible(false);
 
     if (auto factory = m_stateMan->tryGetComponent<CompUnitFactory>(entity))
     {
-        if (factory->productionQueue.empty() == false && factory->currentUnitProgress <= 100)
+        const auto progress = factory->getProgress(currentTick);
+        if (factory->productionQueue.empty() == false)
         {
             auto displayName = m_typeRegistry->getHUDDisplayName(factory->productionQueue[0]);
             auto unitIcon = m_typeRegistry->getHUDIcon(factory->productionQueue[0]);
@@ -158,7 +164,7 @@ void HUDUpdater::updateFactoryUnitCreations(uint32_t entity)
                 m_progressErrorLabel->setVisible(false);
                 m_progressNoErrorGroup->setVisible(true);
                 m_progressTextLabel->setText(
-                    std::format("Creating - {}%", (int) factory->currentUnitProgress));
+                    std::format("Creating - {}%", (int) progress));
             }
 
             m_progressItemNameLabel->setText(displayName);
@@ -166,7 +172,7 @@ void HUDUpdater::updateFactoryUnitCreations(uint32_t entity)
 
             // Taking a copy to update variation
             auto graphic = m_progressBarLabel->getBackgroundImage();
-            graphic.variation = factory->currentUnitProgress;
+            graphic.variation = progress;
             m_progressBarLabel->setBackgroundImage(graphic);
 
             m_creationInProgressGroup->setVisible(true);
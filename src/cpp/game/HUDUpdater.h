@@ -25,9 +25,9 @@ class HUDUpdater : public core::EventHandler
   private:
     void updateUIElementReferences();
     void updateResourcePanel();
-    void updateProgressBar();
+    void updateProgressBar(int currentTick);
     void updateGarrisonedUnits();
-    void updateFactoryUnitCreations(uint32_t factoryEntity);
+    void updateFactoryUnitCreations(uint32_t factoryEntity, int currentTick);
     void updateBuildingConstruction(core::CompBuilding& building, core::CompEntityInfo& info);
 
     template <typename T> void updateUIElementRef(core::Ref<T>& elementRef, const std::string& text)
@@ -1,6 +1,8 @@
 #include "ResourceManager.h"
 
+#include "EnemyQueryService.h"
 #include "GameTypes.h"
+#include "ResourceIndex.h"
 #include "StateManager.h"
 #include "components/CompEntityInfo.h"
 #include "components/CompResource.h"
@@ -13,6 +15,12 @@ using namespace core;
 ResourceManager::ResourceManager(/* args */)
 {
     registerCallback(Event::Type::TICK, this, &ResourceManager::onTick);
+
+    // Removing depleted resources from the TileMap updates its listening indexes too
+    declareAccess(SystemAccess()
+                      .reads<CompResource, CompSelectible, CompTransform>()
+                      .writes<CompEntityInfo, TileMap, DirtyEntities, ResourceIndex,
+                              EnemyQueryService>());
 }
 
 ResourceManager::~ResourceManager()
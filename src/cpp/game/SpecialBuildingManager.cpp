@@ -16,7 +16,8 @@ SpecialBuildingManager::SpecialBuildingManager()
     registerCallback(Event::Type::BUILDING_CONSTRUCTED, this,
                      &SpecialBuildingManager::onBuildingConstructed);
 
-    // constructor
+    // Doesn't act on TICK
+    declareAccess(SystemAccess());
 }
 
 SpecialBuildingManager::~SpecialBuildingManager()
@@ -1,5 +1,8 @@
 #include "Property.h"
+#include "EnemyQueryService.h"
+#include "Player.h"
 #include "ServiceRegistry.h"
+#include "Settings.h"
 #include "StateManager.h"
 #include "GameTypes.h"
 
@@ -11,6 +14,7 @@
 #include "components/CompArmor.h"
 #include "components/CompEntityInfo.h"
 #include "components/CompPlayer.h"
+#include "components/CompSelectible.h"
 #include "components/CompTransform.h"
 #include "components/CompUnit.h"
 #include "components/CompVision.h"
@@ -61,6 +65,7 @@ class CmdAttackTest : public ::testing::Test, public core::PropertyInitializer
     {
         // Clear state manager registry contents to avoid cross-test interference
         m_stateMan->clearAll();
+        ServiceRegistry::getInstance().unregisterService<EnemyQueryService>();
     }
 
     // Helpers to configure attack/armor properties
@@ -86,9 +91,67 @@ class CmdAttackTest : public ::testing::Test, public core::PropertyInitializer
         PropertyInitializer::set<float>(armor.damageResistance, rr);
     }
 
+    // An enemy of player 1 at the position, indexed at the given tile
+    uint32_t createEnemy(const Feet& position, const Tile& tile, float health)
+    {
+        auto enemy = m_stateMan->createEntity();
+        CompTransform transform;
+        transform.position = position;
+        m_stateMan->addComponent(enemy, transform);
+        CompHealth compHealth;
+        compHealth.health = health;
+        m_stateMan->addComponent(enemy, compHealth);
+        CompArmor armor;
+        setArmorPerClass(armor, std::vector<int>{0, 0, 0});
+        setDamageResistance(armor, 0.0f);
+        m_stateMan->addComponent(enemy, armor);
+        m_stateMan->addComponent(enemy, CompSelectible());
+        m_stateMan->addComponent(enemy, CompEntityInfo(0));
+
+        m_enemyQuery->addTarget(enemy, 1, tile, 0, false);
+        return enemy;
+    }
+
+    // Ready to attack on its own, as player 0 at war with player 1
+    void setUpAttacker(const Feet& position)
+    {
+        ServiceRegistry::getInstance().registerService(std::make_shared<Settings>());
+        m_enemyQuery = std::make_shared<EnemyQueryService>();
+        m_enemyQuery->init(64, 64);
+        ServiceRegistry::getInstance().registerService(m_enemyQuery);
+
+        for (uint8_t id = 0; id < m_players.size(); ++id)
+        {
+            m_players[id] = std::make_shared<Player>();
+            m_players[id]->init(id);
+        }
+        m_players[0]->setAllegiance(m_players[1], Allegiance::ENEMY);
+        m_stateMan->getComponent<CompPlayer>(m_entity).player = m_players[0];
+
+        m_stateMan->getComponent<CompTransform>(m_entity).position = position;
+        set(m_stateMan->getComponent<CompVision>(m_entity).lineOfSight,
+            uint32_t(10 * Constants::FEET_PER_TILE));
+
+        setAttackPerClass(std::vector<int>{0, 10, 0});
+        setAttackMultiplierPerClass(std::vector<float>{1.0f, 1.0f, 1.0f});
+        set(m_stateMan->getComponent<CompMeleeAttack>(m_entity).attackRate, 1);
+
+        std::array<CompAnimation::ActionAnimation, Constants::MAX_ANIMATIONS> animations{};
+        animations[UnitAction::ATTACK].frames = 10;
+        set(m_stateMan->getComponent<CompAnimation>(m_entity).animations, animations);
+    }
+
+    bool execute(int deltaTimeMs, int currentTick)
+    {
+        std::list<Command*> subCommands;
+        return static_cast<Command&>(*m_cmd).onExecute(deltaTimeMs, currentTick, subCommands);
+    }
+
     Ref<StateManager> m_stateMan;
     uint32_t m_entity = entt::null;
     std::unique_ptr<CmdAttackExposed> m_cmd;
+    Ref<EnemyQueryService> m_enemyQuery;
+    std::array<Ref<Player>, 2> m_players;
 };
 
 // 1. attacker's class has matching armor class in target with value greater than zero
@@ -213,4 +276,23 @@ TEST_F(CmdAttackTest, TargetHasArmor_AttackerNoAttackForThatClass_Ignored)
     float dmg = m_cmd->getDamage(target);
     EXPECT_FLOAT_EQ(dmg, 5.0f);
 }
-} // namespace core
\ No newline at end of file
+
+// 9. target killed by this attack, the next one must be alive
+TEST_F(CmdAttackTest, RetargetsToLivingEnemyOnceTargetIsKilled)
+{
+    const Feet position(1000, 1000);
+    setUpAttacker(position);
+
+    // Still indexed at the attacker's tile, hence the nearest candidate
+    auto target = createEnemy(position, position.toTile(), 5);
+    auto dead = createEnemy(Feet(1300, 1300), position.toTile() + 1, 0);
+    m_stateMan->getComponent<CompHealth>(dead).isDead = true;
+    auto alive = createEnemy(Feet(2000, 2000), position.toTile() + 3, 10);
+    m_cmd->target = target;
+
+    EXPECT_FALSE(execute(1000, 1));
+    EXPECT_LE(m_stateMan->getComponent<CompHealth>(target).health, 0);
+    EXPECT_EQ(m_cmd->target, alive);
+}
+} // namespace core
+
@@ -30,6 +30,33 @@ class MockCommand : public Command
     void onStart() {};
     void onQueue() {};
     Command* clone() { return nullptr; };
+
+    void requestSleep(int tick)
+    {
+        sleepUntil(tick);
+    }
+};
+
+// Distinct concrete type, hence batched separately from MockCommand
+class OtherMockCommand : public MockCommand
+{
+};
+
+// Records its start into a log shared with the other commands
+template <int Type> class StartRecordingCommand : public MockCommand
+{
+  public:
+    explicit StartRecordingCommand(std::vector<std::string>& log) : m_log(log)
+    {
+    }
+
+    void onStart() override
+    {
+        m_log.push_back("start " + std::to_string(Type));
+    }
+
+  private:
+    std::vector<std::string>& m_log;
 };
 
 class CommandCenterTest : public ::testing::Test
@@ -201,4 +228,93 @@ TEST_F(CommandCenterTest, CreatesSubCommands_WithMainCommandComplete)
     }
     ASSERT_EQ(vec[0], subCommand);
 }
+
+TEST_F(CommandCenterTest, ExecutesCommandsOfAllTypesOncePerTick)
+{
+    auto stateMan = ServiceRegistry::getInstance().getService<StateManager>();
+    // Command queues don't own the commands
+    std::vector<std::unique_ptr<MockCommand>> commands;
+    commands.push_back(std::make_unique<MockCommand>());
+    commands.push_back(std::make_unique<OtherMockCommand>());
+    commands.push_back(std::make_unique<MockCommand>());
+
+    for (auto& command : commands)
+    {
+        EXPECT_CALL(*command, onExecute(0, 0, ::testing::_))
+            .WillOnce(::testing::Return(false));
+
+        CompUnit unit;
+        unit.commandQueue.push(command.get());
+        stateMan->addComponent(stateMan->createEntity(), unit);
+    }
+
+    Event tickEvent{Event::Type::TICK, TickData{0}};
+    commandCenter.onTick(tickEvent);
+}
+
+TEST_F(CommandCenterTest, CommandIsStartedRightBeforeItsFirstExecution)
+{
+    auto stateMan = ServiceRegistry::getInstance().getService<StateManager>();
+    std::vector<std::string> log;
+    StartRecordingCommand<1> first(log);
+    StartRecordingCommand<2> second(log);
+
+    EXPECT_CALL(first, onExecute(::testing::_, ::testing::_, ::testing::_))
+        .WillOnce(::testing::Invoke(
+            [&](int, int, std::list<Command*>&)
+            {
+                log.push_back("execute 1");
+                return false;
+            }));
+    EXPECT_CALL(second, onExecute(::testing::_, ::testing::_, ::testing::_))
+        .WillOnce(::testing::Invoke(
+            [&](int, int, std::list<Command*>&)
+            {
+                log.push_back("execute 2");
+                return false;
+            }));
+
+    for (Command* command : {static_cast<Command*>(&first), static_cast<Command*>(&second)})
+    {
+        CompUnit unit;
+        unit.commandQueue.push(command);
+        stateMan->addComponent(stateMan->createEntity(), unit);
+    }
+
+    Event tickEvent{Event::Type::TICK, TickData{0}};
+    commandCenter.onTick(tickEvent);
+
+    // Either batch might go first, but not both starts before the executions
+    EXPECT_THAT(log,
+                ::testing::AnyOf(
+                    ::testing::ElementsAre("start 1", "execute 1", "start 2", "execute 2"),
+                    ::testing::ElementsAre("start 2", "execute 2", "start 1", "execute 1")));
+}
+
+TEST_F(CommandCenterTest, SleepingUnitIsSkippedUntilWakeUpTick)
+{
+    auto stateMan = ServiceRegistry::getInstance().getService<StateManager>();
+    auto mockCommand = new MockCommand();
+
+    std::vector<int> executedTicks;
+    EXPECT_CALL(*mockCommand, onExecute(::testing::_, ::testing::_, ::testing::_))
+        .WillRepeatedly(::testing::Invoke(
+            [&](int, int currentTick, std::list<Command*>&)
+            {
+                executedTicks.push_back(currentTick);
+                mockCommand->requestSleep(currentTick + 4);
+                return false;
+            }));
+
+    CompUnit unit;
+    unit.commandQueue.push(mockCommand);
+    stateMan->addComponent(stateMan->createEntity(), unit);
+
+    for (int tick = 1; tick <= 10; ++tick)
+    {
+        Event tickEvent{Event::Type::TICK, TickData{16, tick}};
+        commandCenter.onTick(tickEvent);
+    }
+    EXPECT_EQ(executedTicks, (std::vector<int>{1, 5, 9}));
+}
 } // namespace core
\ No newline at end of file
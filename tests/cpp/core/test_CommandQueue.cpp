@@ -0,0 +1,149 @@
+#include "commands/CommandQueue.h"
+
+#include <gtest/gtest.h>
+
+namespace core
+{
+namespace
+{
+class DummyCommand : public Command
+{
+  public:
+    explicit DummyCommand(int priority)
+    {
+        setPriority(priority);
+    }
+
+    void onStart() override
+    {
+    }
+    void onQueue() override
+    {
+    }
+    bool onExecute(int, int, std::list<Command*>&) override
+    {
+        return false;
+    }
+    std::string toString() const override
+    {
+        return "dummy";
+    }
+    void destroy() override
+    {
+        ++destroyedCount;
+    }
+    Command* clone() override
+    {
+        return nullptr;
+    }
+
+    int destroyedCount = 0;
+};
+} // namespace
+
+TEST(CommandQueueTest, TopIsHighestPriorityThenEarliestQueued)
+{
+    DummyCommand idle(Command::DEFAULT_PRIORITY);
+    DummyCommand first(10);
+    DummyCommand second(10);
+    DummyCommand child(1010);
+
+    CommandQueue queue;
+    queue.push(&idle);
+    queue.push(&first);
+    queue.push(&second);
+    queue.push(&child);
+
+    EXPECT_EQ(queue.size(), 4);
+    EXPECT_EQ(queue.top(), &child);
+    queue.pop();
+    EXPECT_EQ(queue.top(), &first);
+    queue.pop();
+    EXPECT_EQ(queue.top(), &second);
+    queue.pop();
+    EXPECT_EQ(queue.top(), &idle);
+}
+
+TEST(CommandQueueTest, RemovesByHandle)
+{
+    DummyCommand idle(Command::DEFAULT_PRIORITY);
+    DummyCommand command(10);
+    DummyCommand other(10);
+
+    CommandQueue queue;
+    queue.push(&idle);
+    queue.push(&command);
+    queue.push(&other);
+
+    EXPECT_TRUE(queue.remove(&other)); // Not the top
+    EXPECT_FALSE(queue.remove(&other));
+    EXPECT_EQ(queue.top(), &command);
+
+    EXPECT_TRUE(queue.remove(&command)); // Top
+    EXPECT_EQ(queue.top(), &idle);
+    EXPECT_EQ(queue.size(), 1);
+}
+
+TEST(CommandQueueTest, RemovesMatchingCommandsKeepingOrder)
+{
+    DummyCommand idle(Command::DEFAULT_PRIORITY);
+    DummyCommand first(10);
+    DummyCommand second(10);
+    DummyCommand child(1010);
+
+    CommandQueue queue;
+    for (auto command : {&idle, &first, &child, &second})
+    {
+        queue.push(command);
+    }
+
+    queue.removeIf([&](Command* command) { return command == &child; });
+    EXPECT_EQ(queue.size(), 3);
+    EXPECT_EQ(queue.top(), &first);
+
+    queue.removeIf([](Command* command)
+                   { return command->getPriority() > Command::DEFAULT_PRIORITY; });
+    EXPECT_EQ(queue.size(), 1);
+    EXPECT_EQ(queue.top(), &idle);
+}
+
+TEST(CommandQueueTest, ClearDestroysAllButTheGivenCommand)
+{
+    DummyCommand idle(Command::DEFAULT_PRIORITY);
+    DummyCommand command(10);
+    DummyCommand executing(1010);
+
+    CommandQueue queue;
+    for (auto queued : {&idle, &command, &executing})
+    {
+        queue.push(queued);
+    }
+
+    queue.clearAndDestroy(&executing);
+    EXPECT_EQ(queue.size(), 1);
+    EXPECT_EQ(queue.top(), &executing);
+    EXPECT_EQ(idle.destroyedCount, 1);
+    EXPECT_EQ(command.destroyedCount, 1);
+    EXPECT_EQ(executing.destroyedCount, 0);
+
+    queue.clearAndDestroy();
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(executing.destroyedCount, 1);
+}
+
+TEST(CommandQueueTest, RejectsBeyondCapacity)
+{
+    std::vector<DummyCommand> commands(CommandQueue::CAPACITY + 1, DummyCommand(1));
+
+    CommandQueue queue;
+    for (size_t i = 0; i < CommandQueue::CAPACITY; ++i)
+    {
+        EXPECT_TRUE(queue.push(&commands[i]));
+    }
+    EXPECT_TRUE(queue.full());
+#ifdef NDEBUG
+    EXPECT_FALSE(queue.push(&commands.back()));
+    EXPECT_EQ(queue.size(), CommandQueue::CAPACITY);
+#endif
+}
+} // namespace core
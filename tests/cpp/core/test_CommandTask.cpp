@@ -0,0 +1,96 @@
+#include "commands/CommandTask.h"
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <thread>
+
+namespace core
+{
+namespace
+{
+CommandTask countTo(int limit, int& counter)
+{
+    while (counter < limit)
+    {
+        ++counter;
+        co_await std::suspend_always{};
+    }
+}
+
+CommandTask throwing()
+{
+    co_await std::suspend_always{};
+    throw std::runtime_error("failed");
+}
+} // namespace
+
+TEST(CommandTaskTest, StartsSuspendedAndRunsToCompletion)
+{
+    int counter = 0;
+    auto task = countTo(2, counter);
+    EXPECT_EQ(counter, 0);
+
+    task.resume();
+    EXPECT_EQ(counter, 1);
+    task.resume();
+    EXPECT_EQ(counter, 2);
+    EXPECT_FALSE(task.done());
+
+    task.resume();
+    EXPECT_TRUE(task.done());
+}
+
+TEST(CommandTaskTest, ReusesFrames)
+{
+    int counter = 0;
+    {
+        auto task = countTo(1, counter);
+    }
+    // Frame of the destroyed task is now available
+    size_t freeFrames = 0;
+    for (size_t size = 1; size <= CoroutineFramePool::MAX_POOLED_SIZE;
+         size += CoroutineFramePool::GRANULARITY)
+    {
+        freeFrames += CoroutineFramePool::getFreeCount(size);
+    }
+    EXPECT_GE(freeFrames, 1);
+
+    auto task = countTo(1, counter);
+    size_t freeFramesAfter = 0;
+    for (size_t size = 1; size <= CoroutineFramePool::MAX_POOLED_SIZE;
+         size += CoroutineFramePool::GRANULARITY)
+    {
+        freeFramesAfter += CoroutineFramePool::getFreeCount(size);
+    }
+    EXPECT_EQ(freeFramesAfter, freeFrames - 1);
+}
+
+TEST(CommandTaskTest, FrameDestroyedOnAnotherThreadGoesToItsPool)
+{
+    int counter = 0;
+    auto task = countTo(1, counter);
+    size_t releasedOnWorker = 0;
+
+    std::thread worker(
+        [&]()
+        {
+            task = CommandTask();
+            for (size_t size = 1; size <= CoroutineFramePool::MAX_POOLED_SIZE;
+                 size += CoroutineFramePool::GRANULARITY)
+            {
+                releasedOnWorker += CoroutineFramePool::getFreeCount(size);
+            }
+        });
+    worker.join();
+
+    EXPECT_EQ(releasedOnWorker, 1);
+}
+
+TEST(CommandTaskTest, RethrowsExceptions)
+{
+    auto task = throwing();
+    task.resume();
+    EXPECT_THROW(task.resume(), std::runtime_error);
+    EXPECT_TRUE(task.done());
+}
+} // namespace core
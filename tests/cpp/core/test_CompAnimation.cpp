@@ -0,0 +1,97 @@
+#include "components/CompAnimation.h"
+
+#include <gtest/gtest.h>
+
+namespace core
+{
+TEST(AnimationPlaybackTest, FrameAdvancesEveryTicksPerFrameAndWraps)
+{
+    AnimationPlayback playback{
+        .action = 1, .startTick = 100, .startFrame = 2, .ticksPerFrame = 3, .frames = 4};
+
+    EXPECT_EQ(playback.getFrameAt(100), 2);
+    EXPECT_EQ(playback.getFrameAt(102), 2);
+    EXPECT_EQ(playback.getFrameAt(103), 3);
+    EXPECT_EQ(playback.getFrameAt(106), 0); // Wrapped around
+    EXPECT_EQ(playback.getFrameAt(100 + 3 * 4), 2);
+    EXPECT_EQ(playback.getFrameAt(90), 2); // Before the start, i.e. a stale tick
+}
+
+TEST(AnimationPlaybackTest, OneTickPerFrame)
+{
+    AnimationPlayback playback{
+        .action = 1, .startTick = 0, .startFrame = 0, .ticksPerFrame = 1, .frames = 3};
+
+    EXPECT_EQ(playback.getFrameAt(1), 1);
+    EXPECT_EQ(playback.getFrameAt(2), 2);
+    EXPECT_EQ(playback.getFrameAt(3), 0);
+}
+
+class CompAnimationTest : public ::testing::Test, public PropertyInitializer
+{
+  protected:
+    void SetUp() override
+    {
+        std::array<CompAnimation::ActionAnimation, Constants::MAX_ANIMATIONS> animations{};
+        animations[WALK].frames = 5;
+        animations[ATTACK].frames = 3;
+        set(animation.animations, animations);
+    }
+
+    static constexpr int WALK = 1;
+    static constexpr int ATTACK = 2;
+    CompAnimation animation;
+};
+
+TEST_F(CompAnimationTest, LoopStartsOnlyOnceForTheSameActionAndRate)
+{
+    EXPECT_TRUE(animation.loop(WALK, 10, 2));
+    EXPECT_EQ(animation.playback.startTick, 10);
+    EXPECT_EQ(animation.playback.frames, 5);
+
+    EXPECT_FALSE(animation.loop(WALK, 11, 2));
+    EXPECT_FALSE(animation.loop(WALK, 50, 2));
+    EXPECT_EQ(animation.playback.startTick, 10);
+}
+
+TEST_F(CompAnimationTest, NewRateContinuesFromTheCurrentFrame)
+{
+    animation.loop(WALK, 0, 2);
+    EXPECT_EQ(animation.playback.getFrameAt(14), 2); // 7 frames played, wrapped once
+
+    EXPECT_TRUE(animation.loop(WALK, 14, 1));
+    EXPECT_EQ(animation.playback.startFrame, 2);
+    EXPECT_EQ(animation.playback.getFrameAt(14), 2);
+    EXPECT_EQ(animation.playback.getFrameAt(17), 0);
+}
+
+TEST_F(CompAnimationTest, FrameIsWrappedToTheNewAction)
+{
+    animation.loop(WALK, 0, 1);
+    EXPECT_TRUE(animation.loop(ATTACK, 4, 1)); // At walk frame 4, attack has 3 frames
+    EXPECT_EQ(animation.playback.startFrame, 1);
+    EXPECT_EQ(animation.playback.frames, 3);
+}
+
+TEST_F(CompAnimationTest, ZeroTicksPerFrameIsClampedToOne)
+{
+    // E.g. an animation faster than the tick rate
+    EXPECT_TRUE(animation.loop(WALK, 0, 0));
+    EXPECT_EQ(animation.playback.ticksPerFrame, 1);
+    EXPECT_EQ(animation.playback.getFrameAt(6), 1);
+
+    EXPECT_FALSE(animation.loop(WALK, 1, 0)); // Same rate once clamped
+    EXPECT_FALSE(animation.loop(WALK, 2, 1));
+}
+
+TEST_F(CompAnimationTest, StoppedAnimationRestartsFromItsFrame)
+{
+    animation.loop(WALK, 0, 1);
+    animation.stop();
+    EXPECT_FALSE(animation.playback.isPlaying());
+
+    animation.frame = 3;
+    EXPECT_TRUE(animation.loop(WALK, 20, 1));
+    EXPECT_EQ(animation.playback.startFrame, 3);
+}
+} // namespace core
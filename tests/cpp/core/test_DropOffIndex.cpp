@@ -0,0 +1,58 @@
+#include "DropOffIndex.h"
+#include "components/CompBuilding.h"
+
+#include <gtest/gtest.h>
+
+namespace core
+{
+class DropOffIndexTest : public ::testing::Test, public PropertyInitializer
+{
+  protected:
+    void SetUp() override
+    {
+        index.init(64, 64);
+        set(woodCamp.dropOffForResourceType, WOOD);
+        set(miningCamp.dropOffForResourceType, GOLD);
+    }
+
+    // Values of CompBuilding::dropOffForResourceType are masks of the accepted types
+    static constexpr uint8_t WOOD = 1;
+    static constexpr uint8_t GOLD = 2;
+    CompBuilding woodCamp;
+    CompBuilding miningCamp;
+    DropOffIndex index;
+};
+
+TEST_F(DropOffIndexTest, FindsNearestAcceptingTheType)
+{
+    index.addDropOff(1, 0, miningCamp, Tile(1, 1)); // The closest, but not for wood
+    index.addDropOff(2, 0, woodCamp, Tile(5, 5));
+    index.addDropOff(3, 0, woodCamp, Tile(30, 30));
+    index.addDropOff(4, 1, woodCamp, Tile(2, 2)); // Of another player
+
+    EXPECT_EQ(index.findNearest(0, WOOD, Tile(0, 0)), 2);
+    EXPECT_EQ(index.findNearest(0, GOLD, Tile(0, 0)), 1);
+    EXPECT_EQ(index.findNearest(0, WOOD, Tile(40, 40)), 3);
+    EXPECT_EQ(index.findNearest(1, WOOD, Tile(0, 0)), 4);
+    EXPECT_EQ(index.findNearest(1, GOLD, Tile(0, 0)), (uint32_t) entt::null);
+}
+
+TEST_F(DropOffIndexTest, RemovesDestroyedDropOffs)
+{
+    index.addDropOff(1, 0, woodCamp, Tile(2, 2));
+    index.addDropOff(2, 0, woodCamp, Tile(20, 20));
+    auto version = index.getVersion(0);
+
+    index.dispatchEvent(Event(Event::Type::ENTITY_DELETE, EntityDeleteData{1}));
+    EXPECT_EQ(index.findNearest(0, WOOD, Tile(0, 0)), 2);
+    EXPECT_NE(index.getVersion(0), version); // Cached lookups are refreshed
+
+    index.dispatchEvent(Event(Event::Type::ENTITY_DELETE, EntityDeleteData{2}));
+    EXPECT_EQ(index.findNearest(0, WOOD, Tile(0, 0)), (uint32_t) entt::null);
+
+    // Not a drop-off point, nothing changes
+    version = index.getVersion(0);
+    index.dispatchEvent(Event(Event::Type::ENTITY_DELETE, EntityDeleteData{7}));
+    EXPECT_EQ(index.getVersion(0), version);
+}
+} // namespace core
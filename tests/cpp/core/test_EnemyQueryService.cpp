@@ -0,0 +1,130 @@
+#include "EnemyQueryService.h"
+#include "Player.h"
+#include "ServiceRegistry.h"
+#include "Settings.h"
+#include "StateManager.h"
+#include "components/CompEntityInfo.h"
+#include "components/CompHealth.h"
+
+#include <algorithm>
+#include <array>
+#include <gtest/gtest.h>
+
+namespace core
+{
+class EnemyQueryServiceTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        ServiceRegistry::getInstance().registerService(std::make_shared<Settings>());
+        stateMan = std::make_shared<StateManager>();
+        ServiceRegistry::getInstance().registerService(stateMan);
+
+        for (uint8_t id = 0; id < players.size(); ++id)
+        {
+            players[id] = std::make_shared<Player>();
+            players[id]->init(id);
+        }
+        // Player 0 is at war with player 1, allied with player 2
+        players[0]->setAllegiance(players[1], Allegiance::ENEMY);
+        players[0]->setAllegiance(players[2], Allegiance::ALLY);
+
+        service.init(64, 64);
+    }
+
+    void TearDown() override
+    {
+        stateMan->clearAll();
+    }
+
+    uint32_t createTarget(float health)
+    {
+        auto entity = stateMan->createEntity();
+        CompHealth compHealth;
+        compHealth.health = health;
+        stateMan->addComponent(entity, compHealth);
+        stateMan->addComponent(entity, CompEntityInfo());
+        return entity;
+    }
+
+    Ref<StateManager> stateMan;
+    std::array<Ref<Player>, 3> players;
+    EnemyQueryService service;
+};
+
+TEST_F(EnemyQueryServiceTest, FindsNearestEnemyOnly)
+{
+    service.addTarget(1, 2, Tile(1, 1), 0, false); // Ally, the closest
+    service.addTarget(2, 1, Tile(10, 10), 0, false);
+    service.addTarget(3, 1, Tile(20, 20), 0, false);
+
+    EXPECT_EQ(service.findNearestEnemy(*players[0], Tile(0, 0), 30), 2);
+    EXPECT_EQ(service.findNearestEnemy(*players[0], Tile(0, 0), 5), (uint32_t) entt::null);
+    // Player 1 isn't hostile to anyone
+    EXPECT_EQ(service.findNearestEnemy(*players[1], Tile(0, 0), 30), (uint32_t) entt::null);
+}
+
+TEST_F(EnemyQueryServiceTest, FollowsMovingTargets)
+{
+    service.addTarget(2, 1, Tile(10, 10), 0, false);
+    service.addTarget(3, 1, Tile(20, 20), 0, false);
+
+    service.addTarget(3, 1, Tile(2, 2), 0, false);
+    EXPECT_EQ(service.findNearestEnemy(*players[0], Tile(0, 0), 30), 3);
+
+    service.removeTarget(3);
+    EXPECT_EQ(service.findNearestEnemy(*players[0], Tile(0, 0), 30), 2);
+}
+
+TEST_F(EnemyQueryServiceTest, FiltersByKindAndArmorClass)
+{
+    service.addTarget(2, 1, Tile(1, 1), 0b01, false);
+    service.addTarget(3, 1, Tile(5, 5), 0b10, false);
+    service.addTarget(4, 1, Tile(8, 8), 0, true);
+
+    EnemyQueryService::TargetFilter filter;
+    filter.armorClasses = 0b10;
+    EXPECT_EQ(service.findNearestEnemy(*players[0], Tile(0, 0), 30, filter), 3);
+
+    filter = {};
+    filter.units = false;
+    EXPECT_EQ(service.findNearestEnemy(*players[0], Tile(0, 0), 30, filter), 4);
+}
+
+TEST_F(EnemyQueryServiceTest, FindsEnemiesInRadius)
+{
+    service.addTarget(2, 1, Tile(1, 1), 0, false);
+    service.addTarget(3, 1, Tile(2, 2), 0, false);
+    service.addTarget(4, 1, Tile(40, 40), 0, false);
+    service.addTarget(5, 2, Tile(1, 2), 0, false);
+
+    std::array<uint32_t, 8> enemies;
+    auto count = service.findEnemiesInRadius(*players[0], Tile(0, 0), 5, enemies);
+    ASSERT_EQ(count, 2);
+    std::sort(enemies.begin(), enemies.begin() + count);
+    EXPECT_EQ(enemies[0], 2);
+    EXPECT_EQ(enemies[1], 3);
+}
+
+TEST_F(EnemyQueryServiceTest, SkipsKilledAndDestroyedTargets)
+{
+    auto killed = createTarget(0);
+    auto dead = createTarget(10);
+    stateMan->getComponent<CompHealth>(dead).isDead = true;
+    auto destroyed = createTarget(10);
+    stateMan->getComponent<CompEntityInfo>(destroyed).isDestroyed = true;
+    auto alive = createTarget(10);
+
+    service.addTarget(killed, 1, Tile(1, 1), 0, false);
+    service.addTarget(dead, 1, Tile(2, 2), 0, false);
+    service.addTarget(destroyed, 1, Tile(3, 3), 0, false);
+    service.addTarget(alive, 1, Tile(10, 10), 0, false);
+
+    EXPECT_EQ(service.findNearestEnemy(*players[0], Tile(0, 0), 30), alive);
+
+    std::array<uint32_t, 8> enemies;
+    ASSERT_EQ(service.findEnemiesInRadius(*players[0], Tile(0, 0), 30, enemies), 1);
+    EXPECT_EQ(enemies[0], alive);
+}
+} // namespace core
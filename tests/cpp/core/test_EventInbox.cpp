@@ -0,0 +1,144 @@
+#include "EventInbox.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace core
+{
+namespace
+{
+Event makeEvent(uint32_t entity)
+{
+    return Event(Event::Type::ENTITY_DELETE, EntityDeleteData{entity});
+}
+
+uint32_t entityOf(const Event& event)
+{
+    return event.getData<EntityDeleteData>().entity;
+}
+} // namespace
+
+TEST(EventInboxTest, DrainsInTickThenProducerKeyOrder)
+{
+    EventInbox inbox;
+    // Acquisition order doesn't matter either
+    auto& second = inbox.acquireProducer(2);
+    auto& first = inbox.acquireProducer(1);
+
+    // Ticks only grow per producer, as they follow the simulation
+    second.publish(makeEvent(3), 1);
+    second.publish(makeEvent(5), 2);
+    first.publish(makeEvent(1), 1);
+    first.publish(makeEvent(2), 1);
+    first.publish(makeEvent(4), 2);
+
+    std::vector<uint32_t> drained;
+    inbox.drain([&](const Event& event) { drained.push_back(entityOf(event)); });
+
+    // Tick 1: key 1 then 2, tick 2: key 1 then 2. Publishing order doesn't matter.
+    EXPECT_EQ(drained, (std::vector<uint32_t>{1, 2, 3, 4, 5}));
+
+    drained.clear();
+    inbox.drain([&](const Event& event) { drained.push_back(entityOf(event)); });
+    EXPECT_TRUE(drained.empty());
+}
+
+TEST(EventInboxTest, ConcurrentProducersDeliverEverything)
+{
+    constexpr uint32_t threadCount = 4;
+    constexpr uint32_t eventsPerThread = 1000;
+
+    EventInbox inbox;
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back(
+            [&inbox, t]()
+            {
+                auto& producer = inbox.acquireProducer(t);
+                for (uint32_t i = 0; i < eventsPerThread; ++i)
+                {
+                    producer.publish(makeEvent(t * eventsPerThread + i), 0);
+                }
+                inbox.releaseProducer(producer);
+            });
+    }
+
+    std::vector<uint32_t> lastPerThread(threadCount, 0);
+    std::vector<uint32_t> countPerThread(threadCount, 0);
+    auto consume = [&](const Event& event)
+    {
+        auto entity = entityOf(event);
+        auto thread = entity / eventsPerThread;
+        // Events of a single producer keep their publishing order
+        if (countPerThread[thread] > 0)
+        {
+            EXPECT_GT(entity, lastPerThread[thread]);
+        }
+        lastPerThread[thread] = entity;
+        ++countPerThread[thread];
+    };
+
+    // Drain while the producers are still publishing
+    for (int i = 0; i < 10; ++i)
+    {
+        inbox.drain(consume);
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    inbox.drain(consume);
+
+    for (auto count : countPerThread)
+    {
+        EXPECT_EQ(count, eventsPerThread);
+    }
+}
+
+TEST(EventInboxTest, ReleasedSlotsAreRecycledAfterDraining)
+{
+    EventInbox inbox;
+    std::vector<uint32_t> drained;
+    auto consume = [&](const Event& event) { drained.push_back(entityOf(event)); };
+
+    // Many more producers than slots over time, but only a few at once
+    for (uint32_t i = 0; i < EventInbox::MAX_PRODUCERS * 4; ++i)
+    {
+        auto& producer = inbox.acquireProducer(i);
+        producer.publish(makeEvent(i), 0);
+        inbox.releaseProducer(producer);
+
+        // Events of released producers are still delivered
+        inbox.drain(consume);
+        ASSERT_EQ(drained.size(), i + 1);
+        EXPECT_EQ(drained.back(), i);
+    }
+}
+
+TEST(EventInboxTest, ThrowsWhenAllSlotsAreInUse)
+{
+    EventInbox inbox;
+    for (uint32_t i = 0; i < EventInbox::MAX_PRODUCERS; ++i)
+    {
+        inbox.acquireProducer(i);
+    }
+    EXPECT_THROW(inbox.acquireProducer(EventInbox::MAX_PRODUCERS), std::runtime_error);
+}
+
+TEST(EventInboxTest, ReacquiredKeyGoesAfterItsReleasedProducer)
+{
+    EventInbox inbox;
+    auto& old = inbox.acquireProducer(1);
+    old.publish(makeEvent(1), 0);
+    inbox.releaseProducer(old);
+
+    // Not drained yet, so the new one gets another slot
+    auto& renewed = inbox.acquireProducer(1);
+    renewed.publish(makeEvent(2), 0);
+
+    std::vector<uint32_t> drained;
+    inbox.drain([&](const Event& event) { drained.push_back(entityOf(event)); });
+    EXPECT_EQ(drained, (std::vector<uint32_t>{1, 2}));
+}
+} // namespace core
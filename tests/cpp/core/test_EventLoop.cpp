@@ -3,6 +3,8 @@
 #include <stop_token>
 #include "EventLoop.h"
 #include "EventHandler.h"
+#include "InputEventQueue.h"
+#include "ServiceRegistry.h"
 
 using namespace testing;
 using namespace std;
@@ -57,6 +59,117 @@ TEST(EventLoopTest, TickEventIsTriggered)
     ASSERT_GT(mockListernerRawPtr->callCount, 2);
 }
 
+class MockInputListener : public EventHandler
+{
+  public:
+    MockInputListener()
+    {
+        registerCallback(Event::Type::KEY_DOWN, this, &MockInputListener::onKeyDown);
+    }
+
+    bool onKeyDown(const Event& e)
+    {
+        keyCode = e.getData<KeyboardData>().keyCode;
+        return false;
+    }
+    std::atomic<int> keyCode = 0;
+};
+
+class EventLoopInputTest : public Test
+{
+  protected:
+    Ref<InputEventQueue> inputQueue = CreateRef<InputEventQueue>();
+
+    void SetUp() override
+    {
+        ServiceRegistry::getInstance().registerService(inputQueue);
+    }
+
+    void TearDown() override
+    {
+        ServiceRegistry::getInstance().unregisterService<InputEventQueue>();
+    }
+};
+
+TEST_F(EventLoopInputTest, QueuedInputIsDispatched)
+{
+    std::stop_source stopSource;
+    std::stop_token stopToken = stopSource.get_token();
+
+    auto loop = CreateRef<EventLoop>(&stopToken);
+    std::shared_ptr<SubSystem> eventLoop = loop;
+
+    auto listener = std::make_shared<MockInputListener>();
+    loop->registerListener(listener);
+
+    InputEvent input;
+    input.type = Event::Type::KEY_DOWN;
+    input.keyCode = 42;
+    inputQueue->push(input);
+
+    eventLoop->init();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    stopSource.request_stop();
+    eventLoop->shutdown();
+    ASSERT_EQ(listener->keyCode, 42);
+}
+
+class MockBatchListener : public EventHandler
+{
+  public:
+    MockBatchListener()
+    {
+        registerBatchCallback(Event::Type::ENTITY_DELETE, this, &MockBatchListener::onDeletes);
+    }
+
+    // Consumes the even entities
+    void onDeletes(std::span<const Event> events, std::span<uint8_t> consumed)
+    {
+        for (size_t i = 0; i < events.size(); ++i)
+        {
+            if (consumed[i])
+                continue;
+            auto entity = events[i].getData<EntityDeleteData>().entity;
+            seen.push_back(entity);
+            consumed[i] = entity % 2 == 0;
+        }
+    }
+    std::vector<uint32_t> seen;
+};
+
+class MockDeleteListener : public EventHandler
+{
+  public:
+    MockDeleteListener()
+    {
+        registerCallback(Event::Type::ENTITY_DELETE, this, &MockDeleteListener::onDelete);
+    }
+
+    bool onDelete(const Event& e)
+    {
+        seen.push_back(e.getData<EntityDeleteData>().entity);
+        return false;
+    }
+    std::vector<uint32_t> seen;
+};
+
+TEST(EventLoopTest, BatchCallbackConsumesEvents)
+{
+    std::vector<Event> events;
+    for (uint32_t entity = 1; entity <= 4; ++entity)
+        events.emplace_back(Event::Type::ENTITY_DELETE, EntityDeleteData{entity});
+    std::vector<uint8_t> consumed(events.size(), false);
+    consumed[0] = true; // By a previous listener
+
+    MockBatchListener batchListener;
+    MockDeleteListener listener;
+    batchListener.dispatchEvents(Event::Type::ENTITY_DELETE, events, consumed);
+    listener.dispatchEvents(Event::Type::ENTITY_DELETE, events, consumed);
+
+    EXPECT_EQ(batchListener.seen, (std::vector<uint32_t>{2, 3, 4}));
+    EXPECT_EQ(listener.seen, (std::vector<uint32_t>{3}));
+}
+
 // TODO: Fix this. can't shutdown the eventloop
 // TEST(EventLoopTest, ShutdownStopsThread) {
 //     SubSystem* eventLoop = new EventLoop();
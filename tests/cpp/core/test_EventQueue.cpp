@@ -0,0 +1,99 @@
+#include "EventQueue.h"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace core
+{
+TEST(EventQueueTest, EmptyQueueDoesNotInvokeCallback)
+{
+    EventQueue queue;
+    int calls = 0;
+    queue.drain([&](Event::Type, std::span<const Event>) { ++calls; });
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(calls, 0);
+}
+
+TEST(EventQueueTest, ConsecutiveSameTypeEventsAreDeliveredAsOneBatch)
+{
+    EventQueue queue;
+    queue.push(Event(Event::Type::UNIT_TILE_MOVEMENT, UnitTileMovementData{1, Tile(1, 1)}));
+    queue.push(Event(Event::Type::UNIT_TILE_MOVEMENT, UnitTileMovementData{2, Tile(2, 2)}));
+    queue.push(Event(Event::Type::ENTITY_DELETE, EntityDeleteData{7}));
+    EXPECT_EQ(queue.size(), 3);
+
+    std::vector<Event::Type> types;
+    std::vector<uint32_t> movedUnits;
+    queue.drain(
+        [&](Event::Type type, std::span<const Event> events)
+        {
+            types.push_back(type);
+            if (type == Event::Type::UNIT_TILE_MOVEMENT)
+            {
+                for (auto& e : events)
+                    movedUnits.push_back(e.getData<UnitTileMovementData>().unit);
+            }
+        });
+
+    ASSERT_EQ(types.size(), 2);
+    EXPECT_EQ(types[0], Event::Type::UNIT_TILE_MOVEMENT);
+    EXPECT_EQ(types[1], Event::Type::ENTITY_DELETE);
+    EXPECT_EQ(movedUnits, (std::vector<uint32_t>{1, 2}));
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(EventQueueTest, OrderIsKeptAcrossTypes)
+{
+    EventQueue queue;
+    queue.push(Event(Event::Type::UNIT_TILE_MOVEMENT, UnitTileMovementData{1, Tile(1, 1)}));
+    queue.push(Event(Event::Type::ENTITY_DELETE, EntityDeleteData{1}));
+    queue.push(Event(Event::Type::UNIT_TILE_MOVEMENT, UnitTileMovementData{2, Tile(2, 2)}));
+    queue.push(Event(Event::Type::UNIT_TILE_MOVEMENT, UnitTileMovementData{3, Tile(3, 3)}));
+
+    std::vector<std::pair<Event::Type, uint32_t>> delivered;
+    std::vector<size_t> batchSizes;
+    queue.drain(
+        [&](Event::Type type, std::span<const Event> events)
+        {
+            batchSizes.push_back(events.size());
+            for (auto& e : events)
+            {
+                auto entity = type == Event::Type::ENTITY_DELETE
+                                  ? e.getData<EntityDeleteData>().entity
+                                  : e.getData<UnitTileMovementData>().unit;
+                delivered.emplace_back(type, entity);
+            }
+        });
+
+    using P = std::pair<Event::Type, uint32_t>;
+    EXPECT_EQ(delivered, (std::vector<P>{P{Event::Type::UNIT_TILE_MOVEMENT, 1},
+                                         P{Event::Type::ENTITY_DELETE, 1},
+                                         P{Event::Type::UNIT_TILE_MOVEMENT, 2},
+                                         P{Event::Type::UNIT_TILE_MOVEMENT, 3}}));
+    EXPECT_EQ(batchSizes, (std::vector<size_t>{1, 1, 2}));
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(EventQueueTest, EventsPublishedWhileDrainingAreDeliveredInNextPass)
+{
+    EventQueue queue;
+    queue.push(Event(Event::Type::ENTITY_DELETE, EntityDeleteData{1}));
+
+    std::vector<uint32_t> deleted;
+    queue.drain(
+        [&](Event::Type type, std::span<const Event> events)
+        {
+            for (auto& e : events)
+            {
+                auto entity = e.getData<EntityDeleteData>().entity;
+                deleted.push_back(entity);
+                if (entity < 3)
+                    queue.push(Event(Event::Type::ENTITY_DELETE, EntityDeleteData{entity + 1}));
+            }
+        });
+
+    EXPECT_EQ(deleted, (std::vector<uint32_t>{1, 2, 3}));
+    EXPECT_TRUE(queue.empty());
+}
+} // namespace core
@@ -0,0 +1,92 @@
+#include "FixedStepScheduler.h"
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono;
+
+namespace core
+{
+class FixedStepSchedulerTest : public ::testing::Test
+{
+  protected:
+    FixedStepScheduler scheduler{60, milliseconds(500)};
+    FixedStepScheduler::Clock::time_point start{};
+
+    void SetUp() override
+    {
+        scheduler.reset(start);
+    }
+
+    // Run all the due ticks at 'now' and return how many ran
+    int runDueTicks(FixedStepScheduler::Clock::time_point now, int* totalDeltaMs = nullptr)
+    {
+        int ticks = 0;
+        while (scheduler.beginTick(now))
+        {
+            if (totalDeltaMs)
+                *totalDeltaMs += scheduler.getDeltaTimeMs();
+            scheduler.endTick(now);
+            ++ticks;
+        }
+        return ticks;
+    }
+};
+
+TEST_F(FixedStepSchedulerTest, FirstTickIsDueImmediately)
+{
+    EXPECT_EQ(runDueTicks(start), 1);
+    EXPECT_EQ(scheduler.getNextDeadline() - start, nanoseconds(16'666'666));
+}
+
+TEST_F(FixedStepSchedulerTest, SimulatedTimeDoesNotDrift)
+{
+    int totalDeltaMs = 0;
+    int ticks = 0;
+    for (int ms = 0; ms < 1000; ++ms)
+    {
+        ticks += runDueTicks(start + milliseconds(ms), &totalDeltaMs);
+    }
+    // Ticks at 0, 16.67, ..., 983.33 ms
+    EXPECT_EQ(ticks, 60);
+    EXPECT_EQ(totalDeltaMs, 1000);
+    EXPECT_EQ(scheduler.getLatenessStats().count(), 60);
+    EXPECT_LT(scheduler.getLatenessStats().max(), 1000);
+}
+
+TEST_F(FixedStepSchedulerTest, CatchesUpWithinMaxDelay)
+{
+    runDueTicks(start);
+    // 100ms late, i.e. 6 ticks are due
+    EXPECT_EQ(runDueTicks(start + milliseconds(100)), 6);
+    EXPECT_EQ(scheduler.getDroppedTickCount(), 0);
+}
+
+TEST_F(FixedStepSchedulerTest, DropsBacklogBeyondMaxDelay)
+{
+    runDueTicks(start);
+    auto now = start + seconds(2);
+    EXPECT_EQ(runDueTicks(now), 1);
+    EXPECT_GT(scheduler.getDroppedTickCount(), 100);
+    EXPECT_EQ(scheduler.getNextDeadline(), now + nanoseconds(16'666'666));
+}
+
+TEST_F(FixedStepSchedulerTest, CountsOverruns)
+{
+    ASSERT_TRUE(scheduler.beginTick(start));
+    scheduler.endTick(start + milliseconds(20));
+    EXPECT_EQ(scheduler.getOverrunCount(), 1);
+    EXPECT_EQ(scheduler.getTickDurationStats().max(), 20000);
+}
+
+TEST_F(FixedStepSchedulerTest, TickRateChangeContinuesFromNextDeadline)
+{
+    runDueTicks(start);
+    auto deadline = scheduler.getNextDeadline();
+    scheduler.setTicksPerSecond(10);
+    EXPECT_EQ(scheduler.getNextDeadline(), deadline);
+
+    EXPECT_EQ(runDueTicks(deadline), 1);
+    EXPECT_EQ(scheduler.getDeltaTimeMs(), 100);
+    EXPECT_EQ(scheduler.getNextDeadline(), deadline + milliseconds(100));
+}
+} // namespace core
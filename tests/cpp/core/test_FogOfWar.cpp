@@ -221,4 +221,155 @@ TEST_F(FogOfWarTest, VisibleOverridesExplored)
     fog.markAsVisible(t, Constants::FEET_PER_TILE);
     EXPECT_EQ(fog.getRevealStatus(t), RevealStatus::VISIBLE);
 }
-} // namespace core
\ No newline at end of file
+
+TEST_F(FogOfWarTest, ExploredDoesNotDowngradeVisible)
+{
+    Tile t(5, 5);
+    fog.markAsVisible(t, Constants::FEET_PER_TILE);
+    fog.markAsExplored(t.toFeet(), 2 * Constants::FEET_PER_TILE);
+
+    EXPECT_EQ(fog.getRevealStatus(t), RevealStatus::VISIBLE);
+    EXPECT_TRUE(fog.isExplored(t));
+    EXPECT_EQ(fog.getRevealStatus(Tile(7, 5)), RevealStatus::EXPLORED);
+}
+
+TEST_F(FogOfWarTest, SetRevealStatusOverwritesSingleTile)
+{
+    fog.markAsVisible(Tile(5, 5), Constants::FEET_PER_TILE);
+    fog.setRevealStatus(Tile(5, 5), RevealStatus::UNEXPLORED);
+
+    EXPECT_EQ(fog.getRevealStatus(Tile(5, 5)), RevealStatus::UNEXPLORED);
+    EXPECT_EQ(fog.getRevealStatus(Tile(4, 5)), RevealStatus::VISIBLE);
+    EXPECT_EQ(fog.getRevealStatus(Tile(6, 5)), RevealStatus::VISIBLE);
+}
+
+TEST(FogOfWarPackingTest, StampsAcrossWordBoundaries)
+{
+    // Rows of 100 tiles span 4 words, 32 tiles each
+    FogOfWar fog;
+    fog.init(100, 40, RevealStatus::UNEXPLORED);
+
+    const Tile center(50, 20);
+    const int losTiles = 30;
+    fog.markAsExplored(center.toFeet(), losTiles * Constants::FEET_PER_TILE);
+
+    for (int y = 0; y < 40; ++y)
+    {
+        for (int x = 0; x < 100; ++x)
+        {
+            int dx = x - center.x;
+            int dy = y - center.y;
+            auto expected = dx * dx + dy * dy <= losTiles * losTiles ? RevealStatus::EXPLORED
+                                                                     : RevealStatus::UNEXPLORED;
+            EXPECT_EQ(fog.getRevealStatus(Tile(x, y)), expected)
+                << "Tile (" << x << "," << y << ") differs";
+        }
+    }
+}
+
+TEST(FogOfWarPackingTest, TwoBitsPerTile)
+{
+    FogOfWar fog;
+    fog.init(256, 256, RevealStatus::EXPLORED);
+
+    EXPECT_EQ(fog.getMemoryUsage(), 256 * 256 / 4);
+    EXPECT_TRUE(fog.isExplored(Tile(255, 255)));
+}
+
+TEST_F(FogOfWarTest, DeltaCarriesChangedRowsOnly)
+{
+    FogOfWar::Delta delta;
+    FogOfWar copy;
+    fog.takeDelta(delta, false);
+    EXPECT_EQ(delta.rows.size(), 10); // Everything is new after init
+    copy.applyDelta(delta);
+
+    fog.markAsVisible(Tile(5, 5), Constants::FEET_PER_TILE);
+    fog.takeDelta(delta, false);
+    EXPECT_EQ(delta.rows, (std::vector<int32_t>{4, 5, 6}));
+
+    copy.applyDelta(delta);
+    copy.applyDelta(delta); // Same delta again is harmless
+    EXPECT_EQ(copy.getRevealStatus(Tile(5, 5)), RevealStatus::VISIBLE);
+    EXPECT_EQ(copy.getRevealStatus(Tile(5, 4)), RevealStatus::VISIBLE);
+    EXPECT_EQ(copy.getRevealStatus(Tile(0, 0)), RevealStatus::UNEXPLORED);
+
+    // Nothing changes by exploring the explored again
+    fog.markAsExplored(Tile(5, 5).toFeet(), Constants::FEET_PER_TILE);
+    fog.takeDelta(delta, false);
+    EXPECT_TRUE(delta.rows.empty());
+
+    fog.setRevealStatus(Tile(5, 5), RevealStatus::EXPLORED);
+    fog.takeDelta(delta, false);
+    copy.applyDelta(delta);
+    EXPECT_EQ(copy.getRevealStatus(Tile(5, 5)), RevealStatus::EXPLORED);
+}
+
+TEST_F(FogOfWarTest, FullDeltaCarriesAllRows)
+{
+    FogOfWar::Delta delta;
+    fog.takeDelta(delta, false);
+    fog.takeDelta(delta, true);
+    EXPECT_EQ(delta.rows.size(), 10);
+    EXPECT_EQ(delta.width, 10);
+    EXPECT_EQ(delta.height, 10);
+}
+
+TEST(FogOfWarCircleSpansTest, MatchesDistanceCheck)
+{
+    for (int radius : {0, 1, 2, 7, 12, 255})
+    {
+        auto halfWidths = FogOfWar::getCircleSpans(radius);
+        ASSERT_EQ(halfWidths.size(), radius + 1);
+
+        for (int dy = 0; dy <= radius; ++dy)
+        {
+            int dx = halfWidths[dy];
+            EXPECT_LE(dx * dx + dy * dy, radius * radius);
+            EXPECT_GT((dx + 1) * (dx + 1) + dy * dy, radius * radius);
+        }
+    }
+}
+
+TEST(FogOfWarLandAreaSpansTest, MatchesNearestTileSearch)
+{
+    LandArea castle;
+    for (int x = 20; x < 24; ++x)
+        for (int y = 30; y < 34; ++y)
+            castle.tiles.emplace_back(x, y);
+    LandArea wall; // Diagonal, hence not a rectangle
+    for (int i = 0; i < 6; ++i)
+        wall.tiles.emplace_back(2 + i, 8 - i);
+
+    const Size mapSize(48, 48);
+    for (const auto* area : {&castle, &wall})
+    {
+        for (int radius : {0, 1, 3, 9})
+        {
+            std::vector<int> covered(mapSize.width * mapSize.height, 0);
+            FogOfWar::forEachSpanInRadius(*area, radius, mapSize,
+                                          [&](int32_t y, int32_t minX, int32_t maxX)
+                                          {
+                                              for (int32_t x = minX; x <= maxX; ++x)
+                                                  ++covered[y * mapSize.width + x];
+                                          });
+
+            for (int y = 0; y < mapSize.height; ++y)
+            {
+                for (int x = 0; x < mapSize.width; ++x)
+                {
+                    bool inRadius = false;
+                    for (const auto& tile : area->tiles)
+                    {
+                        const int dx = x - tile.x;
+                        const int dy = y - tile.y;
+                        inRadius = inRadius or dx * dx + dy * dy <= radius * radius;
+                    }
+                    ASSERT_EQ(covered[y * mapSize.width + x], inRadius ? 1 : 0)
+                        << "Tile (" << x << "," << y << ") with radius " << radius;
+                }
+            }
+        }
+    }
+}
+} // namespace core
@@ -0,0 +1,67 @@
+#include "FrameData.h"
+#include "components/CompGraphics.h"
+
+#include <gtest/gtest.h>
+
+namespace core
+{
+using namespace std::chrono;
+
+TEST(FrameDataTest, TickProgressOverInterval)
+{
+    FrameData frame;
+    EXPECT_FLOAT_EQ(frame.getTickProgress(steady_clock::now()), 1.0f); // Not ticked yet
+
+    frame.tickTime = steady_clock::now();
+    frame.tickInterval = milliseconds(50);
+    EXPECT_FLOAT_EQ(frame.getTickProgress(frame.tickTime), 0.0f);
+    EXPECT_NEAR(frame.getTickProgress(frame.tickTime + milliseconds(20)), 0.4f, 1e-4f);
+    EXPECT_FLOAT_EQ(frame.getTickProgress(frame.tickTime + milliseconds(80)), 1.0f);
+    EXPECT_FLOAT_EQ(frame.getTickProgress(frame.tickTime - milliseconds(1)), 0.0f);
+}
+
+TEST(FrameDataTest, InterpolatesBetweenTicks)
+{
+    CompGraphics graphics;
+    graphics.previousPositionInFeet = Feet(100, 200);
+    graphics.positionInFeet = Feet(120, 160);
+    graphics.positionTick = 5;
+
+    EXPECT_EQ(graphics.getInterpolatedPosition(0.0f, 5), Feet(100, 200));
+    EXPECT_EQ(graphics.getInterpolatedPosition(0.5f, 5), Feet(110, 180));
+    EXPECT_EQ(graphics.getInterpolatedPosition(1.0f, 5), Feet(120, 160));
+}
+
+TEST(FrameDataTest, JumpsAreNotInterpolated)
+{
+    CompGraphics graphics;
+    graphics.positionInFeet = Feet(120, 160);
+    EXPECT_EQ(graphics.getInterpolatedPosition(0.5f, 0), Feet(120, 160)); // Just spawned
+
+    graphics.previousPositionInFeet = Feet(120 + Constants::FEET_PER_TILE * 3, 160);
+    EXPECT_EQ(graphics.getInterpolatedPosition(0.5f, 0), Feet(120, 160));
+}
+
+// Only the moved entities are sent, hence the renderer's copy of a stopped one keeps the
+// positions of its last move
+TEST(FrameDataTest, StoppedEntityIsNotInterpolatedAgain)
+{
+    CompGraphics graphics;
+    graphics.entityID = 3;
+    graphics.previousPositionInFeet = Feet(100, 200);
+    graphics.positionInFeet = Feet(120, 200);
+    graphics.positionTick = 1;
+
+    GraphicsDeltaEncoder encoder;
+    GraphicsDeltaBuffer buffer;
+    encoder.encode(graphics, buffer);
+
+    CompGraphics received;
+    buffer.forEach([&](const GraphicsDelta& delta) { delta.applyTo(received); });
+    EXPECT_EQ(received.getInterpolatedPosition(0.5f, 1), Feet(110, 200));
+
+    // Ticks 2 and 3 without moving
+    EXPECT_EQ(received.getInterpolatedPosition(0.0f, 2), Feet(120, 200));
+    EXPECT_EQ(received.getInterpolatedPosition(0.5f, 3), Feet(120, 200));
+}
+} // namespace core
@@ -0,0 +1,125 @@
+#include "GraphicsDelta.h"
+#include "components/CompGraphics.h"
+
+#include <gtest/gtest.h>
+
+namespace core
+{
+class GraphicsDeltaTest : public ::testing::Test
+{
+  protected:
+    GraphicsDeltaEncoder encoder;
+    GraphicsDeltaBuffer buffer;
+    CompGraphics graphics;
+    CompGraphics received; // Renderer's copy
+
+    void SetUp() override
+    {
+        graphics.entityID = 7;
+        graphics.entityType = 12;
+        graphics.positionInFeet = Feet(100, 200);
+        graphics.addons = {{GraphicAddon::Type::ISO_CIRCLE, GraphicAddon::IsoCircle{5, Vec2(1, 2)},
+                            Alignment::BOTTOM_CENTER},
+                           {GraphicAddon::Type::TEXT,
+                            GraphicAddon::Text{"Town center", Color::RED}, Alignment::CENTER}};
+        graphics.debugOverlays = {DebugOverlay{DebugOverlay::Type::ARROW, Color::GREEN}};
+        graphics.landArea.tiles = {Tile(3, 4), Tile(4, 4)};
+    }
+
+    // The changed fields of the only record sent
+    uint16_t send()
+    {
+        buffer.clear();
+        encoder.encode(graphics, buffer);
+        EXPECT_EQ(buffer.getCount(), 1);
+
+        uint16_t changed = 0;
+        buffer.forEach(
+            [&](const GraphicsDelta& delta)
+            {
+                delta.applyTo(received);
+                changed = delta.changed;
+            });
+        return changed;
+    }
+};
+
+TEST_F(GraphicsDeltaTest, FirstRecordCarriesEverything)
+{
+    EXPECT_EQ(send(), GraphicsDelta::ALL);
+
+    EXPECT_EQ(received.entityID, 7);
+    EXPECT_EQ(GraphicsID(received), GraphicsID(graphics));
+    EXPECT_EQ(received.positionInFeet, Feet(100, 200));
+    EXPECT_TRUE(received.previousPositionInFeet.isNull());
+
+    ASSERT_EQ(received.addons.size(), 2);
+    EXPECT_EQ(received.addons[0].getData<GraphicAddon::IsoCircle>().radius, 5);
+    EXPECT_EQ(received.addons[0].alignment, Alignment::BOTTOM_CENTER);
+    EXPECT_EQ(received.addons[1].getData<GraphicAddon::Text>().text, "Town center");
+    EXPECT_EQ(received.addons[1].getData<GraphicAddon::Text>().color, Color::RED);
+
+    ASSERT_EQ(received.debugOverlays.size(), 1);
+    EXPECT_EQ(received.debugOverlays[0].type, DebugOverlay::Type::ARROW);
+    EXPECT_EQ(received.landArea.tiles, (std::vector<Tile>{Tile(3, 4), Tile(4, 4)}));
+}
+
+TEST_F(GraphicsDeltaTest, UnchangedPartsAreNotCarried)
+{
+    send();
+    EXPECT_EQ(send(), 0);
+    EXPECT_EQ(buffer.getSizeInBytes(), sizeof(GraphicsDelta));
+
+    graphics.previousPositionInFeet = graphics.positionInFeet;
+    graphics.positionInFeet = Feet(110, 200);
+    EXPECT_EQ(send(), GraphicsDelta::POSITION);
+    EXPECT_EQ(received.positionInFeet, Feet(110, 200));
+    EXPECT_EQ(received.previousPositionInFeet, Feet(100, 200));
+    EXPECT_EQ(received.addons.size(), 2); // Kept as is
+
+    graphics.addons[1].getData<GraphicAddon::Text>().text = "Barracks";
+    graphics.isEnabled = false;
+    EXPECT_EQ(send(), GraphicsDelta::ADDONS | GraphicsDelta::VISIBILITY);
+    EXPECT_EQ(received.addons[1].getData<GraphicAddon::Text>().text, "Barracks");
+    EXPECT_FALSE(received.isEnabled);
+}
+
+TEST_F(GraphicsDeltaTest, ClearedPartsAreCarried)
+{
+    send();
+    graphics.addons.clear();
+    graphics.landArea.tiles.clear();
+    EXPECT_EQ(send(), GraphicsDelta::ADDONS | GraphicsDelta::LAND_AREA);
+    EXPECT_TRUE(received.addons.empty());
+    EXPECT_TRUE(received.landArea.tiles.empty());
+    EXPECT_EQ(received.debugOverlays.size(), 1);
+}
+
+TEST_F(GraphicsDeltaTest, PrependedRecordsApplyFirst)
+{
+    GraphicsDeltaBuffer older;
+    encoder.encode(graphics, older);
+
+    graphics.positionInFeet = Feet(300, 200);
+    graphics.addons.pop_back();
+    encoder.encode(graphics, buffer);
+    buffer.prepend(older);
+    ASSERT_EQ(buffer.getCount(), 2);
+
+    buffer.forEach([&](const GraphicsDelta& delta) { delta.applyTo(received); });
+    EXPECT_EQ(received.positionInFeet, Feet(300, 200));
+    EXPECT_EQ(received.addons.size(), 1);
+    EXPECT_EQ(received.landArea.tiles.size(), 2); // From the older one only
+}
+
+TEST_F(GraphicsDeltaTest, DestroyedEntityIsSentWholeAgain)
+{
+    send();
+    graphics.isDestroyed = true;
+    EXPECT_EQ(send(), GraphicsDelta::VISIBILITY);
+    EXPECT_TRUE(received.isDestroyed);
+
+    graphics.isDestroyed = false;
+    EXPECT_EQ(send(), GraphicsDelta::ALL);
+}
+} // namespace core
@@ -0,0 +1,155 @@
+#include "EntityFactory.h"
+#include "ProjectileManager.h"
+#include "ServiceRegistry.h"
+#include "Settings.h"
+#include "StateManager.h"
+#include "components/CompArmor.h"
+#include "components/CompEntityInfo.h"
+#include "components/CompGraphics.h"
+#include "components/CompHealth.h"
+#include "components/CompProjectile.h"
+#include "components/CompTransform.h"
+
+#include <gtest/gtest.h>
+
+namespace core
+{
+class FakeProjectileFactory : public EntityFactory
+{
+  public:
+    uint32_t createEntity(uint32_t entityType) override
+    {
+        ++createdCount;
+        auto stateMan = ServiceRegistry::getInstance().getService<StateManager>();
+        auto entity = stateMan->createEntity();
+        stateMan->addComponent(entity, CompEntityInfo(entityType));
+        stateMan->addComponent(entity, CompTransform());
+        stateMan->addComponent(entity, CompGraphics());
+        CompProjectile projectile;
+        projectile.damageMode = ProjectileDamageMode::ON_HIT;
+        stateMan->addComponent(entity, projectile);
+        return entity;
+    }
+
+    int createdCount = 0;
+};
+
+class ProjectileManagerTest : public ::testing::Test, public PropertyInitializer
+{
+  protected:
+    void SetUp() override
+    {
+        ServiceRegistry::getInstance().registerService(std::make_shared<Settings>());
+        stateMan = std::make_shared<StateManager>();
+        stateMan->gameMap().init(10, 10);
+        ServiceRegistry::getInstance().registerService(stateMan);
+        factory = std::make_shared<FakeProjectileFactory>();
+        ServiceRegistry::getInstance().registerService<EntityFactory>(factory);
+    }
+
+    void TearDown() override
+    {
+        stateMan->clearAll();
+        ServiceRegistry::getInstance().unregisterService<EntityFactory>();
+    }
+
+    void shoot(const Feet& origin, const Feet& target, int speed)
+    {
+        ProjectileData data;
+        data.projectileEntityType = ARROW;
+        data.originPos = origin;
+        data.targetPos = target;
+        data.speed = speed;
+        data.properties = CreateRef<const ProjectileProperties>(
+            ProjectileProperties{{0, 10, 0}, {1.0f, 1.0f, 1.0f}, 1.0f, 1.0f});
+        manager.dispatchEvent(Event(Event::Type::PROJECTILE_CREATED, data));
+    }
+
+    // One second, i.e. a projectile travels its speed in feet
+    void tick()
+    {
+        manager.dispatchEvent(Event(Event::Type::TICK, TickData{1000, ++currentTick}));
+    }
+
+    uint32_t createUnit(const Feet& position, int collisionRadius)
+    {
+        auto unit = stateMan->createEntity();
+        CompTransform transform;
+        transform.position = position;
+        transform.collisionRadius = collisionRadius;
+        stateMan->addComponent(unit, transform);
+        CompHealth health;
+        health.health = 100;
+        stateMan->addComponent(unit, health);
+        CompArmor armor;
+        set(armor.armorPerClass, std::vector<int>{0, 0, 0});
+        set(armor.damageResistance, 0.0f);
+        stateMan->addComponent(unit, armor);
+
+        stateMan->gameMap().addEntity(MapLayerType::UNITS, position.toTile(), unit);
+        return unit;
+    }
+
+    uint32_t getOnlyProjectile()
+    {
+        auto projectiles = stateMan->getEntities<CompProjectile>();
+        EXPECT_EQ(projectiles.size(), 1);
+        return *projectiles.begin();
+    }
+
+    static constexpr uint32_t ARROW = 5;
+    static constexpr int TILE = Constants::FEET_PER_TILE;
+    Ref<StateManager> stateMan;
+    Ref<FakeProjectileFactory> factory;
+    ProjectileManager manager;
+    int currentTick = 0;
+};
+
+TEST_F(ProjectileManagerTest, ReleasedProjectileIsReused)
+{
+    shoot(Feet(1000, 1000), Feet(1100, 1000), 300);
+    auto projectile = getOnlyProjectile();
+    EXPECT_FALSE(stateMan->getComponent<CompEntityInfo>(projectile).isDestroyed);
+
+    tick(); // Missed, i.e. flew past the target
+    EXPECT_TRUE(stateMan->getComponent<CompEntityInfo>(projectile).isDestroyed);
+    EXPECT_TRUE(stateMan->getComponent<CompProjectile>(projectile).previousPixelPos.isNull());
+
+    shoot(Feet(2000, 1000), Feet(2100, 1000), 300);
+    EXPECT_EQ(getOnlyProjectile(), projectile);
+    EXPECT_EQ(factory->createdCount, 1);
+    EXPECT_FALSE(stateMan->getComponent<CompEntityInfo>(projectile).isDestroyed);
+    EXPECT_EQ(stateMan->getComponent<CompTransform>(projectile).position, Feet(2000, 1000));
+
+    // Another one while the first is in flight
+    shoot(Feet(2000, 1000), Feet(2100, 1000), 300);
+    EXPECT_EQ(factory->createdCount, 2);
+}
+
+TEST_F(ProjectileManagerTest, HitsUnitStandingAcrossTileBorder)
+{
+    // The unit is on tile (4, 4) right at its border, the projectile lands on tile (5, 4)
+    auto unit = createUnit(Feet(5 * TILE - 5, 4 * TILE + 128), 20);
+    auto farUnit = createUnit(Feet(3 * TILE + 128, 4 * TILE + 128), 20);
+    const Feet target(5 * TILE + 5, 4 * TILE + 128);
+
+    shoot(target - Feet(100, 0), target, 100);
+    tick();
+
+    EXPECT_FLOAT_EQ(stateMan->getComponent<CompHealth>(unit).health, 90);
+    EXPECT_FLOAT_EQ(stateMan->getComponent<CompHealth>(farUnit).health, 100);
+    EXPECT_TRUE(stateMan->getComponent<CompEntityInfo>(getOnlyProjectile()).isDestroyed);
+}
+
+TEST_F(ProjectileManagerTest, HitsUnitStandingAcrossTileCorner)
+{
+    // The unit is on tile (4, 3) at its corner, the projectile lands on tile (5, 4)
+    auto unit = createUnit(Feet(5 * TILE - 5, 4 * TILE - 5), 20);
+    const Feet target(5 * TILE + 5, 4 * TILE + 5);
+
+    shoot(target - Feet(0, 100), target, 100);
+    tick();
+
+    EXPECT_FLOAT_EQ(stateMan->getComponent<CompHealth>(unit).health, 90);
+}
+} // namespace core
@@ -0,0 +1,72 @@
+#include "ResourceIndex.h"
+#include "ServiceRegistry.h"
+#include "Settings.h"
+#include "StateManager.h"
+#include "components/CompEntityInfo.h"
+#include "components/CompResource.h"
+
+#include <array>
+#include <gtest/gtest.h>
+
+namespace core
+{
+class ResourceIndexTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        ServiceRegistry::getInstance().registerService(std::make_shared<Settings>());
+        stateMan = std::make_shared<StateManager>();
+        ServiceRegistry::getInstance().registerService(stateMan);
+
+        index.init(32, 32);
+    }
+
+    void TearDown() override
+    {
+        stateMan->clearAll();
+    }
+
+    uint32_t addResource(const Tile& tile, uint32_t remainingAmount)
+    {
+        auto entity = stateMan->createEntity();
+        CompResource resource;
+        resource.remainingAmount = remainingAmount;
+        stateMan->addComponent(entity, resource);
+        stateMan->addComponent(entity, CompEntityInfo());
+
+        index.addResource(entity, WOOD, tile);
+        return entity;
+    }
+
+    static constexpr uint8_t WOOD = 1;
+    Ref<StateManager> stateMan;
+    ResourceIndex index;
+};
+
+TEST_F(ResourceIndexTest, FindsNearestOfTheType)
+{
+    addResource(Tile(8, 8), 100);
+    auto nearest = addResource(Tile(2, 2), 100);
+
+    EXPECT_EQ(index.findNearest(WOOD, Tile(0, 0)), nearest);
+    EXPECT_EQ(index.findNearest(WOOD, Tile(0, 0), 1), (uint32_t) entt::null);
+    EXPECT_EQ(index.findNearest(WOOD + 1, Tile(0, 0)), (uint32_t) entt::null);
+}
+
+TEST_F(ResourceIndexTest, SkipsExhaustedAndDestroyedResources)
+{
+    auto available = addResource(Tile(8, 8), 100);
+    addResource(Tile(1, 1), 0);
+    auto destroyed = addResource(Tile(2, 2), 100);
+    stateMan->getComponent<CompEntityInfo>(destroyed).isDestroyed = true;
+
+    EXPECT_EQ(index.findNearest(WOOD, Tile(0, 0)), available);
+
+    std::array<uint32_t, 4> found;
+    EXPECT_EQ(index.findNearest(WOOD, Tile(0, 0), 16, found), 1);
+    EXPECT_EQ(found[0], available);
+    EXPECT_EQ(index.findInRadius(WOOD, Tile(0, 0), 16, found), 1);
+    EXPECT_EQ(found[0], available);
+}
+} // namespace core
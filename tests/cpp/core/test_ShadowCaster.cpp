@@ -0,0 +1,116 @@
+#include "ShadowCaster.h"
+#include "TileMap.h"
+
+#include <gtest/gtest.h>
+
+namespace core
+{
+class ShadowCasterTest : public ::testing::Test
+{
+  protected:
+    static constexpr uint32_t VIEWER = 1;
+    static constexpr uint32_t WALL = 2;
+
+    TileMap tileMap;
+    ShadowCaster caster;
+
+    void SetUp() override
+    {
+        tileMap.init(32, 32);
+        caster.init(32, 32);
+    }
+
+    void addOccluder(const Tile& tile, uint32_t entity)
+    {
+        tileMap.addEntity(MapLayerType::STATIC, tile, entity);
+        caster.onOccluderChanged(tile);
+    }
+
+    bool isVisible(const Tile& target, uint8_t radius = 8)
+    {
+        return caster.isVisible(tileMap, Tile(8, 10), radius, VIEWER, target);
+    }
+};
+
+TEST_F(ShadowCasterTest, OpenGroundSeesWholeCircle)
+{
+    const int radius = 6;
+    for (int dy = -radius - 1; dy <= radius + 1; ++dy)
+    {
+        for (int dx = -radius - 1; dx <= radius + 1; ++dx)
+        {
+            EXPECT_EQ(isVisible(Tile(8 + dx, 10 + dy), radius),
+                      dx * dx + dy * dy <= radius * radius)
+                << "Offset (" << dx << "," << dy << ")";
+        }
+    }
+}
+
+TEST_F(ShadowCasterTest, WallCastsShadow)
+{
+    for (int y = 8; y <= 12; ++y)
+        addOccluder(Tile(11, y), WALL);
+
+    EXPECT_TRUE(isVisible(Tile(11, 10))); // The wall itself
+    EXPECT_FALSE(isVisible(Tile(12, 10)));
+    EXPECT_FALSE(isVisible(Tile(15, 11)));
+    EXPECT_TRUE(isVisible(Tile(5, 10)));
+    EXPECT_TRUE(isVisible(Tile(8, 3)));
+}
+
+TEST_F(ShadowCasterTest, ViewerDoesNotBlockItself)
+{
+    addOccluder(Tile(8, 10), VIEWER);
+    addOccluder(Tile(9, 10), VIEWER);
+    EXPECT_TRUE(isVisible(Tile(12, 10)));
+
+    addOccluder(Tile(9, 10), WALL); // Shared with another
+    EXPECT_FALSE(isVisible(Tile(12, 10)));
+}
+
+TEST_F(ShadowCasterTest, CastsAgainOnlyForChangesWithinRadius)
+{
+    isVisible(Tile(12, 10));
+    isVisible(Tile(3, 10));
+    EXPECT_EQ(caster.getCastCount(), 1);
+
+    addOccluder(Tile(30, 30), WALL); // Far away
+    EXPECT_TRUE(isVisible(Tile(12, 10)));
+    EXPECT_EQ(caster.getCastCount(), 1);
+
+    addOccluder(Tile(10, 10), WALL);
+    EXPECT_FALSE(isVisible(Tile(12, 10)));
+    EXPECT_EQ(caster.getCastCount(), 2);
+}
+
+TEST_F(ShadowCasterTest, ForgottenOriginIsCastAgain)
+{
+    isVisible(Tile(12, 10));
+    EXPECT_EQ(caster.getCachedCount(), 1);
+
+    caster.forget(Tile(8, 10), 8);
+    EXPECT_EQ(caster.getCachedCount(), 0);
+    isVisible(Tile(12, 10));
+    EXPECT_EQ(caster.getCastCount(), 2);
+}
+
+TEST_F(ShadowCasterTest, LeastRecentlyUsedIsEvictedWhenFull)
+{
+    caster.init(32, 32, 2);
+    auto isVisibleFrom = [&](const Tile& origin)
+    { return caster.isVisible(tileMap, origin, 4, VIEWER, origin); };
+
+    isVisibleFrom(Tile(4, 4));
+    isVisibleFrom(Tile(20, 4));
+    isVisibleFrom(Tile(4, 4)); // Used again, hence (20, 4) is the oldest
+    isVisibleFrom(Tile(4, 20));
+    EXPECT_EQ(caster.getCachedCount(), 2);
+    EXPECT_EQ(caster.getCastCount(), 3);
+
+    isVisibleFrom(Tile(4, 4));
+    EXPECT_EQ(caster.getCastCount(), 3);
+    isVisibleFrom(Tile(20, 4));
+    EXPECT_EQ(caster.getCastCount(), 4);
+    EXPECT_EQ(caster.getCachedCount(), 2);
+}
+} // namespace core
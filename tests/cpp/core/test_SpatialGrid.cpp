@@ -0,0 +1,118 @@
+#include "SpatialGrid.h"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+
+namespace core
+{
+TEST(SpatialGridTest, FindsNearestAcrossBuckets)
+{
+    SpatialGrid grid;
+    grid.init(100, 100);
+    grid.insert(1, Tile(50, 50));
+    grid.insert(2, Tile(10, 10));
+    grid.insert(3, Tile(90, 95));
+
+    auto nearest = grid.findNearest(Tile(0, 0));
+    ASSERT_TRUE(nearest.has_value());
+    EXPECT_EQ(nearest->entity, 2);
+
+    nearest = grid.findNearest(Tile(99, 99));
+    ASSERT_TRUE(nearest.has_value());
+    EXPECT_EQ(nearest->entity, 3);
+}
+
+TEST(SpatialGridTest, RespectsMaxRadius)
+{
+    SpatialGrid grid;
+    grid.init(64, 64);
+    grid.insert(1, Tile(20, 0));
+
+    EXPECT_FALSE(grid.findNearest(Tile(0, 0), 19).has_value());
+    EXPECT_TRUE(grid.findNearest(Tile(0, 0), 20).has_value());
+}
+
+TEST(SpatialGridTest, SkipsRejectedEntities)
+{
+    SpatialGrid grid;
+    grid.init(64, 64);
+    grid.insert(1, Tile(1, 1));
+    grid.insert(2, Tile(30, 30));
+
+    auto nearest = grid.findNearest(Tile(0, 0), SpatialGrid::UNLIMITED_RADIUS,
+                                    [](const SpatialGrid::Item& item) { return item.entity != 1; });
+    ASSERT_TRUE(nearest.has_value());
+    EXPECT_EQ(nearest->entity, 2);
+}
+
+TEST(SpatialGridTest, RemoveAndMove)
+{
+    SpatialGrid grid;
+    grid.init(64, 64);
+    grid.insert(1, Tile(5, 5));
+    grid.insert(2, Tile(40, 40));
+
+    EXPECT_TRUE(grid.move(1, Tile(5, 5), Tile(50, 50)));
+    EXPECT_EQ(grid.findNearest(Tile(0, 0))->entity, 2);
+
+    EXPECT_TRUE(grid.remove(2, Tile(40, 40)));
+    EXPECT_FALSE(grid.remove(2, Tile(40, 40)));
+    EXPECT_EQ(grid.size(), 1);
+    EXPECT_EQ(grid.findNearest(Tile(0, 0))->entity, 1);
+}
+
+TEST(SpatialGridTest, QueriesMatchBruteForce)
+{
+    SpatialGrid grid;
+    grid.init(200, 150);
+
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> xs(0, 199);
+    std::uniform_int_distribution<int> ys(0, 149);
+
+    std::vector<SpatialGrid::Item> items;
+    for (uint32_t entity = 0; entity < 500; ++entity)
+    {
+        Tile tile(xs(gen), ys(gen));
+        grid.insert(entity, tile);
+        items.push_back({entity, tile});
+    }
+
+    auto distance = [](const Tile& a, const Tile& b)
+    { return (a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y); };
+
+    for (int i = 0; i < 100; ++i)
+    {
+        Tile from(xs(gen), ys(gen));
+        const int radius = 5 + i % 40;
+
+        std::vector<int> expected;
+        for (const auto& item : items)
+        {
+            auto d = distance(from, item.tile);
+            if (d <= radius * radius)
+                expected.push_back(d);
+        }
+        std::sort(expected.begin(), expected.end());
+
+        auto nearest = grid.findNearest(from, radius);
+        ASSERT_EQ(nearest.has_value(), not expected.empty());
+        if (nearest)
+        {
+            EXPECT_EQ(distance(from, nearest->tile), expected.front());
+        }
+
+        std::array<uint32_t, 8> nearestK;
+        auto count = grid.findKNearest(from, radius, nearestK);
+        ASSERT_EQ(count, std::min(expected.size(), nearestK.size()));
+        for (size_t k = 0; k < count; ++k)
+        {
+            EXPECT_EQ(distance(from, items[nearestK[k]].tile), expected[k]);
+        }
+
+        std::array<uint32_t, 500> inRadius;
+        EXPECT_EQ(grid.findInRadius(from, radius, inRadius), expected.size());
+    }
+}
+} // namespace core
@@ -0,0 +1,170 @@
+#include "EventHandler.h"
+#include "StateManager.h"
+#include "SystemScheduler.h"
+#include "TestEventPublisher.h"
+
+#include <gtest/gtest.h>
+#include <mutex>
+
+namespace core
+{
+namespace
+{
+struct CompA
+{
+};
+struct CompB
+{
+};
+
+class RecordingSystem : public EventHandler
+{
+  public:
+    RecordingSystem(int id, std::vector<int>& order, std::mutex& mutex)
+        : m_id(id), m_order(order), m_mutex(mutex)
+    {
+        registerCallback(Event::Type::TICK, this, &RecordingSystem::onTick);
+    }
+
+    void declare(const SystemAccess& access)
+    {
+        declareAccess(access);
+    }
+
+    bool onTick(const Event& e)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_order.push_back(m_id);
+            if (StateManager::getDirtyEntities().contains(DIRTY_ENTITY))
+                ++sawDirtyCount;
+        }
+        publishEvent(Event::Type::ENTITY_DELETE, EntityDeleteData{static_cast<uint32_t>(m_id)});
+        return false;
+    }
+
+    static constexpr uint32_t DIRTY_ENTITY = 42;
+    int sawDirtyCount = 0;
+
+  private:
+    int m_id = 0;
+    std::vector<int>& m_order;
+    std::mutex& m_mutex;
+};
+} // namespace
+
+class SystemSchedulerTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        publisher = std::make_shared<test::TestEventPublisher>();
+        publisher->install();
+    }
+
+    std::shared_ptr<RecordingSystem> addSystem(std::optional<SystemAccess> access)
+    {
+        auto system = std::make_shared<RecordingSystem>(systems.size(), order, mutex);
+        if (access)
+            system->declare(access.value());
+        systems.push_back(system);
+        return system;
+    }
+
+    std::shared_ptr<test::TestEventPublisher> publisher;
+    std::list<std::shared_ptr<EventHandler>> systems;
+    std::vector<int> order;
+    std::mutex mutex;
+    Event tick{Event::Type::TICK, TickData{}};
+};
+
+TEST(SystemAccessTest, Conflicts)
+{
+    auto reader = SystemAccess().reads<CompA>();
+    auto writer = SystemAccess().writes<CompA>();
+    auto appender = SystemAccess().appends<CompA>();
+    auto other = SystemAccess().writes<CompB>();
+
+    EXPECT_FALSE(reader.conflictsWith(SystemAccess().reads<CompA>()));
+    EXPECT_TRUE(reader.conflictsWith(writer));
+    EXPECT_TRUE(writer.conflictsWith(reader));
+    EXPECT_TRUE(reader.conflictsWith(appender));
+    EXPECT_FALSE(appender.conflictsWith(SystemAccess().appends<CompA>()));
+    EXPECT_FALSE(writer.conflictsWith(other));
+}
+
+TEST_F(SystemSchedulerTest, UndeclaredSystemsRunSeriallyInOrder)
+{
+    addSystem(std::nullopt);
+    addSystem(std::nullopt);
+    addSystem(std::nullopt);
+
+    SystemScheduler scheduler;
+    scheduler.setSystems(systems);
+    EXPECT_FALSE(scheduler.isParallel());
+
+    scheduler.dispatch(tick);
+    EXPECT_EQ(order, (std::vector<int>{0, 1, 2}));
+    EXPECT_EQ(publisher->events().size(), 3);
+}
+
+TEST_F(SystemSchedulerTest, ConflictingSystemsKeepOrder)
+{
+    addSystem(SystemAccess().writes<CompA>());
+    addSystem(SystemAccess().writes<CompB>());
+    addSystem(SystemAccess().reads<CompA>()); // Must run after 0
+    addSystem(std::nullopt);                  // Barrier
+
+    SystemScheduler scheduler;
+    scheduler.setSystems(systems);
+    EXPECT_TRUE(scheduler.isParallel());
+
+    for (int i = 0; i < 50; ++i)
+    {
+        order.clear();
+        scheduler.dispatch(tick);
+
+        auto position = [&](int id) { return std::find(order.begin(), order.end(), id); };
+        ASSERT_EQ(order.size(), 4);
+        EXPECT_LT(position(0), position(2));
+        EXPECT_EQ(order.back(), 3);
+    }
+}
+
+TEST_F(SystemSchedulerTest, EventsAreCommittedInRegistrationOrder)
+{
+    for (int i = 0; i < 4; ++i)
+        addSystem(SystemAccess());
+
+    SystemScheduler scheduler;
+    scheduler.setSystems(systems);
+    scheduler.dispatch(tick);
+
+    ASSERT_EQ(publisher->events().size(), 4);
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(publisher->events()[i].getData<EntityDeleteData>().entity, i);
+    }
+}
+
+// Marked on the event loop (i.e. the dispatching thread), read by systems on the pool threads
+TEST_F(SystemSchedulerTest, SystemsSeeTheMarksOfTheDispatchingThread)
+{
+    std::vector<std::shared_ptr<RecordingSystem>> readers;
+    for (int i = 0; i < 4; ++i)
+        readers.push_back(addSystem(SystemAccess()));
+
+    SystemScheduler scheduler;
+    scheduler.setSystems(systems);
+    ASSERT_TRUE(scheduler.isParallel());
+
+    StateManager::markDirty(RecordingSystem::DIRTY_ENTITY);
+    scheduler.dispatch(tick);
+    StateManager::clearDirtyEntities();
+
+    for (const auto& reader : readers)
+    {
+        EXPECT_EQ(reader->sawDirtyCount, 1);
+    }
+}
+} // namespace core
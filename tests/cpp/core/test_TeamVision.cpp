@@ -0,0 +1,258 @@
+#include "FogOfWar.h"
+#include "Player.h"
+#include "Property.h"
+#include "ServiceRegistry.h"
+#include "Settings.h"
+#include "StateManager.h"
+#include "TeamVision.h"
+#include "Tile.h"
+#include "components/CompPlayer.h"
+#include "components/CompVision.h"
+#include "utils/Constants.h"
+
+#include <array>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace core
+{
+class TeamVisionTest : public ::testing::Test
+{
+  protected:
+    TeamVision team;
+    FogOfWar fog;
+
+    void SetUp() override
+    {
+        team.init(10, 10);
+        fog.init(10, 10, RevealStatus::UNEXPLORED);
+    }
+
+    RevealStatus getSynced(const Tile& tile)
+    {
+        fog.syncVisibility(team);
+        return fog.getRevealStatus(tile);
+    }
+};
+
+TEST_F(TeamVisionTest, SightDecaysToExplored)
+{
+    const uint32_t losFeet = 2 * Constants::FEET_PER_TILE;
+    team.addSight(Tile(2, 5), losFeet);
+    EXPECT_EQ(getSynced(Tile(2, 5)), RevealStatus::VISIBLE);
+    EXPECT_EQ(getSynced(Tile(4, 5)), RevealStatus::VISIBLE);
+
+    team.removeSight(Tile(2, 5), losFeet);
+    EXPECT_EQ(getSynced(Tile(2, 5)), RevealStatus::EXPLORED);
+    EXPECT_EQ(getSynced(Tile(4, 5)), RevealStatus::EXPLORED);
+    EXPECT_EQ(getSynced(Tile(5, 5)), RevealStatus::UNEXPLORED);
+}
+
+TEST_F(TeamVisionTest, OverlappingSightsAreCounted)
+{
+    const uint32_t losFeet = 2 * Constants::FEET_PER_TILE;
+    team.addSight(Tile(3, 5), losFeet);
+    team.addSight(Tile(5, 5), losFeet);
+
+    team.removeSight(Tile(3, 5), losFeet);
+    EXPECT_EQ(getSynced(Tile(3, 5)), RevealStatus::VISIBLE); // Seen by the other
+    EXPECT_EQ(getSynced(Tile(2, 5)), RevealStatus::EXPLORED);
+}
+
+TEST_F(TeamVisionTest, MovingSightMatchesRemoveAndAdd)
+{
+    const uint32_t losFeet = 3 * Constants::FEET_PER_TILE;
+    TeamVision expected;
+    expected.init(10, 10);
+
+    const std::vector<Tile> path{Tile(1, 1), Tile(2, 1), Tile(3, 2), Tile(3, 3),
+                                 Tile(8, 8), Tile(9, 9), Tile(0, 9)};
+    team.addSight(path.front(), losFeet);
+    expected.addSight(path.front(), losFeet);
+    for (size_t i = 1; i < path.size(); ++i)
+    {
+        team.moveSight(path[i - 1], path[i], losFeet);
+        expected.removeSight(path[i - 1], losFeet);
+        expected.addSight(path[i], losFeet);
+
+        for (int y = 0; y < 10; ++y)
+            for (int x = 0; x < 10; ++x)
+                ASSERT_EQ(team.isVisible(Tile(x, y)), expected.isVisible(Tile(x, y)))
+                    << "Tile (" << x << "," << y << ") differs after step " << i;
+    }
+}
+
+TEST_F(TeamVisionTest, LandAreaSight)
+{
+    LandArea area{{Tile(3, 3), Tile(4, 3), Tile(3, 4), Tile(4, 4)}};
+    const uint32_t losFeet = Constants::FEET_PER_TILE;
+
+    team.addSight(area, losFeet);
+    EXPECT_EQ(getSynced(Tile(2, 3)), RevealStatus::VISIBLE);
+    EXPECT_EQ(getSynced(Tile(2, 2)), RevealStatus::UNEXPLORED);
+
+    team.removeSight(area, losFeet);
+    EXPECT_EQ(getSynced(Tile(2, 3)), RevealStatus::EXPLORED);
+    EXPECT_EQ(getSynced(Tile(4, 4)), RevealStatus::EXPLORED);
+}
+
+TEST_F(TeamVisionTest, SyncTouchesChangedRowsOnly)
+{
+    fog.syncVisibility(team);
+    fog.markAsVisible(Tile(1, 1), 0); // Uncounted, lasts until its row changes
+
+    team.addSight(Tile(5, 5), Constants::FEET_PER_TILE);
+    EXPECT_EQ(getSynced(Tile(1, 1)), RevealStatus::VISIBLE);
+
+    FogOfWar::Delta delta;
+    fog.takeDelta(delta, false);
+    team.removeSight(Tile(5, 5), Constants::FEET_PER_TILE);
+    fog.syncVisibility(team);
+    fog.takeDelta(delta, false);
+    EXPECT_EQ(delta.rows, (std::vector<int32_t>{4, 5, 6}));
+
+    // A different team is synced in full
+    TeamVision other;
+    other.init(10, 10);
+    fog.syncVisibility(other);
+    EXPECT_EQ(fog.getRevealStatus(Tile(1, 1)), RevealStatus::EXPLORED);
+    EXPECT_EQ(fog.getRevealStatus(Tile(5, 5)), RevealStatus::EXPLORED);
+}
+
+TEST_F(TeamVisionTest, ReplacedTeamAtTheSameAddressIsSyncedInFull)
+{
+    team.addSight(Tile(5, 5), Constants::FEET_PER_TILE);
+    EXPECT_EQ(getSynced(Tile(5, 5)), RevealStatus::VISIBLE);
+
+    // E.g. a new team allocated where the old one was
+    team.init(10, 10);
+    EXPECT_EQ(getSynced(Tile(5, 5)), RevealStatus::EXPLORED);
+}
+
+TEST_F(TeamVisionTest, MergedTeamsAddUpSights)
+{
+    TeamVision other;
+    other.init(10, 10);
+    team.addSight(Tile(2, 2), 0);
+    other.addSight(Tile(2, 2), 0);
+    other.addSight(Tile(7, 7), 0);
+
+    const auto version = team.getVersion();
+    team.addSights(other);
+    EXPECT_GT(team.getRowVersion(0), version);
+
+    team.removeSight(Tile(2, 2), 0);
+    EXPECT_TRUE(team.isVisible(Tile(2, 2)));
+    EXPECT_TRUE(team.isVisible(Tile(7, 7)));
+}
+
+class TeamVisionPlayerTest : public ::testing::Test, public PropertyInitializer
+{
+  protected:
+    void SetUp() override
+    {
+        ServiceRegistry::getInstance().registerService(std::make_shared<Settings>());
+        stateMan = std::make_shared<StateManager>();
+        ServiceRegistry::getInstance().registerService(stateMan);
+
+        for (uint8_t id = 0; id < players.size(); ++id)
+        {
+            players[id] = std::make_shared<Player>();
+            players[id]->init(id);
+        }
+    }
+
+    void TearDown() override
+    {
+        stateMan->clearAll();
+    }
+
+    // A unit of the player seeing the tile around it
+    void addUnit(Ref<Player> player, const Tile& tile)
+    {
+        auto unit = stateMan->createEntity();
+        CompVision vision;
+        PropertyInitializer::set<uint32_t>(vision.lineOfSight, Constants::FEET_PER_TILE);
+        vision.sightCenter = tile;
+        vision.hasVision = true;
+        stateMan->addComponent<CompVision>(unit, vision);
+        stateMan->addComponent<CompPlayer>(unit, CompPlayer{player});
+
+        player->getVision()->addSight(tile, Constants::FEET_PER_TILE);
+    }
+
+    void setMutual(size_t a, size_t b, Allegiance allegiance)
+    {
+        players[a]->setAllegiance(players[b], allegiance);
+        players[b]->setAllegiance(players[a], allegiance);
+    }
+
+    RevealStatus getStatus(size_t player, const Tile& tile)
+    {
+        auto fog = players[player]->getFogOfWar();
+        fog->syncVisibility(*players[player]->getVision());
+        return fog->getRevealStatus(tile);
+    }
+
+    Ref<StateManager> stateMan;
+    std::array<Ref<Player>, 4> players;
+};
+
+TEST_F(TeamVisionPlayerTest, MutualAlliesShareVision)
+{
+    addUnit(players[1], Tile(5, 5));
+    EXPECT_EQ(getStatus(0, Tile(5, 5)), RevealStatus::UNEXPLORED);
+
+    // One sided alliance isn't enough
+    players[0]->setAllegiance(players[1], Allegiance::ALLY);
+    EXPECT_NE(players[0]->getVision(), players[1]->getVision());
+
+    players[1]->setAllegiance(players[0], Allegiance::ALLY);
+    EXPECT_EQ(players[0]->getVision(), players[1]->getVision());
+    EXPECT_EQ(getStatus(0, Tile(5, 5)), RevealStatus::VISIBLE);
+    EXPECT_EQ(getStatus(2, Tile(5, 5)), RevealStatus::UNEXPLORED);
+}
+
+TEST_F(TeamVisionPlayerTest, BreakingAllianceSplitsSights)
+{
+    addUnit(players[0], Tile(2, 2));
+    addUnit(players[1], Tile(5, 5));
+    setMutual(0, 1, Allegiance::ALLY);
+    setMutual(1, 2, Allegiance::ALLY);
+    EXPECT_EQ(players[0]->getVision(), players[2]->getVision());
+
+    // Still a team through player 1
+    setMutual(0, 2, Allegiance::ENEMY);
+    EXPECT_EQ(players[0]->getVision(), players[2]->getVision());
+
+    setMutual(0, 1, Allegiance::ENEMY);
+    EXPECT_NE(players[0]->getVision(), players[1]->getVision());
+    EXPECT_EQ(players[1]->getVision(), players[2]->getVision());
+
+    EXPECT_EQ(getStatus(0, Tile(2, 2)), RevealStatus::VISIBLE);
+    EXPECT_EQ(getStatus(0, Tile(5, 5)), RevealStatus::EXPLORED);
+    EXPECT_EQ(getStatus(2, Tile(5, 5)), RevealStatus::VISIBLE);
+    EXPECT_FALSE(players[1]->getVision()->isVisible(Tile(2, 2)));
+}
+
+TEST_F(TeamVisionPlayerTest, SplitKeepsSightsOfPlayersOutsideTheTeam)
+{
+    addUnit(players[0], Tile(2, 2));
+    addUnit(players[1], Tile(5, 5));
+    addUnit(players[3], Tile(8, 8)); // Never allied with the others
+    setMutual(0, 1, Allegiance::ALLY);
+
+    setMutual(0, 1, Allegiance::ENEMY);
+    EXPECT_NE(players[0]->getVision(), players[1]->getVision());
+
+    EXPECT_EQ(getStatus(3, Tile(8, 8)), RevealStatus::VISIBLE);
+    EXPECT_FALSE(players[0]->getVision()->isVisible(Tile(8, 8)));
+    EXPECT_FALSE(players[1]->getVision()->isVisible(Tile(8, 8)));
+    EXPECT_TRUE(players[0]->getVision()->isVisible(Tile(2, 2)));
+    EXPECT_TRUE(players[1]->getVision()->isVisible(Tile(5, 5)));
+
+    // Counted once, hence removing it once hides the tile
+    players[3]->getVision()->removeSight(Tile(8, 8), Constants::FEET_PER_TILE);
+    EXPECT_EQ(getStatus(3, Tile(8, 8)), RevealStatus::EXPLORED);
+}
+} // namespace core
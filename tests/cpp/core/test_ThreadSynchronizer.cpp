@@ -1,14 +1,13 @@
-#ifndef TEST_THREADSYNCHRONIZER_H
-#define TEST_THREADSYNCHRONIZER_H
-
 #include "ThreadSynchronizer.h"
 #include "FrameData.h"
-#include <gtest/gtest.h>
-#include <thread>
-#include <gtest/gtest.h>
+#include "GraphicsDelta.h"
+#include "components/CompGraphics.h"
+
+#include <atomic>
 #include <chrono>
+#include <gtest/gtest.h>
 #include <thread>
-#include <atomic>
+#include <vector>
 
 namespace core
 {
@@ -17,6 +16,29 @@ class ThreadSynchronizerTest : public ::testing::Test
 {
   protected:
     ThreadSynchronizer<FrameData> synchronizer;
+
+    void publish(int frameNumber, std::vector<int> entities)
+    {
+        auto& frame = synchronizer.getSenderFrameData();
+        frame.frameNumber = frameNumber;
+        CompGraphics graphics;
+        for (auto entity : entities)
+        {
+            graphics.entityID = entity;
+            frame.graphicUpdates.append(graphics, GraphicsDelta::ALL);
+        }
+        synchronizer.publish();
+    }
+
+    // Entities of the received instructions, consuming them as the renderer does
+    std::vector<int> takeInstructions()
+    {
+        std::vector<int> entities;
+        auto& updates = synchronizer.getReceiverFrameData().graphicUpdates;
+        updates.forEach([&](const GraphicsDelta& delta) { entities.push_back(delta.entityID); });
+        updates.clear();
+        return entities;
+    }
 };
 
 TEST_F(ThreadSynchronizerTest, InitialFrameData)
@@ -25,125 +47,87 @@ TEST_F(ThreadSynchronizerTest, InitialFrameData)
     FrameData& receiverFrame = synchronizer.getReceiverFrameData();
     EXPECT_EQ(senderFrame.frameNumber, 0);
     EXPECT_EQ(receiverFrame.frameNumber, 0);
+    EXPECT_FALSE(synchronizer.receive());
 }
 
-TEST_F(ThreadSynchronizerTest, SenderReceiverSynchronization)
+TEST_F(ThreadSynchronizerTest, ReceiverTakesLatestFrame)
 {
-
-    std::thread receiver(
-        [&]()
-        {
-            std::this_thread::sleep_for(std::chrono::milliseconds(500));
-            for (int i = 1; i <= 5; ++i)
-            {
-                FrameData& frame = synchronizer.getReceiverFrameData();
-                EXPECT_EQ(frame.frameNumber, i - 1); // Always one frame behind than the sender
-                
-                if (i < 5)
-                    synchronizer.waitForSender();
-            }
-        });
-
-    std::thread sender(
-        [&]()
-        {
-            for (int i = 0; i < 5; ++i)
-            {
-                FrameData& frame = synchronizer.getSenderFrameData();
-                frame.frameNumber = i;
-                synchronizer.waitForReceiver();
-            }
-        });
-
-    sender.join();
-    receiver.join();
+    publish(1, {1});
+    ASSERT_TRUE(synchronizer.receive());
+    EXPECT_EQ(synchronizer.getReceiverFrameData().frameNumber, 1);
+    EXPECT_EQ(takeInstructions(), (std::vector<int>{1}));
+
+    // Keeps the current frame until the next one
+    EXPECT_FALSE(synchronizer.receive());
+    EXPECT_EQ(synchronizer.getReceiverFrameData().frameNumber, 1);
 }
 
-TEST_F(ThreadSynchronizerTest, ThreadsRunInParallel)
+TEST_F(ThreadSynchronizerTest, FramesNotTakenAreMerged)
 {
-    std::atomic<bool> senderStarted = false;
-    std::atomic<bool> receiverStarted = false;
+    publish(1, {1, 2});
+    publish(2, {});
+    publish(3, {3});
 
-    std::chrono::steady_clock::time_point senderStart, senderEnd;
-    std::chrono::steady_clock::time_point receiverStart, receiverEnd;
+    ASSERT_TRUE(synchronizer.receive());
+    EXPECT_EQ(synchronizer.getReceiverFrameData().frameNumber, 3);
+    EXPECT_EQ(takeInstructions(), (std::vector<int>{1, 2, 3}));
 
-    std::thread sender(
-        [&]()
-        {
-            senderStarted = true;
-            while (!receiverStarted)
-                std::this_thread::yield(); // Wait for receiver to start
-            senderStart = std::chrono::steady_clock::now();
-
-            // Simulate work
-            std::this_thread::sleep_for(std::chrono::milliseconds(50));
-            synchronizer.waitForReceiver();
-
-            senderEnd = std::chrono::steady_clock::now();
-        });
-
-    std::thread receiver(
-        [&]()
-        {
-            receiverStarted = true;
-            while (!senderStarted)
-                std::this_thread::yield(); // Wait for sender to start
-            receiverStart = std::chrono::steady_clock::now();
-
-            synchronizer.waitForSender();
-
-            // Simulate work
-            std::this_thread::sleep_for(std::chrono::milliseconds(50));
-            receiverEnd = std::chrono::steady_clock::now();
-        });
-
-    sender.join();
-    receiver.join();
-
-    auto senderDuration =
-        std::chrono::duration_cast<std::chrono::milliseconds>(senderEnd - senderStart);
-    auto receiverDuration =
-        std::chrono::duration_cast<std::chrono::milliseconds>(receiverEnd - receiverStart);
-    auto totalSpan = std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::max(senderEnd, receiverEnd) - std::min(senderStart, receiverStart));
-
-    // If they were purely serial, total span would be equal or greater than the sum of both
-    // durations If they were parallel, total span would be less than that
-    EXPECT_LT(totalSpan.count(), senderDuration.count() + receiverDuration.count());
+    publish(4, {4});
+    ASSERT_TRUE(synchronizer.receive());
+    EXPECT_EQ(takeInstructions(), (std::vector<int>{4}));
 }
 
-TEST_F(ThreadSynchronizerTest, GracefulShutdownUnblocksThreads)
+TEST_F(ThreadSynchronizerTest, RunsAtIndependentRates)
 {
-    std::atomic<bool> senderExited{false};
-    std::atomic<bool> receiverExited{false};
+    const int frameCount = 1000;
+    std::atomic<bool> sent{false};
+    std::vector<int> received;
+    int receivedFrames = 0;
 
-    std::thread sender(
+    std::thread receiver(
         [&]
         {
-            synchronizer.waitForReceiver();
-            senderExited = true;
+            while (true)
+            {
+                const bool wasSent = sent; // Checked before, to not miss the last frame
+                if (synchronizer.receive())
+                {
+                    auto indices = takeInstructions();
+                    received.insert(received.end(), indices.begin(), indices.end());
+                    ++receivedFrames;
+                }
+                else if (wasSent)
+                {
+                    break;
+                }
+                std::this_thread::sleep_for(std::chrono::microseconds(200)); // Slow renderer
+            }
         });
 
-    std::thread receiver(
+    std::thread sender(
         [&]
         {
-            synchronizer.waitForSender();
-            receiverExited = true;
+            // Never blocked by the receiver
+            for (int i = 0; i < frameCount; ++i)
+                publish(i + 1, {i});
+            sent = true;
         });
 
-    // Allow threads to block
-    std::this_thread::sleep_for(std::chrono::milliseconds(50));
-
-    // Initiate shutdown
-    synchronizer.shutdown();
-
-    // Wait for threads to exit
     sender.join();
     receiver.join();
 
-    EXPECT_TRUE(senderExited);
-    EXPECT_TRUE(receiverExited);
+    std::vector<int> expected(frameCount);
+    for (int i = 0; i < frameCount; ++i)
+        expected[i] = i;
+    EXPECT_EQ(received, expected); // Nothing lost, duplicated or reordered
+    EXPECT_EQ(synchronizer.getReceiverFrameData().frameNumber, frameCount);
+    EXPECT_LE(receivedFrames, frameCount);
 }
-} // namespace core
 
-#endif // TEST_THREADSYNCHRONIZER_H
\ No newline at end of file
+TEST_F(ThreadSynchronizerTest, FeedbackKeepsLatestValue)
+{
+    synchronizer.setFeedback(Vec2(10, 20));
+    synchronizer.setFeedback(Vec2(30, 40));
+    EXPECT_EQ(synchronizer.getFeedback(), Vec2(30, 40));
+}
+} // namespace core
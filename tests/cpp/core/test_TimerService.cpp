@@ -0,0 +1,103 @@
+#include "TimerService.h"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace core
+{
+class TimerServiceTest : public ::testing::Test
+{
+  protected:
+    TimerService timers;
+    std::vector<std::pair<uint32_t, int>> fired;
+    TimerService::ChannelId channel = 0;
+
+    void SetUp() override
+    {
+        channel = timers.registerChannel(
+            [this](std::span<const uint32_t> payloads, int tick)
+            {
+                for (auto payload : payloads)
+                    fired.emplace_back(payload, tick);
+            });
+    }
+};
+
+TEST_F(TimerServiceTest, FiresAtScheduledTicks)
+{
+    timers.schedule(channel, 1, 5);
+    timers.schedule(channel, 2, 3);
+    timers.scheduleAfter(channel, 3, 5);
+
+    timers.advance(4);
+    EXPECT_EQ(fired, (std::vector<std::pair<uint32_t, int>>{{2, 3}}));
+
+    timers.advance(5);
+    EXPECT_EQ(fired.size(), 3);
+    EXPECT_EQ(timers.getPendingCount(), 0);
+}
+
+TEST_F(TimerServiceTest, CancelledTimerDoesNotFire)
+{
+    auto id = timers.schedule(channel, 1, 5);
+    timers.schedule(channel, 2, 5);
+    EXPECT_TRUE(timers.isPending(id));
+
+    EXPECT_TRUE(timers.cancel(id));
+    EXPECT_FALSE(id.isValid());
+    EXPECT_FALSE(timers.cancel(id));
+
+    timers.advance(10);
+    EXPECT_EQ(fired, (std::vector<std::pair<uint32_t, int>>{{2, 5}}));
+}
+
+TEST_F(TimerServiceTest, StaleIdDoesNotCancelReusedSlot)
+{
+    auto first = timers.schedule(channel, 1, 2);
+    timers.advance(2);
+    EXPECT_FALSE(timers.isPending(first));
+
+    // Likely to reuse the slot of the first one
+    auto second = timers.schedule(channel, 2, 4);
+    EXPECT_FALSE(timers.cancel(first));
+    EXPECT_TRUE(timers.isPending(second));
+
+    timers.advance(4);
+    EXPECT_EQ(fired, (std::vector<std::pair<uint32_t, int>>{{1, 2}, {2, 4}}));
+}
+
+TEST_F(TimerServiceTest, BatchesPerChannelAndTick)
+{
+    std::vector<size_t> batchSizes;
+    auto other = timers.registerChannel([&](std::span<const uint32_t> payloads, int)
+                                        { batchSizes.push_back(payloads.size()); });
+
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        timers.schedule(other, i, 7);
+    }
+    timers.schedule(other, 3, 8);
+    timers.schedule(channel, 4, 7);
+
+    timers.advance(8);
+    EXPECT_EQ(batchSizes, (std::vector<size_t>{3, 1}));
+    EXPECT_EQ(fired.size(), 1);
+}
+
+TEST_F(TimerServiceTest, HandlerCanReschedule)
+{
+    std::vector<int> ticks;
+    TimerService::ChannelId periodic = 0;
+    periodic = timers.registerChannel(
+        [&](std::span<const uint32_t> payloads, int tick)
+        {
+            ticks.push_back(tick);
+            timers.scheduleAfter(periodic, payloads[0], 3);
+        });
+
+    timers.schedule(periodic, 0, 1);
+    timers.advance(10);
+    EXPECT_EQ(ticks, (std::vector<int>{1, 4, 7, 10}));
+    EXPECT_EQ(timers.getPendingCount(), 1);
+}
+} // namespace core
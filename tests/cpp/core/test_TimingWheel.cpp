@@ -0,0 +1,71 @@
+#include "TimingWheel.h"
+
+#include <gtest/gtest.h>
+#include <random>
+
+namespace core
+{
+TEST(TimingWheelTest, FiresAtScheduledTicks)
+{
+    TimingWheel<uint32_t> wheel;
+    wheel.schedule(1, 5);
+    wheel.schedule(2, 3);
+    wheel.schedule(3, 5);
+
+    std::vector<std::pair<uint32_t, int>> fired;
+    auto record = [&](uint32_t value, int tick) { fired.emplace_back(value, tick); };
+
+    wheel.advance(4, record);
+    EXPECT_EQ(fired, (std::vector<std::pair<uint32_t, int>>{{2, 3}}));
+
+    wheel.advance(5, record);
+    EXPECT_EQ(fired.size(), 3);
+    EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimingWheelTest, PastTicksAreDueNext)
+{
+    TimingWheel<uint32_t> wheel;
+    wheel.advance(10, [](uint32_t, int) {});
+    wheel.schedule(1, 2);
+
+    int firedAt = 0;
+    wheel.advance(11, [&](uint32_t, int tick) { firedAt = tick; });
+    EXPECT_EQ(firedAt, 11);
+}
+
+TEST(TimingWheelTest, CascadesAcrossLevels)
+{
+    TimingWheel<uint32_t> wheel;
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(1, 300000);
+
+    std::vector<int> ticks;
+    for (uint32_t i = 0; i < 2000; ++i)
+    {
+        ticks.push_back(dist(gen));
+        wheel.schedule(i, ticks.back());
+    }
+    // Beyond the range of the last level
+    ticks.push_back(20000000);
+    wheel.schedule(2000, ticks.back());
+
+    size_t count = 0;
+    int previousTick = 0;
+    // Advance in uneven steps
+    auto check = [&](uint32_t value, int firedTick)
+    {
+        EXPECT_EQ(firedTick, ticks[value]);
+        EXPECT_GE(firedTick, previousTick);
+        previousTick = firedTick;
+        ++count;
+    };
+    for (int tick = 0; tick < 20000000; tick += 7919)
+    {
+        wheel.advance(tick, check);
+    }
+    wheel.advance(20000000, check);
+    EXPECT_EQ(count, ticks.size());
+    EXPECT_TRUE(wheel.empty());
+}
+} // namespace core
@@ -13,11 +13,13 @@
 #include "utils/Constants.h"
 #include "TestEventPublisher.h"
 #include "FogOfWar.h"
-
-
-// The implementation-level free functions exist in VisionSystem.cpp but are not in the header.
-// We declare them here to test their behavior.
-extern uint32_t getCompositeId(uint32_t tracker, uint32_t target);
+#include "Path.h"
+#include "commands/CmdMove.h"
+#include "components/CompAction.h"
+#include "components/CompAnimation.h"
+#include "components/CompGraphics.h"
+#include "components/CompPlayer.h"
+#include "components/CompUnit.h"
 
 namespace core
 {
@@ -31,6 +33,27 @@ class ExposedVisionSystem : public VisionSystem
     }
 };
 
+// Feet per tick (i.e. per second below)
+constexpr uint32_t WALKING_SPEED = 16;
+
+// Walks straight to the destination, there are no other units to avoid
+class StraightMove : public CmdMove
+{
+  public:
+    explicit StraightMove(const Feet& destination)
+    {
+        target.emplace(destination, Target::Type::POSITION);
+        m_path = Path({destination});
+        collisionRadius = WALKING_SPEED; // Arrives within a step
+    }
+
+  protected:
+    Feet avoidCollision(int deltaTimeMs, const Feet& goalPos) override
+    {
+        return (goalPos - m_components->transform.position).normalized();
+    }
+};
+
 class VisionSystemTest : public ::testing::Test, public core::PropertyInitializer
 {
   protected:
@@ -53,6 +76,8 @@ class VisionSystemTest : public ::testing::Test, public core::PropertyInitialize
         // Install test event publisher to capture published events
         publisher = std::make_shared<core::test::TestEventPublisher>();
         publisher->install();
+
+        StateManager::clearDirtyEntities();
     }
 
     void TearDown() override
@@ -61,24 +86,53 @@ class VisionSystemTest : public ::testing::Test, public core::PropertyInitialize
         ServiceRegistry::getInstance().getService<StateManager>()->clearAll();
     }
 
+    // The components a unit needs to be moved by the move command
+    void makeWalker(uint32_t unit)
+    {
+        auto state = ServiceRegistry::getInstance().getService<StateManager>();
+        state->addComponent<CompAction>(unit, CompAction());
+        state->addComponent<CompAnimation>(unit, CompAnimation());
+        state->addComponent<CompGraphics>(unit, CompGraphics());
+        state->addComponent<CompPlayer>(unit, CompPlayer());
+        state->addComponent<CompUnit>(unit, CompUnit());
+        state->addComponent<CompVision>(unit, CompVision());
+        set<uint32_t>(state->getComponent<CompTransform>(unit).speed, WALKING_SPEED);
+    }
+
+    // Moves the unit the way the game does, ticking the vision after each step. Moving marks
+    // the unit dirty, and the dirty set is cleared at the end of a tick.
+    void walkTo(uint32_t unit, const Feet& destination)
+    {
+        StraightMove move(destination);
+        move.setEntityID(unit);
+        move.init();
+
+        std::list<Command*> subCommands;
+        bool arrived = false;
+        for (int tick = 1; tick <= 200 and not arrived; ++tick)
+        {
+            arrived = static_cast<Command&>(move).onExecute(1000, tick, subCommands);
+            vision->dispatchEvent(Event(Event::Type::TICK, TickData{tick}));
+            StateManager::clearDirtyEntities();
+        }
+        ASSERT_TRUE(arrived);
+    }
+
+    bool hasPublished(Event::Type type) const
+    {
+        for (const auto& e : publisher->events())
+        {
+            if (e.type == type)
+                return true;
+        }
+        return false;
+    }
+
     Ref<ExposedVisionSystem> vision;
     std::unique_ptr<EventLoop> eventLoop;
     std::shared_ptr<core::test::TestEventPublisher> publisher;
 };
 
-// Basic check for composite id arithmetic
-TEST_F(VisionSystemTest, CompositeIdUniqueness)
-{
-    uint32_t a = 5;
-    uint32_t b = 123;
-    uint32_t id = getCompositeId(a, b);
-    EXPECT_EQ(id, a * Constants::MAX_ENTITIES + b);
-
-    // Different pair should not collide
-    uint32_t id2 = getCompositeId(a + 1, b - 1);
-    EXPECT_NE(id, id2);
-}
-
 
 // Integration test: circle LOS flow -> publish WITHIN_LINE_OF_SIGHT then OUT_OF_LINE_OF_SIGHT
 TEST_F(VisionSystemTest, CircleLOS_PublishesWithinAndOutEvents)
@@ -141,11 +195,20 @@ TEST_F(VisionSystemTest, CircleLOS_PublishesWithinAndOutEvents)
     }
     EXPECT_TRUE(foundWithin);
 
-    // Now move target out of LOS and tick again -> expect OUT_OF_LINE_OF_SIGHT
-    state->getComponent<CompTransform>(target).position = Feet(100000, 100000); // far away
-
+    // Ticking again without any movement doesn't re-test the pair
     publisher->clear();
     vision->dispatchEvent(tick);
+    EXPECT_TRUE(publisher->events().empty());
+
+    // Walking to the next tile (3, 3) -> (4, 3) while within LOS
+    makeWalker(target);
+    walkTo(target, Feet(1100, 1000));
+    EXPECT_FALSE(hasPublished(Event::Type::OUT_OF_LINE_OF_SIGHT));
+
+    // Walking within the watched tile (4, 3) beyond LOS, i.e. re-tested by being dirty only
+    publisher->clear();
+    walkTo(target, Feet(1270, 780));
+    EXPECT_EQ(state->getComponent<CompTransform>(target).position.toTile(), Tile(4, 3));
 
     bool foundOut = false;
     for (const auto& e : publisher->events())
@@ -196,7 +259,7 @@ TEST_F(VisionSystemTest, RoundedSquareLOS_PublishesWithinAndOutEvents)
     vision->dispatchEvent(trEvent);
 
     // Add target into world map at that tile - triggers onEntityEnter
-    state->gameMap().addEntity(MapLayerType::STATIC, centerTile, target);
+    state->gameMap().addEntity(MapLayerType::UNITS, centerTile, target);
 
     publisher->clear();
 
@@ -217,11 +280,10 @@ TEST_F(VisionSystemTest, RoundedSquareLOS_PublishesWithinAndOutEvents)
     }
     EXPECT_TRUE(withinFound);
 
-    // Now push target away (set position far) and tick -> OUT_OF_LINE_OF_SIGHT expected
-    state->getComponent<CompTransform>(target).position = Feet(100000, 100000);
-
+    // Walk the target away -> OUT_OF_LINE_OF_SIGHT expected
+    makeWalker(target);
     publisher->clear();
-    vision->dispatchEvent(tick);
+    walkTo(target, Feet(2300, 1150));
 
     bool outFound = false;
     for (const auto& e : publisher->events())
@@ -236,4 +298,50 @@ TEST_F(VisionSystemTest, RoundedSquareLOS_PublishesWithinAndOutEvents)
     }
     EXPECT_TRUE(outFound);
 }
+
+// Leaving the watched tiles ends the tracking even without being dirty
+TEST_F(VisionSystemTest, LeavingWatchedTiles_PublishesOutEvent)
+{
+    auto state = ServiceRegistry::getInstance().getService<StateManager>();
+
+    uint32_t tracker = state->createEntity();
+    uint32_t target = state->createEntity();
+
+    CompVision trackerVision;
+    PropertyInitializer::set<uint32_t>(trackerVision.lineOfSight, 300u);
+    PropertyInitializer::set<bool>(trackerVision.activeTracking, true);
+    PropertyInitializer::set<LineOfSightShape>(trackerVision.lineOfSightShape,
+                                               LineOfSightShape::CIRCLE);
+    state->addComponent<CompVision>(tracker, trackerVision);
+
+    state->addComponent<CompEntityInfo>(target, CompEntityInfo(0));
+    CompTransform targetTransform;
+    targetTransform.position = Feet(1000, 1000);
+    state->addComponent<CompTransform>(target, targetTransform);
+
+    TrackingRequestData tr;
+    tr.entity = tracker;
+    tr.center = Feet(1000, 1000);
+    Event trEvent(Event::Type::TRACKING_REQUEST, tr);
+    vision->dispatchEvent(trEvent);
+
+    Tile targetTile = targetTransform.position.toTile();
+    state->gameMap().addEntity(MapLayerType::UNITS, targetTile, target);
+
+    Event tick(Event::Type::TICK, TickData{0});
+    vision->dispatchEvent(tick);
+
+    state->gameMap().removeEntity(MapLayerType::UNITS, targetTile, target);
+    publisher->clear();
+    vision->dispatchEvent(tick);
+
+    ASSERT_EQ(publisher->events().size(), 1);
+    EXPECT_EQ(publisher->events()[0].type, Event::Type::OUT_OF_LINE_OF_SIGHT);
+
+    // Nothing left to track
+    publisher->clear();
+    StateManager::markDirty(target);
+    vision->dispatchEvent(tick);
+    EXPECT_TRUE(publisher->events().empty());
+}
 } // namespace core
\ No newline at end of file
@@ -696,7 +696,7 @@ TEST_F(EntityModelLoaderTest, RangeUnit)
         // Assert
         auto& rangeAttack = m_stateMan->getComponent<CompRangeAttack>(archer);
 
-        auto& primaryProjectile = rangeAttack.primaryProjectile.value();
+        auto& primaryProjectile = *rangeAttack.primaryProjectile.value();
         auto& secondaryProjectiles = rangeAttack.secondaryProjectiles.value();
 
         EXPECT_EQ(rangeAttack.damageMode.value(), ProjectileDamageMode::ON_HIT);